@@ -0,0 +1,42 @@
+#include "Bench.h"
+#include "CrosshairAnimator.h"
+#include <memory>
+
+namespace Bench {
+    namespace {
+        constexpr float kFrameSeconds = 1.0f / 60.0f;
+    }
+
+    void RegisterAnimationBenches(Suite& suite) {
+        // One frame with every slot busy: the worst case the overlay pays per Present
+        auto full = std::make_shared<CrosshairAnimator>();
+        suite.Add("animation/advance_full", [full](uint64_t ops) {
+            using Channel = CrosshairAnimator::Channel;
+            for (uint64_t i = 0; i < ops; i++) {
+                if (!full->IsAnimating()) {
+                    for (uint32_t layer = 0; layer < CrosshairAnimator::kMaxLayers; layer++) {
+                        full->Pulse(static_cast<Channel>(layer % CrosshairAnimator::kChannelCount), 0.1f, 1.0f);
+                    }
+                }
+                full->Advance(kFrameSeconds);
+                DoNotOptimize(full->GetPose());
+            }
+        });
+
+        // A type change every few frames while sweeping over clutter
+        auto sweep = std::make_shared<CrosshairAnimator>();
+        auto& sweepCase = suite.Add("animation/sweep", [sweep](uint64_t ops) {
+            using Channel = CrosshairAnimator::Channel;
+            for (uint64_t i = 0; i < ops; i++) {
+                if (i % 4 == 0) {
+                    sweep->Crossfade(0.15f);
+                    sweep->TintTo(1.0f, (i & 8) ? 0.5f : 1.0f, (i & 8) ? 0.5f : 1.0f, 0.15f);
+                    sweep->Pulse(Channel::kScale, 0.15f, 0.2f);
+                }
+                sweep->Advance(kFrameSeconds);
+                DoNotOptimize(sweep->GetPose());
+            }
+        });
+        sweepCase.params = { { "frames_per_change", 4.0 } };
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal microbenchmark harness for DynamicCrosshairFramework_bench. Each case is a body that
+// performs `ops` operations; the runner calibrates the op count to a target sample time, takes
+// several samples and reports the median as JSON so results can be diffed between releases.
+namespace Bench {
+    // Keeps a value (and the work that produced it) from being optimized away
+    template <class T>
+    inline void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        static volatile const void* sink;
+        sink = &value;
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    struct Case {
+        std::string name;
+        std::vector<std::pair<std::string, double>> params;
+        std::function<void(uint64_t ops)> body;
+        double bytesPerOp = 0;  // Reported as bytes_per_sec when set
+    };
+
+    class Suite {
+        public:
+            Case& Add(std::string name, std::function<void(uint64_t ops)> body) {
+                cases.push_back({ std::move(name), {}, std::move(body) });
+                return cases.back();
+            }
+            const std::vector<Case>& GetCases() const { return cases; }
+
+        private:
+            std::vector<Case> cases;
+    };
+
+    void RegisterClassifierBenches(Suite& suite);
+    void RegisterDispatchBenches(Suite& suite);
+    void RegisterInputBenches(Suite& suite);
+    void RegisterImageBenches(Suite& suite);
+    void RegisterJobBenches(Suite& suite);
+    void RegisterSchedulerBenches(Suite& suite);
+    void RegisterScriptEventBenches(Suite& suite);
+    void RegisterAnimationBenches(Suite& suite);
+    void RegisterInfoCardBenches(Suite& suite);
+    void RegisterFormTableCacheBenches(Suite& suite);
+    void RegisterMarkerBenches(Suite& suite);
+    void RegisterRasterBenches(Suite& suite);
+}
@@ -0,0 +1,99 @@
+#include "Bench.h"
+#include "SyntheticWorld.h"
+#include <array>
+#include <memory>
+
+namespace Bench {
+    namespace {
+        // Power of two so the body can wrap with a mask; large enough to defeat branch history
+        constexpr std::size_t kTargets = 4096;
+
+        struct ClassifierFixture {
+            SyntheticWorld world;
+            std::vector<SyntheticWorld::Target> targets;
+
+            void CollectTargets() {
+                targets.clear();
+                for (std::size_t i = 0; i < world.GetObjectCount(); i++) {
+                    targets.push_back(world.GetObject(i));
+                }
+            }
+        };
+
+        void AddClassifyCase(Suite& suite, std::string name, std::shared_ptr<ClassifierFixture> fixture) {
+            auto& benchCase = suite.Add(std::move(name), [fixture](uint64_t ops) {
+                const auto& world = fixture->world;
+                const auto& targets = fixture->targets;
+                for (uint64_t i = 0; i < ops; i++) {
+                    DoNotOptimize(ClassifyInteraction(world, targets[i & (kTargets - 1)]));
+                }
+            });
+            benchCase.params = { { "targets", static_cast<double>(kTargets) } };
+        }
+
+        struct SingleTypeCase {
+            const char* name;
+            BaseType type;
+        };
+
+        constexpr std::array<SingleTypeCase, 7> kSingleTypes = { {
+            { "Activator", BaseType::kActivator },
+            { "Book", BaseType::kBook },
+            { "Container", BaseType::kContainer },
+            { "Flora", BaseType::kFlora },
+            { "Furniture", BaseType::kFurniture },
+            { "NPC", BaseType::kNPC },
+            { "Tree", BaseType::kTree },
+        } };
+    }
+
+    void RegisterClassifierBenches(Suite& suite) {
+        // Everything the crosshair passes over in a populated interior, with lockpicks in hand
+        auto mixed = std::make_shared<ClassifierFixture>();
+        mixed->world.Populate(kTargets, 1);
+        mixed->world.SetPlayerItemCount(kLockpickFormID, 5);
+        mixed->CollectTargets();
+        AddClassifyCase(suite, "classify/mix", mixed);
+
+        // Classification alone, from facts gathered up front
+        auto facts = std::make_shared<std::vector<TargetFacts>>();
+        for (const auto target : mixed->targets) {
+            facts->push_back(GatherFacts(mixed->world, target));
+        }
+        auto& factsCase = suite.Add("classify/mix_facts_only", [facts](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                DoNotOptimize(ClassifyInteraction((*facts)[i & (kTargets - 1)]));
+            }
+        });
+        factsCase.params = { { "targets", static_cast<double>(kTargets) } };
+
+        for (const auto& single : kSingleTypes) {
+            auto fixture = std::make_shared<ClassifierFixture>();
+            for (std::size_t i = 0; i < kTargets; i++) {
+                auto& object = fixture->world.Add(single.type);
+                object.dead = single.type == BaseType::kNPC && (i & 1);  // Corpses among the living
+            }
+            fixture->world.SetPlayerSneaking(single.type == BaseType::kNPC);
+            fixture->CollectTargets();
+            AddClassifyCase(suite, std::string("classify/") + single.name, fixture);
+        }
+
+        // Doors read the most facts: lock state, lock level and, for pickable locks, the inventory
+        auto doors = std::make_shared<ClassifierFixture>();
+        for (std::size_t i = 0; i < kTargets; i++) {
+            auto& object = doors->world.Add(BaseType::kDoor);
+            if (i % 3 != 0) {
+                object.lock.locked = true;
+                object.lock.level = static_cast<LockLevel>(i % 6);
+            }
+        }
+        doors->world.SetPlayerItemCount(kLockpickFormID, 1);
+        doors->CollectTargets();
+        AddClassifyCase(suite, "classify/Door_locked_mix", doors);
+
+        // No target under the crosshair
+        auto empty = std::make_shared<ClassifierFixture>();
+        empty->targets.assign(kTargets, nullptr);
+        AddClassifyCase(suite, "classify/no_target", empty);
+    }
+}
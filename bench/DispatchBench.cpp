@@ -0,0 +1,55 @@
+#include "Bench.h"
+#include "ChangeDispatcher.h"
+#include "SyntheticWorld.h"
+#include <array>
+#include <memory>
+
+namespace Bench {
+    namespace {
+        constexpr std::array<int, 7> kSubscriberCounts = { 1, 2, 5, 10, 20, 50, 100 };
+
+        struct DispatchFixture {
+            ChangeDispatcher<const TargetFacts> dispatcher;
+            uint64_t observed = 0;
+            TargetFacts facts;
+
+            explicit DispatchFixture(int subscribers) {
+                facts.hasRef = true;
+                facts.formID = 0xFF000800;
+                for (int i = 0; i < subscribers; i++) {
+                    dispatcher.Subscribe([this](const TargetFacts* target) { observed += target->formID; });
+                }
+            }
+        };
+    }
+
+    void RegisterDispatchBenches(Suite& suite) {
+        for (const int subscribers : kSubscriberCounts) {
+            auto fixture = std::make_shared<DispatchFixture>(subscribers);
+            auto& benchCase = suite.Add("dispatch/fanout/" + std::to_string(subscribers), [fixture](uint64_t ops) {
+                for (uint64_t i = 0; i < ops; i++) {
+                    fixture->dispatcher.Dispatch(&fixture->facts);
+                }
+                DoNotOptimize(fixture->observed);
+            });
+            benchCase.params = { { "subscribers", static_cast<double>(subscribers) } };
+        }
+
+        // The per-event path with the change check: classify, Update, and Dispatch on a change.
+        // Consecutive events repeat a target a quarter of the time, as when the crosshair settles.
+        auto world = std::make_shared<SyntheticWorld>();
+        world->Populate(1024, 2);
+        auto fixture = std::make_shared<DispatchFixture>(4);
+        auto& benchCase = suite.Add("dispatch/update_classify_dispatch", [world, fixture](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                const auto target = world->GetObject((i - ((i & 3) == 3)) & 1023);
+                const TargetFacts facts = GatherFacts(*world, target);
+                if (fixture->dispatcher.Update(facts.formID, ClassifyInteraction(facts))) {
+                    fixture->dispatcher.Dispatch(&facts);
+                }
+            }
+            DoNotOptimize(fixture->observed);
+        });
+        benchCase.params = { { "subscribers", 4 }, { "objects", 1024 } };
+    }
+}
@@ -0,0 +1,67 @@
+#include "Bench.h"
+#include "FormTableCache.h"
+#include <cstdio>
+#include <memory>
+
+namespace Bench {
+    namespace {
+        // Carryable base forms of a large load order
+        constexpr uint32_t kStaticForms = 150000;
+        constexpr uint64_t kKey = 0x0123456789ABCDEFull;
+
+        struct FormTableCacheFixture {
+            Memory::Vector<InfoCards::StaticInfo, Memory::Tag::kUI> unsorted;
+            std::filesystem::path path = std::filesystem::temp_directory_path() / "dcf_bench_formtable.cache";
+
+            FormTableCacheFixture() {
+                for (uint32_t i = 0; i < kStaticForms; i++) {
+                    unsorted.push_back({ (i % 1500) << 24 | (i * 2654435761u >> 8 & 0xFFFFFF), static_cast<int32_t>(i % 500), 0.5f * (i % 40) });
+                }
+                InfoCards::StaticTable table;
+                table.Build(Memory::Vector<InfoCards::StaticInfo, Memory::Tag::kUI>(unsorted));
+                FormTableCache::Save(path, kKey, table.GetEntries());
+            }
+            ~FormTableCacheFixture() {
+                std::error_code error;
+                std::filesystem::remove(path, error);
+            }
+        };
+    }
+
+    void RegisterFormTableCacheBenches(Suite& suite) {
+        auto fixture = std::make_shared<FormTableCacheFixture>();
+
+        // Warm start: map, validate the header, adopt
+        auto& load = suite.Add("formcache/load", [fixture](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                InfoCards::StaticTable table;
+                DoNotOptimize(FormTableCache::Load(fixture->path, kKey, table));
+                DoNotOptimize(table.Find(0x05000D62));
+            }
+        });
+        load.params = { { "static_forms", static_cast<double>(kStaticForms) } };
+
+        // Cold start without the game's form walk: copying and sorting the gathered entries
+        auto& rebuild = suite.Add("formcache/rebuild", [fixture](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                InfoCards::StaticTable table;
+                table.Build(Memory::Vector<InfoCards::StaticInfo, Memory::Tag::kUI>(fixture->unsorted));
+                DoNotOptimize(table.Find(0x05000D62));
+            }
+        });
+        rebuild.params = { { "static_forms", static_cast<double>(kStaticForms) } };
+
+        // The key over a 1,500 plugin load order, names only
+        suite.Add("formcache/key", [](uint64_t ops) {
+            char name[32];
+            for (uint64_t i = 0; i < ops; i++) {
+                FormTableCache::KeyBuilder key(1);
+                for (uint32_t plugin = 0; plugin < 1500; plugin++) {
+                    const int length = std::snprintf(name, sizeof(name), "SomeMod_%04u.esp", plugin);
+                    key.AddPlugin({ name, static_cast<std::size_t>(length) }, 1024u * plugin, plugin);
+                }
+                DoNotOptimize(key.GetKey());
+            }
+        });
+    }
+}
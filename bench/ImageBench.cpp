@@ -0,0 +1,112 @@
+#include "Bench.h"
+#include "ImageUtil.h"
+#include <cmath>
+#include <memory>
+
+namespace Bench {
+    namespace {
+        // A crosshair-like image: a soft ring on a transparent background, straight BGRA
+        std::vector<uint8_t> MakeCrosshair(uint32_t size) {
+            std::vector<uint8_t> bgra(static_cast<std::size_t>(size) * size * 4);
+            const float center = (static_cast<float>(size) - 1.0f) * 0.5f;
+            const float radius = static_cast<float>(size) * 0.35f;
+            const float thickness = static_cast<float>(size) * 0.06f;
+            for (uint32_t y = 0; y < size; y++) {
+                for (uint32_t x = 0; x < size; x++) {
+                    const float distance = std::hypot(static_cast<float>(x) - center, static_cast<float>(y) - center);
+                    const float coverage = std::fmax(0.0f, 1.0f - std::fabs(distance - radius) / thickness);
+                    uint8_t* pixel = &bgra[(static_cast<std::size_t>(y) * size + x) * 4];
+                    pixel[0] = 0xF0;
+                    pixel[1] = 0xF0;
+                    pixel[2] = 0xF0;
+                    pixel[3] = static_cast<uint8_t>(coverage * 255.0f);
+                }
+            }
+            return bgra;
+        }
+
+        // Bottom-up, as most tools write them
+        std::vector<uint8_t> EncodeTga(const std::vector<uint8_t>& bgra, uint32_t size, uint8_t depth, bool rle) {
+            const std::size_t bytesPerPixel = depth / 8;
+            std::vector<uint8_t> file(18, 0);
+            file[2] = static_cast<uint8_t>((depth == 8 ? 3 : 2) + (rle ? 8 : 0));
+            file[12] = static_cast<uint8_t>(size & 0xFF);
+            file[13] = static_cast<uint8_t>(size >> 8);
+            file[14] = static_cast<uint8_t>(size & 0xFF);
+            file[15] = static_cast<uint8_t>(size >> 8);
+            file[16] = depth;
+            file[17] = depth == 32 ? 8 : 0;
+
+            auto pixelAt = [&](uint32_t x, uint32_t y) {
+                const uint8_t* pixel = &bgra[(static_cast<std::size_t>(size - 1 - y) * size + x) * 4];
+                // Grayscale files carry the coverage, so they are not all one value
+                return depth == 8 ? std::vector<uint8_t>{ pixel[3] } : std::vector<uint8_t>(pixel, pixel + bytesPerPixel);
+            };
+
+            for (uint32_t y = 0; y < size; y++) {
+                uint32_t x = 0;
+                while (x < size) {
+                    if (!rle) {
+                        const auto pixel = pixelAt(x++, y);
+                        file.insert(file.end(), pixel.begin(), pixel.end());
+                        continue;
+                    }
+                    // Run packets for repeats, single-pixel raw packets otherwise; enough for a benchmark
+                    const auto pixel = pixelAt(x, y);
+                    uint32_t run = 1;
+                    while (x + run < size && run < 128 && pixelAt(x + run, y) == pixel) run++;
+                    file.push_back(static_cast<uint8_t>(run > 1 ? 0x80 | (run - 1) : 0));
+                    file.insert(file.end(), pixel.begin(), pixel.end());
+                    x += run;
+                }
+            }
+            return file;
+        }
+
+        struct TgaCase {
+            const char* name;
+            uint8_t depth;
+            bool rle;
+        };
+    }
+
+    void RegisterImageBenches(Suite& suite) {
+        constexpr TgaCase kFormats[] = {
+            { "tga32", 32, false },
+            { "tga32_rle", 32, true },
+            { "tga24", 24, false },
+            { "tga8_rle", 8, true },
+        };
+
+        for (const uint32_t size : { 64u, 256u }) {
+            const auto bgra = MakeCrosshair(size);
+            const double outputBytes = static_cast<double>(bgra.size());
+
+            for (const auto& format : kFormats) {
+                auto file = std::make_shared<std::vector<uint8_t>>(EncodeTga(bgra, size, format.depth, format.rle));
+                auto image = std::make_shared<ImageUtil::Image>();
+                auto& benchCase = suite.Add("image/decode_" + std::string(format.name) + "/" + std::to_string(size),
+                    [file, image](uint64_t ops) {
+                        for (uint64_t i = 0; i < ops; i++) {
+                            DoNotOptimize(ImageUtil::DecodeTga(file->data(), file->size(), *image));
+                        }
+                    });
+                benchCase.params = { { "width", static_cast<double>(size) }, { "height", static_cast<double>(size) }, { "file_bytes", static_cast<double>(file->size()) } };
+                benchCase.bytesPerOp = outputBytes;
+            }
+
+            // The straight -> premultiplied conversion on its own, redone on a fresh copy each time
+            auto source = std::make_shared<std::vector<uint8_t>>(bgra);
+            auto scratch = std::make_shared<std::vector<uint8_t>>(bgra.size());
+            auto& benchCase = suite.Add("image/premultiply/" + std::to_string(size), [source, scratch](uint64_t ops) {
+                for (uint64_t i = 0; i < ops; i++) {
+                    std::copy(source->begin(), source->end(), scratch->begin());
+                    ImageUtil::PremultiplyAlpha(scratch->data(), scratch->size() / 4);
+                    DoNotOptimize(scratch->data());
+                }
+            });
+            benchCase.params = { { "width", static_cast<double>(size) }, { "height", static_cast<double>(size) } };
+            benchCase.bytesPerOp = outputBytes;
+        }
+    }
+}
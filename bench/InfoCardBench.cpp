@@ -0,0 +1,61 @@
+#include "Bench.h"
+#include "InfoCards.h"
+#include <memory>
+
+namespace Bench {
+    namespace {
+        // Roughly the carryable base forms of a modest load order
+        constexpr uint32_t kStaticForms = 40000;
+        constexpr uint32_t kTargets = 24;   // Refs swept over, fewer than the cache holds
+
+        struct InfoCardFixture {
+            InfoCards::StaticTable table;
+            InfoCards::DynamicCache cache;
+            InfoCards::Layout layout;
+
+            InfoCardFixture() {
+                Memory::Vector<InfoCards::StaticInfo, Memory::Tag::kUI> entries;
+                for (uint32_t i = 0; i < kStaticForms; i++) {
+                    // Spread across plugins so the table is not one dense run
+                    entries.push_back({ (i % 200) << 24 | (i * 2654435761u >> 8 & 0xFFFFFF), static_cast<int32_t>(i % 500), 0.5f * (i % 40), static_cast<uint8_t>(i % 7 == 0) });
+                }
+                table.Build(std::move(entries));
+            }
+
+            InfoCards::DynamicInfo Gather(uint32_t refID) const {
+                InfoCards::DynamicInfo info;
+                info.refID = refID;
+                info.locked = refID % 3 == 0;
+                info.lockLevel = LockLevel::kAverage;
+                return info;
+            }
+        };
+    }
+
+    void RegisterInfoCardBenches(Suite& suite) {
+        auto fixture = std::make_shared<InfoCardFixture>();
+
+        // A target change to a ref seen recently: static lookup, cache hit, layout rebuild
+        auto& change = suite.Add("infocards/target_change", [fixture](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                const uint32_t refID = 0xFF000800u + static_cast<uint32_t>(i % kTargets);
+                const auto* staticInfo = fixture->table.Find((static_cast<uint32_t>(i) % 200) << 24 | 0x000D62);
+                const auto* dynamicInfo = fixture->cache.Find(refID);
+                if (!dynamicInfo) {
+                    dynamicInfo = &fixture->cache.Insert(fixture->Gather(refID));
+                }
+                InfoCards::FormatLayout("Steel Sword", staticInfo, *dynamicInfo, fixture->layout);
+                DoNotOptimize(fixture->layout);
+            }
+        });
+        change.params = { { "static_forms", static_cast<double>(kStaticForms) }, { "targets", static_cast<double>(kTargets) } };
+
+        // The lookups alone, without formatting
+        suite.Add("infocards/lookup", [fixture](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                DoNotOptimize(fixture->table.Find(static_cast<uint32_t>(i * 2654435761u)));
+                DoNotOptimize(fixture->cache.Find(0xFF000800u + static_cast<uint32_t>(i % kTargets)));
+            }
+        });
+    }
+}
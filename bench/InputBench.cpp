@@ -0,0 +1,134 @@
+#include "Bench.h"
+#include "KeyTables.h"
+#include "SPSCQueue.h"
+#include <array>
+#include <memory>
+#include <thread>
+
+namespace Bench {
+    namespace {
+        // Same shape and size as Menu::KeyEvent, without the RE types
+        struct KeyEvent {
+            uint32_t keyCode = 0;
+            uint8_t virtualKey = 0;
+            uint32_t device = 0;
+            uint32_t eventType = 0;
+            float value = 0;
+            float heldDownSecs = 0;
+        };
+
+        // The menu's queue: input thread -> Present thread
+        using KeyEventQueue = SPSCQueue<KeyEvent, 256>;
+
+        // Scan codes weighted towards the letter rows, with some modifiers and arrows
+        std::array<uint8_t, 256> MakeTypingStream() {
+            std::array<uint8_t, 256> stream{};
+            uint32_t state = 12345;
+            for (auto& scanCode : stream) {
+                state = state * 1103515245u + 12345u;
+                const uint32_t pick = (state >> 16) % 100;
+                if (pick < 80) {
+                    scanCode = static_cast<uint8_t>(0x10 + (state >> 8) % 0x26);   // Letter rows
+                } else if (pick < 90) {
+                    scanCode = pick & 1 ? 0x2A : 0x1D;                              // Shift / Ctrl
+                } else {
+                    scanCode = static_cast<uint8_t>(0xC8 + (state >> 8) % 8);      // Arrows/navigation
+                }
+            }
+            return stream;
+        }
+
+        // Stand-in for MapVirtualKeyEx on a layout that swaps Y and Z, like German QWERTZ
+        uint32_t MapQwertz(uint32_t scanCode) {
+            if (scanCode == 0x15) return 'Z';
+            if (scanCode == 0x2C) return 'Y';
+            return KeyTables::kScanCodeToVK[scanCode];
+        }
+    }
+
+    void RegisterInputBenches(Suite& suite) {
+        // Uncontended push and pop of one event: the per-event cost on each side
+        auto queue = std::make_shared<KeyEventQueue>();
+        suite.Add("input/queue_push_pop", [queue](uint64_t ops) {
+            KeyEvent event;
+            for (uint64_t i = 0; i < ops; i++) {
+                event.keyCode = static_cast<uint32_t>(i);
+                queue->TryPush(event);
+                queue->TryPop(event);
+            }
+            DoNotOptimize(event);
+        });
+
+        // A frame's worth of events pushed, then drained in one go as ProcessInputEventQueue does
+        for (const int burst : { 8, 64 }) {
+            auto& benchCase = suite.Add("input/queue_burst_drain/" + std::to_string(burst), [queue, burst](uint64_t ops) {
+                uint64_t keys = 0;
+                KeyEvent event;
+                for (uint64_t done = 0; done < ops; done += burst) {
+                    for (int i = 0; i < burst; i++) {
+                        event.keyCode = static_cast<uint32_t>(i);
+                        queue->TryPush(event);
+                    }
+                    queue->Drain([&](const KeyEvent& queued) { keys += queued.keyCode; });
+                }
+                DoNotOptimize(keys);
+            });
+            benchCase.params = { { "burst", static_cast<double>(burst) } };
+        }
+
+        // Producer and consumer on separate threads; a full queue makes the producer retry
+        suite.Add("input/queue_cross_thread", [](uint64_t ops) {
+            auto crossQueue = std::make_unique<KeyEventQueue>();
+            std::thread producer([&crossQueue, ops] {
+                KeyEvent event;
+                for (uint64_t i = 0; i < ops; i++) {
+                    event.keyCode = static_cast<uint32_t>(i);
+                    while (!crossQueue->TryPush(event)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+            uint64_t received = 0;
+            uint64_t keys = 0;
+            while (received < ops) {
+                const std::size_t drained = crossQueue->Drain([&](const KeyEvent& queued) { keys += queued.keyCode; });
+                if (drained == 0) {
+                    std::this_thread::yield();
+                }
+                received += drained;
+            }
+            producer.join();
+            DoNotOptimize(keys);
+        });
+
+        // Scan code -> virtual key for every keyboard event on the input thread
+        auto stream = std::make_shared<std::array<uint8_t, 256>>(MakeTypingStream());
+        auto translator = std::make_shared<KeyTranslator>();
+        suite.Add("keys/scan_to_vk", [stream, translator](uint64_t ops) {
+            uint32_t keys = 0;
+            for (uint64_t i = 0; i < ops; i++) {
+                keys += translator->ToVirtualKey((*stream)[i & 0xFF]);
+            }
+            DoNotOptimize(keys);
+        });
+
+        // Once per input batch; only rebuilds when the layout actually changes
+        auto layouts = std::make_shared<std::array<uintptr_t, 2>>(std::array<uintptr_t, 2>{ 1, 1 });
+        suite.Add("keys/refresh_layout_unchanged", [translator, layouts](uint64_t ops) {
+            translator->RefreshLayout(1, MapQwertz);
+            bool rebuilt = false;
+            for (uint64_t i = 0; i < ops; i++) {
+                DoNotOptimize(*layouts);
+                rebuilt |= translator->RefreshLayout((*layouts)[i & 1], MapQwertz);
+            }
+            DoNotOptimize(rebuilt);
+        });
+        suite.Add("keys/refresh_layout_switch", [translator](uint64_t ops) {
+            bool rebuilt = false;
+            for (uint64_t i = 0; i < ops; i++) {
+                rebuilt |= translator->RefreshLayout(2 + (i & 1), MapQwertz);
+            }
+            DoNotOptimize(rebuilt);
+        });
+    }
+}
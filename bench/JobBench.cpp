@@ -0,0 +1,80 @@
+#include "Bench.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace Bench {
+    namespace {
+        // Comparable to the plugin's pool: a few workers, whatever the host
+        uint32_t BenchWorkerCount() {
+            return std::clamp(std::thread::hardware_concurrency(), 2u, 4u);
+        }
+
+        void EnsureJobSystem() {
+            if (!Jobs::IsRunning()) {
+                Jobs::Init(BenchWorkerCount());
+            }
+        }
+    }
+
+    void RegisterJobBenches(Suite& suite) {
+        // Round trip for one empty job from outside the pool: schedule, wake a worker, wait
+        auto& roundTrip = suite.Add("jobs/schedule_wait", [](uint64_t ops) {
+            EnsureJobSystem();
+            for (uint64_t i = 0; i < ops; i++) {
+                Jobs::Wait(Jobs::Schedule([] {}));
+            }
+        });
+        roundTrip.params = { { "workers", static_cast<double>(BenchWorkerCount()) } };
+
+        // Fan out N small jobs and join on one dependent job; per-job cost
+        for (const int width : { 16, 256 }) {
+            auto& benchCase = suite.Add("jobs/fan_out_in/" + std::to_string(width), [width](uint64_t ops) {
+                EnsureJobSystem();
+                std::vector<Jobs::JobHandle> handles(width);
+                std::vector<uint64_t> sums(width);
+                for (uint64_t done = 0; done < ops; done += width) {
+                    for (int i = 0; i < width; i++) {
+                        handles[i] = Jobs::Schedule([&sums, i] {
+                            uint64_t sum = 0;
+                            for (uint64_t k = 0; k < 256; k++) sum += k * k;
+                            sums[i] = sum;
+                        });
+                    }
+                    Jobs::Wait(Jobs::Schedule([] {}, handles));
+                }
+                DoNotOptimize(sums.data());
+            });
+            benchCase.params = { { "width", static_cast<double>(width) }, { "workers", static_cast<double>(BenchWorkerCount()) } };
+        }
+
+        // A serial chain, each job depending on the previous: dependency-release latency
+        suite.Add("jobs/chain", [](uint64_t ops) {
+            EnsureJobSystem();
+            Jobs::JobHandle previous;
+            for (uint64_t i = 0; i < ops; i++) {
+                previous = Jobs::Then(previous, [] {});
+                if ((i & 1023) == 1023) {
+                    Jobs::Wait(previous);  // Stay well inside the job slot budget
+                }
+            }
+            Jobs::Wait(previous);
+        });
+
+        // Cancelled before they run: the cost of skipping
+        suite.Add("jobs/cancelled", [](uint64_t ops) {
+            EnsureJobSystem();
+            Jobs::CancellationSource source;
+            source.Cancel();
+            Jobs::JobHandle last;
+            for (uint64_t i = 0; i < ops; i++) {
+                last = Jobs::Schedule([] {}, source.GetToken());
+                if ((i & 1023) == 1023) {
+                    Jobs::Wait(last);
+                }
+            }
+            Jobs::Wait(last);
+        });
+    }
+}
@@ -0,0 +1,74 @@
+#include "Bench.h"
+#include "MarkerProjection.h"
+#include <cmath>
+#include <memory>
+
+namespace Bench {
+    namespace {
+        constexpr uint32_t kSceneMarkers = 512;
+        constexpr float kSceneRadius = 4096.0f;     // Markers are scattered this far around the camera
+        constexpr float kMarkerRadius = 3072.0f;    // Default-ish overlay radius
+
+        // Camera at the origin looking along +Y with Z up, as the game's world axes run
+        Markers::Camera MakeCamera(float width, float height, float verticalFov, float nearZ, float farZ) {
+            const float focal = 1.0f / std::tan(verticalFov * 0.5f);
+            const float aspect = width / height;
+            Markers::Camera camera;
+            camera.worldToClip = {
+                focal / aspect, 0.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, focal, 0.0f,
+                0.0f, farZ / (farZ - nearZ), 0.0f, -nearZ * farZ / (farZ - nearZ),
+                0.0f, 1.0f, 0.0f, 0.0f
+            };
+            camera.screenWidth = width;
+            camera.screenHeight = height;
+            return camera;
+        }
+
+        struct MarkerFixture {
+            Markers::MarkerSet markers;
+            Markers::ScreenMarkers screen;
+            Markers::Camera camera = MakeCamera(2560.0f, 1440.0f, 1.2f, 15.0f, 100000.0f);
+
+            MarkerFixture() {
+                // Deterministic scatter around the camera; roughly a third ends up on screen
+                uint32_t state = 0x9E3779B9u;
+                const auto next = [&state] {
+                    state ^= state << 13;
+                    state ^= state >> 17;
+                    state ^= state << 5;
+                    return static_cast<float>(state) / 4294967296.0f * 2.0f - 1.0f;
+                };
+                for (uint32_t i = 0; i < kSceneMarkers; i++) {
+                    markers.Add(0xFF000800u + i, static_cast<Markers::Kind>(i % Markers::kKindCount),
+                        next() * kSceneRadius, next() * kSceneRadius, next() * kSceneRadius * 0.25f);
+                }
+            }
+        };
+    }
+
+    void RegisterMarkerBenches(Suite& suite) {
+        auto fixture = std::make_shared<MarkerFixture>();
+        const double visible = Markers::Project(fixture->markers, fixture->camera, kMarkerRadius, fixture->screen);
+        const std::vector<std::pair<std::string, double>> params = { { "markers", static_cast<double>(kSceneMarkers) }, { "visible", visible } };
+
+        // One frame of culling and projection for the whole scene
+        auto& simd = suite.Add("markers/project", [fixture](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                fixture->camera.positionZ = static_cast<float>(i & 1);   // Keeps the loop from being hoisted
+                DoNotOptimize(Markers::Project(fixture->markers, fixture->camera, kMarkerRadius, fixture->screen));
+                DoNotOptimize(fixture->screen);
+            }
+        });
+        simd.params = params;
+
+        auto& scalar = suite.Add("markers/project_scalar", [fixture](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                fixture->camera.positionZ = static_cast<float>(i & 1);
+                DoNotOptimize(Markers::ProjectScalar(fixture->markers, fixture->camera, kMarkerRadius, fixture->screen));
+                DoNotOptimize(fixture->screen);
+            }
+        });
+        scalar.params = params;
+    }
+}
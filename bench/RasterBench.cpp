@@ -0,0 +1,73 @@
+#include "Bench.h"
+#include "SoftwareRaster.h"
+#include <array>
+#include <cmath>
+#include <memory>
+
+namespace Bench {
+    namespace {
+        constexpr uint32_t kScreenWidth = 2560;
+        constexpr uint32_t kScreenHeight = 1440;
+        constexpr uint32_t kTextureSize = 64;
+        constexpr std::array<uint16_t, 6> kQuadIndices = { 0, 1, 2, 0, 2, 3 };
+
+        // A soft ring, premultiplied, as the crosshair textures mostly are
+        Raster::Texture MakeRing() {
+            Raster::Texture texture;
+            texture.width = kTextureSize;
+            texture.height = kTextureSize;
+            texture.pixels.resize(static_cast<std::size_t>(kTextureSize) * kTextureSize);
+            const float center = kTextureSize * 0.5f;
+            for (uint32_t y = 0; y < kTextureSize; y++) {
+                for (uint32_t x = 0; x < kTextureSize; x++) {
+                    const float distance = std::hypot(static_cast<float>(x) + 0.5f - center, static_cast<float>(y) + 0.5f - center);
+                    const float coverage = std::fmax(0.0f, 1.0f - std::fabs(distance - 22.0f) / 4.0f);
+                    texture.pixels[y * kTextureSize + x] = Raster::Premultiply(240, 240, 240, static_cast<uint32_t>(coverage * 255.0f));
+                }
+            }
+            return texture;
+        }
+
+        std::array<Raster::Vertex, 4> Quad(float x0, float y0, float x1, float y1, uint32_t color) {
+            return { {
+                { x0, y0, 0.0f, 0.0f, color }, { x1, y0, 1.0f, 0.0f, color },
+                { x1, y1, 1.0f, 1.0f, color }, { x0, y1, 0.0f, 1.0f, color } } };
+        }
+
+        struct RasterFixture {
+            Raster::Framebuffer framebuffer{ kScreenWidth, kScreenHeight };
+            Raster::Texture ring = MakeRing();
+        };
+    }
+
+    void RegisterRasterBenches(Suite& suite) {
+        auto fixture = std::make_shared<RasterFixture>();
+
+        // What a crosshair frame costs: two 64 px textured quads mid-transition, at the screen centre
+        auto& crosshair = suite.Add("raster/crosshair_frame", [fixture](uint64_t ops) {
+            const float cx = kScreenWidth * 0.5f;
+            const float cy = kScreenHeight * 0.5f;
+            const auto outgoing = Quad(cx - 32.0f, cy - 32.0f, cx + 32.0f, cy + 32.0f, 0x60FFFFFFu);
+            const auto incoming = Quad(cx - 36.0f, cy - 36.0f, cx + 36.0f, cy + 36.0f, 0xE050C8FFu);
+            const Raster::ClipRect clip = fixture->framebuffer.GetBounds();
+            for (uint64_t i = 0; i < ops; i++) {
+                fixture->framebuffer.FillTriangles(outgoing.data(), kQuadIndices.data(), kQuadIndices.size(), fixture->ring, clip);
+                fixture->framebuffer.FillTriangles(incoming.data(), kQuadIndices.data(), kQuadIndices.size(), fixture->ring, clip);
+            }
+            DoNotOptimize(fixture->framebuffer.GetPixels()[0]);
+        });
+        crosshair.params = { { "pixels", 64.0 * 64.0 + 72.0 * 72.0 } };
+
+        // The span fill at full throughput: a translucent textured quad over the whole screen
+        auto& fill = suite.Add("raster/fill_fullscreen", [fixture](uint64_t ops) {
+            const auto quad = Quad(0.0f, 0.0f, static_cast<float>(kScreenWidth), static_cast<float>(kScreenHeight), 0x80FFFFFFu);
+            const Raster::ClipRect clip = fixture->framebuffer.GetBounds();
+            for (uint64_t i = 0; i < ops; i++) {
+                fixture->framebuffer.FillTriangles(quad.data(), kQuadIndices.data(), kQuadIndices.size(), fixture->ring, clip);
+            }
+            DoNotOptimize(fixture->framebuffer.GetPixels()[0]);
+        });
+        fill.params = { { "pixels", static_cast<double>(kScreenWidth) * kScreenHeight } };
+        fill.bytesPerOp = static_cast<double>(kScreenWidth) * kScreenHeight * 4.0;
+    }
+}
@@ -0,0 +1,36 @@
+#include "Bench.h"
+#include "FrameScheduler.h"
+#include <memory>
+
+namespace Bench {
+    namespace {
+        constexpr uint32_t kTasksPerFrame = 64;
+    }
+
+    void RegisterSchedulerBenches(Suite& suite) {
+        // Post and run one small task: the per-task overhead a frame pays on top of the work itself
+        auto scheduler = std::make_shared<FrameScheduler>("Bench");
+        scheduler->SetBudgetUs(1'000'000);
+        auto& postRun = suite.Add("scheduler/post_run", [scheduler](uint64_t ops) {
+            uint64_t sum = 0;
+            for (uint64_t done = 0; done < ops; done += kTasksPerFrame) {
+                for (uint32_t i = 0; i < kTasksPerFrame; i++) {
+                    const auto priority = static_cast<FrameScheduler::Priority>(i % FrameScheduler::kPriorityCount);
+                    scheduler->Post(priority, [&sum, i] { sum += i; });
+                }
+                scheduler->RunFrame();
+            }
+            DoNotOptimize(sum);
+        });
+        postRun.params = { { "tasks_per_frame", static_cast<double>(kTasksPerFrame) } };
+
+        // An idle frame: what every Present pays when nothing is queued
+        auto idle = std::make_shared<FrameScheduler>("Idle");
+        suite.Add("scheduler/idle_frame", [idle](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                idle->RecordFrameTime(16.6f);
+                DoNotOptimize(idle->RunFrame());
+            }
+        });
+    }
+}
@@ -0,0 +1,89 @@
+#include "Bench.h"
+#include "ScriptEvents.h"
+#include <memory>
+#include <vector>
+
+namespace Bench {
+    namespace {
+        constexpr uint32_t kRegistrations = 8;
+        constexpr uint32_t kChangesPerFrame = 4;
+
+        // Stands in for Papyrus: queuing an event copies its arguments once per handle, as the
+        // game's VM does. The queue is drained every frame like the VM's own.
+        class StandInVM final : public ScriptVM {
+            public:
+                struct QueuedEvent {
+                    Handle handle;
+                    uint32_t formID;
+                    int32_t type;
+                    int32_t previousType;
+                };
+
+                StandInVM() { queue.reserve(kRegistrations); }
+
+                void SendInteractionChanged(const Handle* handles, std::size_t count, const InteractionEvent& event) override {
+                    for (std::size_t i = 0; i < count; i++) {
+                        queue.push_back({ handles[i], event.formID, static_cast<int32_t>(event.type), static_cast<int32_t>(event.previousType) });
+                    }
+                }
+
+                std::size_t Drain() {
+                    const std::size_t count = queue.size();
+                    queue.clear();
+                    return count;
+                }
+
+            private:
+                std::vector<QueuedEvent> queue;
+        };
+
+        InteractionType TypeFor(uint64_t i) {
+            return static_cast<InteractionType>(1 + i % (kInteractionTypeCount - 1));
+        }
+    }
+
+    void RegisterScriptEventBenches(Suite& suite) {
+        // A change with no script registered: what every crosshair change pays by default
+        auto idle = std::make_shared<InteractionEventBatcher>();
+        suite.Add("script_events/change_unregistered", [idle](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                DoNotOptimize(idle->OnChange(static_cast<uint32_t>(i), TypeFor(i)));
+            }
+        });
+
+        // Several changes in a frame, coalesced and sent once to every registration. One op is
+        // one raw change, so this compares directly with sending each change on its own.
+        auto batched = std::make_shared<InteractionEventBatcher>();
+        auto vm = std::make_shared<StandInVM>();
+        for (uint32_t i = 0; i < kRegistrations; i++) {
+            batched->Register(0x1000 + i);
+        }
+        auto& frame = suite.Add("script_events/batched_frame", [batched, vm](uint64_t ops) {
+            for (uint64_t done = 0; done < ops; done += kChangesPerFrame) {
+                for (uint32_t i = 0; i < kChangesPerFrame; i++) {
+                    batched->OnChange(static_cast<uint32_t>(done + i), TypeFor(done + i));
+                }
+                batched->Flush(*vm);
+                DoNotOptimize(vm->Drain());
+            }
+        });
+        frame.params = {
+            { "registrations", static_cast<double>(kRegistrations) },
+            { "changes_per_frame", static_cast<double>(kChangesPerFrame) }
+        };
+
+        // Baseline: every change sent as its own event, i.e. no coalescing
+        auto unbatched = std::make_shared<InteractionEventBatcher>();
+        for (uint32_t i = 0; i < kRegistrations; i++) {
+            unbatched->Register(0x1000 + i);
+        }
+        auto& perChange = suite.Add("script_events/unbatched_change", [unbatched, vm](uint64_t ops) {
+            for (uint64_t i = 0; i < ops; i++) {
+                unbatched->OnChange(static_cast<uint32_t>(i), TypeFor(i));
+                unbatched->Flush(*vm);
+                DoNotOptimize(vm->Drain());
+            }
+        });
+        perChange.params = { { "registrations", static_cast<double>(kRegistrations) } };
+    }
+}
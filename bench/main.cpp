@@ -0,0 +1,191 @@
+// DynamicCrosshairFramework_bench: microbenchmarks for the platform-neutral hot paths, run
+// against synthetic inputs. Results go to stdout (or --out) as JSON; a summary goes to stderr.
+//
+// Usage: DynamicCrosshairFramework_bench [--filter SUBSTRING] [--out FILE] [--samples N] [--min-time-ms N] [--list]
+#include "Bench.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+#ifndef DCF_BUILD_TYPE
+#define DCF_BUILD_TYPE "unknown"
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        const char* filter = nullptr;
+        const char* outPath = nullptr;
+        int samples = 7;
+        double minSampleSeconds = 0.05;
+        bool list = false;
+    };
+
+    struct Result {
+        const Bench::Case* benchCase;
+        uint64_t ops;
+        double medianNs;
+        double minNs;
+        double maxNs;
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+                options.filter = argv[++i];
+            } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+                options.outPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+                options.samples = std::atoi(argv[++i]);
+            } else if (std::strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+                options.minSampleSeconds = std::atof(argv[++i]) / 1000.0;
+            } else if (std::strcmp(argv[i], "--list") == 0) {
+                options.list = true;
+            } else {
+                return false;
+            }
+        }
+        return options.samples > 0 && options.minSampleSeconds > 0;
+    }
+
+    double TimeOps(const Bench::Case& benchCase, uint64_t ops) {
+        const auto start = Clock::now();
+        benchCase.body(ops);
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    Result Run(const Bench::Case& benchCase, const Options& options) {
+        // Grow the op count until one sample takes long enough to time reliably
+        uint64_t ops = 1;
+        double seconds = TimeOps(benchCase, ops);
+        while (seconds < options.minSampleSeconds && ops < (uint64_t{ 1 } << 40)) {
+            const double scale = seconds > 0 ? std::clamp(options.minSampleSeconds * 1.2 / seconds, 2.0, 100.0) : 100.0;
+            ops = static_cast<uint64_t>(static_cast<double>(ops) * scale);
+            seconds = TimeOps(benchCase, ops);
+        }
+
+        std::vector<double> nsPerOp(options.samples);
+        for (auto& sample : nsPerOp) {
+            sample = TimeOps(benchCase, ops) * 1e9 / static_cast<double>(ops);
+        }
+        std::sort(nsPerOp.begin(), nsPerOp.end());
+        return { &benchCase, ops, nsPerOp[nsPerOp.size() / 2], nsPerOp.front(), nsPerOp.back() };
+    }
+
+    void WriteJsonString(std::FILE* out, const std::string& text) {
+        std::fputc('"', out);
+        for (const char c : text) {
+            if (c == '"' || c == '\\') std::fputc('\\', out);
+            std::fputc(c, out);
+        }
+        std::fputc('"', out);
+    }
+
+    const char* CompilerName() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+#define DCF_STRINGIFY2(x) #x
+#define DCF_STRINGIFY(x) DCF_STRINGIFY2(x)
+        return "msvc " DCF_STRINGIFY(_MSC_FULL_VER);
+#else
+        return "unknown";
+#endif
+    }
+
+    void WriteJson(std::FILE* out, const Options& options, const std::vector<Result>& results) {
+        char timestamp[32] = {};
+        const std::time_t now = std::time(nullptr);
+        std::tm utc{};
+#if defined(_WIN32)
+        gmtime_s(&utc, &now);
+#else
+        gmtime_r(&now, &utc);
+#endif
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+
+        std::fprintf(out, "{\n  \"context\": {\n");
+        std::fprintf(out, "    \"plugin\": \"%s\",\n    \"version\": \"%s\",\n", PLUGIN_NAME, PLUGIN_VERSION);
+        std::fprintf(out, "    \"timestamp\": \"%s\",\n", timestamp);
+        std::fprintf(out, "    \"compiler\": ");
+        WriteJsonString(out, CompilerName());
+        std::fprintf(out, ",\n    \"build_type\": \"%s\",\n", DCF_BUILD_TYPE);
+        std::fprintf(out, "    \"hardware_threads\": %u,\n", std::thread::hardware_concurrency());
+        std::fprintf(out, "    \"samples\": %d,\n    \"min_sample_ms\": %.1f\n  },\n", options.samples, options.minSampleSeconds * 1000.0);
+
+        std::fprintf(out, "  \"benchmarks\": [");
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const Result& result = results[i];
+            const Bench::Case& benchCase = *result.benchCase;
+            std::fprintf(out, "%s\n    {\n      \"name\": ", i ? "," : "");
+            WriteJsonString(out, benchCase.name);
+            std::fprintf(out, ",\n      \"params\": {");
+            for (std::size_t p = 0; p < benchCase.params.size(); p++) {
+                std::fprintf(out, "%s", p ? ", " : " ");
+                WriteJsonString(out, benchCase.params[p].first);
+                std::fprintf(out, ": %.17g", benchCase.params[p].second);
+            }
+            std::fprintf(out, "%s},\n", benchCase.params.empty() ? "" : " ");
+            std::fprintf(out, "      \"ops_per_sample\": %llu,\n", static_cast<unsigned long long>(result.ops));
+            std::fprintf(out, "      \"ns_per_op\": %.3f,\n", result.medianNs);
+            std::fprintf(out, "      \"ns_per_op_min\": %.3f,\n", result.minNs);
+            std::fprintf(out, "      \"ns_per_op_max\": %.3f,\n", result.maxNs);
+            std::fprintf(out, "      \"ops_per_sec\": %.1f", 1e9 / result.medianNs);
+            if (benchCase.bytesPerOp > 0) {
+                std::fprintf(out, ",\n      \"bytes_per_sec\": %.1f", benchCase.bytesPerOp * 1e9 / result.medianNs);
+            }
+            std::fprintf(out, "\n    }");
+        }
+        std::fprintf(out, "\n  ]\n}\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--filter SUBSTRING] [--out FILE] [--samples N] [--min-time-ms N] [--list]\n", argv[0]);
+        return 2;
+    }
+
+    Bench::Suite suite;
+    Bench::RegisterClassifierBenches(suite);
+    Bench::RegisterDispatchBenches(suite);
+    Bench::RegisterInputBenches(suite);
+    Bench::RegisterImageBenches(suite);
+    Bench::RegisterJobBenches(suite);
+    Bench::RegisterSchedulerBenches(suite);
+    Bench::RegisterScriptEventBenches(suite);
+    Bench::RegisterAnimationBenches(suite);
+    Bench::RegisterInfoCardBenches(suite);
+    Bench::RegisterFormTableCacheBenches(suite);
+    Bench::RegisterMarkerBenches(suite);
+    Bench::RegisterRasterBenches(suite);
+
+    std::vector<Result> results;
+    for (const auto& benchCase : suite.GetCases()) {
+        if (options.filter && benchCase.name.find(options.filter) == std::string::npos) continue;
+        if (options.list) {
+            std::printf("%s\n", benchCase.name.c_str());
+            continue;
+        }
+        results.push_back(Run(benchCase, options));
+        std::fprintf(stderr, "%-44s %12.2f ns/op\n", benchCase.name.c_str(), results.back().medianNs);
+    }
+    if (options.list) return 0;
+
+    std::FILE* out = options.outPath ? std::fopen(options.outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", options.outPath);
+        return 1;
+    }
+    WriteJson(out, options, results);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+// Plugin-owned allocation layer, so the plugin stays off the process heap that the game and
+// other plugins contend on:
+//  - size-class pools for long-lived objects (and everything ImGui allocates),
+//  - a per-frame linear arena for transient data, reset once per Present,
+//  - per-subsystem byte and allocation counters, with the GPU resources each subsystem owns.
+// Has no Windows or game dependencies.
+namespace Memory {
+    enum class Tag : uint8_t {
+        kMonitor,
+        kUI,
+        kMenu,          // ImGui allocations made while the menu layer draws
+        kImGui,
+        kTextures,
+        kLogging,
+        kJobs,
+        kSettings,
+        kOther,
+        kCount
+    };
+
+    const char* TagName(Tag tag);
+
+    struct TagStats {
+        std::atomic<int64_t> bytes{ 0 };          // Currently allocated, as requested by callers
+        std::atomic<int64_t> peakBytes{ 0 };      // Highest bytes since start or ResetPeaks
+        std::atomic<uint64_t> allocations{ 0 };   // Lifetime count
+        std::atomic<uint64_t> frees{ 0 };
+    };
+
+    // Textures and buffers live in video memory the allocator never sees; render backends report
+    // them as they create, resize and release them
+    struct GpuStats {
+        std::atomic<int64_t> bytes{ 0 };
+        std::atomic<int64_t> peakBytes{ 0 };
+        std::atomic<int64_t> resources{ 0 };      // Currently alive
+    };
+
+    // Pools serve requests up to kMaxPooledSize; larger ones go to the heap (and are counted)
+    inline constexpr std::size_t kMaxPooledSize = 4096;
+    // What every block is aligned to. Stricter (power of two) alignments are served from a block
+    // alignment bytes larger, and are counted at that size.
+    inline constexpr std::size_t kPoolAlignment = 16;
+
+    void* Allocate(std::size_t size, Tag tag, std::size_t alignment = kPoolAlignment);
+    void Free(void* ptr);
+
+    template <class T, class... Args>
+    T* New(Tag tag, Args&&... args) {
+        return new (Allocate(sizeof(T), tag, alignof(T))) T(static_cast<Args&&>(args)...);
+    }
+
+    template <class T>
+    void Delete(T* ptr) {
+        if (!ptr) return;
+        ptr->~T();
+        Free(ptr);
+    }
+
+    // Routes a standard container's storage through the pools under a subsystem tag
+    template <class T, Tag tag>
+    struct StlAllocator {
+        using value_type = T;
+
+        template <class U>
+        struct rebind {
+            using other = StlAllocator<U, tag>;
+        };
+
+        StlAllocator() = default;
+        template <class U>
+        StlAllocator(const StlAllocator<U, tag>&) {}
+
+        T* allocate(std::size_t n) {
+            void* ptr = Allocate(n * sizeof(T), tag, alignof(T));
+            if (!ptr) throw std::bad_alloc();
+            return static_cast<T*>(ptr);
+        }
+        void deallocate(T* ptr, std::size_t) { Free(ptr); }
+
+        friend bool operator==(const StlAllocator&, const StlAllocator&) { return true; }
+    };
+
+    template <class T, Tag tag>
+    using Vector = std::vector<T, StlAllocator<T, tag>>;
+
+    const TagStats& GetStats(Tag tag);
+
+    // Any thread. A resize is a free of the old size followed by an allocation of the new one.
+    void TrackGpuAllocation(Tag tag, int64_t bytes);
+    void TrackGpuFree(Tag tag, int64_t bytes);
+    const GpuStats& GetGpuStats(Tag tag);
+
+    // Heap memory the pools hold, in use or not; chunks are never returned
+    int64_t GetPoolReservedBytes();
+
+    // Restarts every CPU and GPU peak from the current value
+    void ResetPeaks();
+
+    // Calls that reached the process heap: pool chunk refills plus oversized allocations and frees
+    uint64_t GetHeapCallCount();
+
+    // Linear allocator for data that only lives until the end of the current frame.
+    // Overflowing requests fall back to the pools and are released at the next Reset.
+    class FrameArena {
+        public:
+            explicit FrameArena(std::size_t capacity);
+            ~FrameArena();
+
+            FrameArena(const FrameArena&) = delete;
+            FrameArena& operator=(const FrameArena&) = delete;
+
+            void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+            void Reset();
+
+            std::size_t GetUsed() const { return used; }
+            std::size_t GetCapacity() const { return capacity; }
+            std::size_t GetHighWater() const { return highWater; }
+            uint64_t GetOverflowCount() const { return overflowCount; }
+
+        private:
+            struct Overflow {
+                Overflow* next;
+            };
+
+            std::byte* buffer = nullptr;
+            std::size_t capacity = 0;
+            std::size_t used = 0;
+            std::size_t highWater = 0;
+            uint64_t overflowCount = 0;
+            Overflow* overflowList = nullptr;
+    };
+
+    // Arena for the render thread, reset at the start of every Present
+    FrameArena& GetFrameArena();
+
+    // Allocations made by the calling thread: pool and heap requests through Allocate, plus every
+    // global operator new when built with DCF_COUNT_ALLOCATIONS (which replaces operator new/delete)
+    uint64_t GetThreadAllocationCount();
+
+    using AllocationViolationHandler = void (*)(const char* scope, uint64_t allocations);
+    void SetAllocationViolationHandler(AllocationViolationHandler handler);
+
+    // Marks a path that must not allocate once warmed up. With DCF_COUNT_ALLOCATIONS, any allocation
+    // made inside the scope is reported to the violation handler (abort by default); otherwise a no-op.
+    class NoAllocationScope {
+        public:
+#if defined(DCF_COUNT_ALLOCATIONS)
+            explicit NoAllocationScope(const char* name) : name(name), start(GetThreadAllocationCount()) {}
+            ~NoAllocationScope();
+
+        private:
+            const char* name;
+            uint64_t start;
+#else
+            explicit NoAllocationScope(const char*) {}
+#endif
+            NoAllocationScope(const NoAllocationScope&) = delete;
+            NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+    };
+}
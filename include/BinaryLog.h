@@ -0,0 +1,179 @@
+#pragma once
+#include "BinaryLogFormat.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+// Binary logger for the event and render paths. A call site costs a level check, a timestamp
+// and a copy of its raw arguments into the calling thread's lock-free ring; formatting happens
+// offline in tools/blogdecode. A background thread drains the rings to the .blog file.
+//
+//   BLOG_DEBUG("Loaded {} ({}x{})", path, width, height);
+//
+// The format string must be a literal: it is registered once per call site and referenced by
+// id. Each call site is limited to kMaxRecordsPerSecond; the excess is counted and written as a
+// single "suppressed" chunk. Slow-path and one-off messages should keep using SKSE::log.
+namespace BinaryLog {
+    using Level = BinaryLogFormat::Level;
+
+    inline constexpr uint16_t kInvalidFormat = 0xFFFF;
+    inline constexpr std::size_t kMaxPayload = 116;
+    inline constexpr uint32_t kMaxRecordsPerSecond = 32;
+
+    // Opens the output file and starts the drain thread. Nothing is recorded before this.
+    bool Init(const std::filesystem::path& path, Level minLevel = Level::kDebug);
+    // Stops the drain thread after a final drain. Safe to call when not initialized.
+    void Shutdown();
+
+    void SetMinLevel(Level level);
+    uint64_t GetDroppedRecords();       // Lost to full rings
+    uint64_t GetSuppressedRecords();    // Lost to rate limiting
+
+    // One ring slot. Fixed size so a push is a single copy into the ring.
+    struct Record {
+        uint64_t ticks;
+        uint16_t formatId;
+        uint16_t size;
+        uint8_t payload[kMaxPayload];
+    };
+    static_assert(sizeof(Record) == 128);
+
+    namespace detail {
+        inline std::atomic<Level> minLevel{ Level::kOff };
+
+        template <class T>
+        constexpr char ArgTypeOf() {
+            using U = std::remove_cv_t<T>;
+            if constexpr (std::is_same_v<U, bool>) return 'u';
+            else if constexpr (std::is_enum_v<U>) return std::is_signed_v<std::underlying_type_t<U>> ? 'i' : 'u';
+            else if constexpr (std::is_integral_v<U>) return std::is_signed_v<U> ? 'i' : 'u';
+            else if constexpr (std::is_floating_point_v<U>) return 'd';
+            else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*> ||
+                               std::is_same_v<U, std::string_view> || std::is_same_v<U, std::string>) return 's';
+            else if constexpr (std::is_pointer_v<U>) return 'p';
+            else static_assert(sizeof(U) == 0, "Unsupported BinaryLog argument type");
+        }
+
+        template <class... Args>
+        inline constexpr std::array<char, sizeof...(Args) + 1> kSignature = { ArgTypeOf<Args>()..., '\0' };
+
+        template <class... Args>
+        constexpr std::size_t FixedPayloadSize() {
+            return ((ArgTypeOf<Args>() == 's' ? 1 : 8) + ... + 0);
+        }
+
+        uint16_t Register(Level level, const char* file, uint32_t line, const char* format, const char* signature);
+        bool Admit(uint16_t formatId, uint64_t ticks);
+        void Push(const Record& record);
+
+        class PayloadWriter {
+            public:
+                // pending: the fixed bytes of every argument still to be written (FixedPayloadSize)
+                PayloadWriter(Record& record, std::size_t pending) : record(record), pending(pending) {}
+
+                template <class T>
+                void Put(const T& value) {
+                    using U = std::remove_cv_t<T>;
+                    if constexpr (std::is_enum_v<U>) {
+                        PutRaw(static_cast<std::conditional_t<std::is_signed_v<std::underlying_type_t<U>>, int64_t, uint64_t>>(value));
+                    } else if constexpr (std::is_same_v<U, bool> || (std::is_integral_v<U> && !std::is_signed_v<U>)) {
+                        PutRaw(static_cast<uint64_t>(value));
+                    } else if constexpr (std::is_integral_v<U>) {
+                        PutRaw(static_cast<int64_t>(value));
+                    } else if constexpr (std::is_floating_point_v<U>) {
+                        PutRaw(static_cast<double>(value));
+                    } else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+                        PutString(value ? std::string_view(value) : std::string_view());
+                    } else if constexpr (std::is_same_v<U, std::string_view> || std::is_same_v<U, std::string>) {
+                        PutString(value);
+                    } else {
+                        PutRaw(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+                    }
+                }
+
+            private:
+                template <class T>
+                void PutRaw(T value) {
+                    std::memcpy(record.payload + record.size, &value, sizeof(T));
+                    record.size += static_cast<uint16_t>(sizeof(T));
+                    pending -= sizeof(T);
+                }
+
+                // Strings are truncated to whatever space is left once the fixed bytes owed to this
+                // and the later arguments are set aside
+                void PutString(std::string_view value) {
+                    const std::size_t used = record.size + pending;
+                    const std::size_t room = used < kMaxPayload ? kMaxPayload - used : 0;
+                    const std::size_t length = (std::min)({ value.size(), room, std::size_t{ 255 } });
+                    record.payload[record.size++] = static_cast<uint8_t>(length);
+                    pending -= 1;
+                    std::memcpy(record.payload + record.size, value.data(), length);
+                    record.size += static_cast<uint16_t>(length);
+                }
+
+                Record& record;
+                std::size_t pending;
+        };
+    }
+
+    // Raw timestamp: the TSC on x86, otherwise steady_clock nanoseconds
+    inline uint64_t Now() {
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    inline bool IsEnabled(Level level) {
+        return level >= detail::minLevel.load(std::memory_order_relaxed);
+    }
+
+    template <class... Args>
+    uint16_t RegisterFormat(Level level, const char* file, uint32_t line, const char* format, const Args&...) {
+        static_assert(detail::FixedPayloadSize<std::decay_t<Args>...>() <= kMaxPayload, "Too many BinaryLog arguments");
+        return detail::Register(level, file, line, format, detail::kSignature<std::decay_t<Args>...>.data());
+    }
+
+    template <class... Args>
+    void Write(uint16_t formatId, const char*, const Args&... args) {
+        if (formatId == kInvalidFormat) return;
+
+        Record record;
+        record.ticks = Now();
+        if (!detail::Admit(formatId, record.ticks)) return;
+
+        record.formatId = formatId;
+        record.size = 0;
+        detail::PayloadWriter writer(record, detail::FixedPayloadSize<std::decay_t<Args>...>());
+        (writer.template Put<std::decay_t<const Args&>>(args), ...);
+        detail::Push(record);
+    }
+}
+
+#define BLOG(level, ...)                                                                                          \
+    do {                                                                                                          \
+        if (BinaryLog::IsEnabled(level)) {                                                                        \
+            static const uint16_t blogFormatId = BinaryLog::RegisterFormat(level, __FILE__, __LINE__, __VA_ARGS__); \
+            BinaryLog::Write(blogFormatId, __VA_ARGS__);                                                          \
+        }                                                                                                         \
+    } while (0)
+
+#define BLOG_TRACE(...) BLOG(BinaryLog::Level::kTrace, __VA_ARGS__)
+#define BLOG_DEBUG(...) BLOG(BinaryLog::Level::kDebug, __VA_ARGS__)
+#define BLOG_INFO(...) BLOG(BinaryLog::Level::kInfo, __VA_ARGS__)
+#define BLOG_WARN(...) BLOG(BinaryLog::Level::kWarn, __VA_ARGS__)
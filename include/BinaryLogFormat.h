@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+// On-disk layout of the binary hot-path log, shared by the plugin and tools/blogdecode.
+// Everything is little-endian and written field by field (no struct padding on disk).
+//
+//  FileHeader
+//  then any number of chunks, each starting with a ChunkKind byte:
+//   kFormat:     u16 id, u8 level, u32 line, u16 len + format, u8 len + signature, u16 len + file
+//   kRecord:     u64 ticks, u16 thread, u16 id, u16 len + payload
+//   kSuppressed: u64 ticks, u16 id, u32 count
+//
+// A format chunk always precedes the first record that uses its id. Payloads hold the raw
+// arguments in signature order: 'i' int64, 'u' uint64, 'd' double, 'p' pointer (u64),
+// 's' u8 length + bytes.
+namespace BinaryLogFormat {
+    inline constexpr char kMagic[8] = { 'D', 'C', 'F', 'B', 'L', 'O', 'G', '\0' };
+    inline constexpr uint32_t kVersion = 1;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t ticksPerSecond;
+        uint64_t startTicks;    // Tick value at startUnixNs
+        int64_t startUnixNs;
+    };
+    static_assert(sizeof(FileHeader) == 40);
+
+    enum class ChunkKind : uint8_t {
+        kFormat = 1,
+        kRecord = 2,
+        kSuppressed = 3
+    };
+
+    // Same order as spdlog's levels
+    enum class Level : uint8_t {
+        kTrace,
+        kDebug,
+        kInfo,
+        kWarn,
+        kError,
+        kCritical,
+        kOff
+    };
+
+    inline const char* LevelName(Level level) {
+        switch (level) {
+            case Level::kTrace:    return "trace";
+            case Level::kDebug:    return "debug";
+            case Level::kInfo:     return "info";
+            case Level::kWarn:     return "warning";
+            case Level::kError:    return "error";
+            case Level::kCritical: return "critical";
+            default:               return "off";
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Allocator.h"
+#include "InplaceFunction.h"
+#include "InteractionClassifier.h"
+#include <cstdint>
+
+// Crosshair change detection and subscriber fan-out. Platform-neutral so the replay tool
+// drives the same code path as CrosshairMonitor; Ref is the game reference type in the plugin.
+template <class Ref>
+class ChangeDispatcher {
+    public:
+        // Stored inline, so dispatch never allocates; captures must fit in 32 bytes
+        using Callback = InplaceFunction<void(Ref* newRef), 32>;
+
+        // Subscribers are registered once at load; anything past this is a leak, not a feature
+        static constexpr std::size_t kMaxSubscribers = 128;
+
+        // False once kMaxSubscribers are registered
+        bool Subscribe(Callback callback) {
+            if (callbacks.size() >= kMaxSubscribers) return false;
+            callbacks.push_back(std::move(callback));
+            return true;
+        }
+        std::size_t GetSubscriberCount() const { return callbacks.size(); }
+
+        // True if the target or its interaction type differs from the last update
+        bool Update(uint32_t targetId, InteractionType type) {
+            if (targetId == lastTargetId && type == lastType) return false;
+            lastTargetId = targetId;
+            lastType = type;
+            return true;
+        }
+
+        void Dispatch(Ref* newRef) const {
+            for (const auto& callback : callbacks) {
+                callback(newRef);
+            }
+        }
+
+        void Reset() {
+            lastTargetId = 0;
+            lastType = InteractionType::kNone;
+        }
+
+        InteractionType GetLastType() const { return lastType; }
+
+    private:
+        uint32_t lastTargetId = 0;
+        InteractionType lastType = InteractionType::kNone;
+        Memory::Vector<Callback, Memory::Tag::kMonitor> callbacks;
+};
@@ -0,0 +1,110 @@
+#pragma once
+/*
+ * DynamicCrosshairFramework inter-plugin API. Plain C ABI; copy this header into a consumer.
+ *
+ * Request the API once, at or after SKSE's kPostLoad:
+ *
+ *     DCF_APIRequest request = { DCF_API_VERSION, NULL };
+ *     messaging->Dispatch(DCF_MESSAGE_REQUEST_API, &request, sizeof(request), "DynamicCrosshairFramework");
+ *     if (request.api && request.api->version >= DCF_API_VERSION) { ... }
+ *
+ * The provider answers synchronously. Everything it hands out lives until the game exits.
+ *
+ * The state block is written only on the game thread whenever the crosshair target or its
+ * interaction type changes. Read it with DCF_ReadCrosshairState (C++), or by following the
+ * seqlock protocol documented on DCF_CrosshairState. Polling it costs a few loads and no calls.
+ */
+#include <stdint.h>
+
+#define DCF_API_VERSION 1u
+#define DCF_MESSAGE_REQUEST_API 0x44434601u /* 'DCF' 1 */
+
+#if defined(__cplusplus)
+#	define DCF_ALIGN64 alignas(64)
+#elif defined(_MSC_VER)
+#	define DCF_ALIGN64 __declspec(align(64))
+#else
+#	define DCF_ALIGN64 __attribute__((aligned(64)))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* DCF_CrosshairState.stateFlags */
+enum {
+    DCF_STATE_HAS_TARGET = 1u << 0,
+    DCF_STATE_LOCKED = 1u << 1,
+    DCF_STATE_DEAD = 1u << 2,
+    DCF_STATE_PLAYER_SNEAKING = 1u << 3
+};
+
+/*
+ * One cache line. Seqlock: the writer makes sequence odd, updates the fields, then makes it
+ * even again. A reader loads sequence (acquire), retries while it is odd, copies the fields,
+ * issues an acquire fence and loads sequence again; equal values mean the copy is consistent.
+ */
+typedef struct DCF_ALIGN64 DCF_CrosshairState {
+    uint32_t sequence;
+    uint32_t formID;            /* 0 when nothing is targeted */
+    uint32_t interactionType;   /* InteractionType value; GetInteractionTypeName names it */
+    uint32_t activationFlags;   /* 0x01 talk, 0x02 container/door, 0x04 read/take, 0x08 unlock, 0x10 furniture, 0x20 harvest/activate */
+    uint32_t stateFlags;        /* DCF_STATE_* */
+    uint32_t reserved;
+    int64_t changeTimeNs;       /* When the game reported the change, steady-clock nanoseconds */
+    uint64_t changeCount;       /* Changes published since startup */
+    uint8_t padding[24];
+} DCF_CrosshairState;
+
+/* Handle signalled on every change: an auto-reset event HANDLE on Windows, an eventfd on Linux */
+typedef intptr_t DCF_ChangeHandle;
+
+typedef struct DCF_CrosshairAPI {
+    uint32_t version;   /* Highest DCF_API_VERSION the provider implements */
+    uint32_t size;      /* sizeof(DCF_CrosshairAPI) in the provider; fields are only ever appended */
+    const DCF_CrosshairState* state;
+
+    /* Optional change notification. Returns -1 once every slot is taken. The handle belongs to
+     * the provider: wait on it, never close it; give it back with UnsubscribeChanges. */
+    DCF_ChangeHandle (*SubscribeChanges)(void);
+    void (*UnsubscribeChanges)(DCF_ChangeHandle handle);
+
+    const char* (*GetInteractionTypeName)(uint32_t interactionType);
+} DCF_CrosshairAPI;
+
+/* Message payload; the provider fills api when it supports requestedVersion */
+typedef struct DCF_APIRequest {
+    uint32_t requestedVersion;
+    const DCF_CrosshairAPI* api;
+} DCF_APIRequest;
+
+#ifdef __cplusplus
+}
+
+static_assert(sizeof(DCF_CrosshairState) == 64, "DCF_CrosshairState must stay one cache line");
+
+#include <atomic>
+
+// Consistent copy of the state block; spins only while a write is in progress
+inline DCF_CrosshairState DCF_ReadCrosshairState(const DCF_CrosshairState* state) {
+    auto& shared = *const_cast<DCF_CrosshairState*>(state);
+    DCF_CrosshairState copy{};
+    for (;;) {
+        const uint32_t before = std::atomic_ref<uint32_t>(shared.sequence).load(std::memory_order_acquire);
+        if (before & 1) continue;
+
+        copy.formID = std::atomic_ref<uint32_t>(shared.formID).load(std::memory_order_relaxed);
+        copy.interactionType = std::atomic_ref<uint32_t>(shared.interactionType).load(std::memory_order_relaxed);
+        copy.activationFlags = std::atomic_ref<uint32_t>(shared.activationFlags).load(std::memory_order_relaxed);
+        copy.stateFlags = std::atomic_ref<uint32_t>(shared.stateFlags).load(std::memory_order_relaxed);
+        copy.changeTimeNs = std::atomic_ref<int64_t>(shared.changeTimeNs).load(std::memory_order_relaxed);
+        copy.changeCount = std::atomic_ref<uint64_t>(shared.changeCount).load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (std::atomic_ref<uint32_t>(shared.sequence).load(std::memory_order_relaxed) == before) {
+            copy.sequence = before;
+            return copy;
+        }
+    }
+}
+#endif
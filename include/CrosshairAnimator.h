@@ -0,0 +1,115 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// Crosshair transitions (crossfade, scale and rotation pulses, tint) as a fixed set of layer
+// slots, each easing one channel of the pose from a start to an end value. Time advances in
+// fixed steps, so a transition looks the same at any frame rate; the drawn pose is interpolated
+// between the last two steps. Easing curves are sampled from lookup tables, layer state is kept
+// as parallel arrays and every step evaluates all slots in branch-free loops the compiler can
+// vectorize. Nothing allocates after construction. Single-threaded (the render thread).
+class CrosshairAnimator {
+    public:
+        enum class Channel : uint8_t {
+            kOpacity,           // Current crosshair
+            kPreviousOpacity,   // Crosshair being faded out
+            kScale,             // Multiplies the configured size
+            kRotation,          // Radians
+            kTintR,
+            kTintG,
+            kTintB,
+            kCount
+        };
+        static constexpr std::size_t kChannelCount = static_cast<std::size_t>(Channel::kCount);
+
+        enum class Easing : uint8_t {
+            kLinear,
+            kOutCubic,
+            kInOutQuad,
+            kPulse,     // 0 -> 1 -> 0; for additive pulses that leave no trace
+            kWiggle,    // Damped oscillation ending at 0
+            kCount
+        };
+        static constexpr std::size_t kEasingCount = static_cast<std::size_t>(Easing::kCount);
+
+        enum class Blend : uint8_t {
+            kSet,   // Replaces the channel; a new one replaces an older one on the same channel
+            kAdd    // Adds on top of the base and any kSet layer; these stack
+        };
+
+        static constexpr uint32_t kMaxLayers = 16;
+        static constexpr uint32_t kLutSize = 64;
+        static constexpr float kStepSeconds = 1.0f / 120.0f;
+        static constexpr uint32_t kMaxStepsPerAdvance = 8;  // A long hitch skips ahead instead of catching up
+
+        struct Pose {
+            std::array<float, kChannelCount> values{};
+            float Get(Channel channel) const { return values[static_cast<std::size_t>(channel)]; }
+        };
+
+        struct Stats {
+            uint32_t activeLayers = 0;
+            uint32_t lastSteps = 0;     // Fixed steps run by the last Advance
+            int64_t lastAdvanceNs = 0;
+            int64_t maxAdvanceNs = 0;
+            float avgAdvanceNs = 0.0f;  // Smoothed over frames that had work
+            uint64_t started = 0;
+            uint64_t dropped = 0;       // Starts rejected because every slot was busy
+        };
+
+        CrosshairAnimator();
+
+        // Value a channel returns to when no layer drives it
+        void SetRest(Channel channel, float value);
+
+        // False when every slot is busy. Durations are rounded to whole steps, at least one.
+        bool Start(Channel channel, Easing easing, Blend blend, float from, float to, float seconds);
+
+        // Common transitions, starting from the pose as currently drawn so nothing pops
+        void Crossfade(float seconds);
+        void Pulse(Channel channel, float amplitude, float seconds);
+        void Wiggle(Channel channel, float amplitude, float seconds);
+        void TintTo(float r, float g, float b, float seconds);
+
+        // Once per frame with the real elapsed time
+        void Advance(float elapsedSeconds);
+        const Pose& GetPose() const { return pose; }
+        bool IsAnimating() const { return activeMask != 0; }
+
+        // Finishes every layer at once
+        void Reset();
+
+        const Stats& GetStats() const { return stats; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        uint32_t AcquireSlot(Channel channel, Blend blend);
+        void Step();
+        void Evaluate(Pose& out);
+        void Retire(uint32_t slot);
+
+        // Layer slots, one array per field
+        alignas(64) std::array<uint32_t, kMaxLayers> startTick{};
+        alignas(64) std::array<float, kMaxLayers> invDuration{};  // 1 / duration in steps
+        alignas(64) std::array<float, kMaxLayers> from{};
+        alignas(64) std::array<float, kMaxLayers> delta{};        // to - from
+        alignas(64) std::array<float, kMaxLayers> progress{};     // Scratch for Evaluate
+        alignas(64) std::array<float, kMaxLayers> value{};        // Scratch for Evaluate
+        std::array<uint32_t, kMaxLayers> endTick{};
+        std::array<Easing, kMaxLayers> easing{};
+        std::array<Channel, kMaxLayers> channel{};
+        std::array<Blend, kMaxLayers> blend{};
+        uint32_t activeMask = 0;
+
+        uint32_t tick = 0;
+        float accumulator = 0.0f;   // Seconds not yet stepped
+
+        Pose rest;
+        Pose previousStep;
+        Pose currentStep;
+        Pose pose;                  // previousStep -> currentStep at the leftover fraction
+
+        Stats stats;
+};
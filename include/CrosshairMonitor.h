@@ -1,33 +1,19 @@
 #pragma once
+#include "Allocator.h"
+#include "ChangeDispatcher.h"
+#include "InteractionClassifier.h"
 
 #include "RE/C/CrosshairPickData.h"
 #include "RE/T/TESObjectREFR.h"
 #include "RE/B/BGSKeywordForm.h"
 #include "SKSE/Events.h"  
 #include "SKSE/API.h"     
-#include <string>
+#include <atomic>
 
 class CrosshairMonitor : public RE::BSTEventSink<SKSE::CrosshairRefEvent> {
     public:
-        enum class InteractionType {
-            kNone,
-            kTalk,            // Talk to NPC
-            kOpen,            // Open container/door
-            kActivate,        // Generic activation
-            kTake,            // Take item
-            kHarvest,         // Harvest plants
-            kSearch,          // Search container/corpse
-            kSit,             // Sit in chair/bench
-            kSleep,           // Sleep in bed
-            kPickpocket,      // Pickpocket NPC
-            kLockpick,        // Lockpick door/container
-            kLockpickNone,    // Lockpickable, but player has no lockpicks
-            kRequiresKey,     // Locked, requires key that player doesn't have
-            kUseKey,          // Locked, requires key that player has
-            kRead,            // Read book
-            kDoor,            // Open door
-            kSteal            // Steal item
-        };
+        // Defined with the platform-neutral classifier; kept here under its original name
+        using InteractionType = ::InteractionType;
 
         static CrosshairMonitor* GetSingleton() {
             static CrosshairMonitor singleton;
@@ -38,6 +24,7 @@ class CrosshairMonitor : public RE::BSTEventSink<SKSE::CrosshairRefEvent> {
 
         RE::BSEventNotifyControl ProcessEvent(const SKSE::CrosshairRefEvent* a_event, RE::BSTEventSource<SKSE::CrosshairRefEvent>*) override;
         static void ProcessReferenceChange(RE::TESObjectREFR* newRef);
+        static void ProcessReferenceChange(RE::TESObjectREFR* newRef, InteractionType currentInteractionType, const TargetFacts& facts);
         
         static bool IsLookingAtInteractable();
         static RE::TESObjectREFR* GetCrosshairReference();
@@ -45,21 +32,32 @@ class CrosshairMonitor : public RE::BSTEventSink<SKSE::CrosshairRefEvent> {
         static uint32_t GetActivationFlagsForRef(RE::TESObjectREFR* ref);
         static InteractionType GetInteractionType();
         static InteractionType GetInteractionTypeForRef(RE::TESObjectREFR* ref);
+        // Reads from the game (via GameWorldView) only the facts ClassifyInteraction needs
+        static TargetFacts GatherFacts(RE::TESObjectREFR* ref);
         static bool HasInteractionType(InteractionType type);
         static bool IsFormType(RE::FormType type);
         static bool PlayerHasLockPicks();
+        static int32_t GetPlayerLockpickCount();
+
+        // Latest interaction type, safe to read from the render thread
+        static InteractionType GetPublishedInteractionType() { return publishedInteractionType.load(std::memory_order_acquire); }
+        // When the event behind the latest published change arrived, in Metrics::NowNs() time
+        static int64_t GetPublishedChangeTimeNs() { return publishedChangeTimeNs.load(std::memory_order_relaxed); }
+        static const char* GetInteractionTypeName(InteractionType type) { return InteractionTypeName(type); }
         
-        using CrosshairChangeCallback = std::function<void(RE::TESObjectREFR* newRef)>;
-        static void RegisterChangeCallback(CrosshairChangeCallback callback);
+        using CrosshairChangeCallback = ChangeDispatcher<RE::TESObjectREFR>::Callback;
+        // False once the dispatcher is full
+        static bool RegisterChangeCallback(CrosshairChangeCallback callback);
 
     private:
         //CrosshairMonitor() = default;
 
         static void PrintInteractionToConsole(RE::TESObjectREFR* ref, InteractionType type);
 
-        static inline RE::ObjectRefHandle lastCrosshairRef;
-        static inline InteractionType lastInteractionType = InteractionType::kNone;
-        static inline std::vector<CrosshairChangeCallback> callbacks;
+        static inline ChangeDispatcher<RE::TESObjectREFR> dispatcher;
+        static inline std::atomic<InteractionType> publishedInteractionType{ InteractionType::kNone };
+        static inline std::atomic<int64_t> publishedChangeTimeNs{ 0 };
+        static inline int64_t eventTimeNs = 0; // Arrival of the event being processed
 
         static inline RE::ObjectRefHandle lastTarget; // Last object looked at
         static inline RE::ObjectRefHandle lastTargetActor;
@@ -0,0 +1,18 @@
+#pragma once
+#include "CrosshairAPI.h"
+#include "InteractionClassifier.h"
+
+// Provider side of CrosshairAPI.h: owns the shared state block, the change handles handed to
+// consumers and the API table. Platform-neutral, so a stand-in consumer can drive it off-game.
+namespace CrosshairStateBlock {
+    // Writer thread only (the game thread in the plugin). Never allocates.
+    void Publish(const TargetFacts& facts, InteractionType type, int64_t changeTimeNs);
+
+    const DCF_CrosshairState& GetState();
+
+    // Answers a DCF_MESSAGE_REQUEST_API payload; false if the requested version is newer than ours
+    bool HandleRequest(DCF_APIRequest& request);
+
+    // Consumers currently subscribed to change notifications
+    uint32_t GetSubscriberCount();
+}
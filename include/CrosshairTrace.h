@@ -0,0 +1,87 @@
+#pragma once
+#include "Allocator.h"
+#include "InteractionClassifier.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+// Recorded stream of crosshair targets and the facts classification read for each, replayed
+// off-game by tools/crosshairreplay.
+//
+// File layout (little-endian): FileHeader, then FileRecord per event in arrival order.
+namespace CrosshairTrace {
+    inline constexpr char kMagic[8] = { 'D', 'C', 'F', 'X', 'R', 'E', 'C', '\0' };
+    inline constexpr uint32_t kVersion = 1;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t recordCount;
+    };
+    static_assert(sizeof(FileHeader) == 16);
+
+    struct FileRecord {
+        int64_t timeNs;         // Since the start of the recording
+        uint32_t formID;
+        uint8_t baseType;
+        uint8_t flags;          // FileRecordFlags
+        int8_t lockLevel;
+        uint8_t reserved;
+        int32_t lockpickCount;
+        uint32_t reserved2;
+    };
+    static_assert(sizeof(FileRecord) == 24);
+
+    enum FileRecordFlags : uint8_t {
+        kHasRef = 1 << 0,
+        kHasBase = 1 << 1,
+        kLocked = 1 << 2,
+        kDead = 1 << 3,
+        kSneaking = 1 << 4
+    };
+
+    struct Event {
+        int64_t timeNs;
+        TargetFacts facts;
+    };
+
+    FileRecord Pack(int64_t timeNs, const TargetFacts& facts);
+    Event Unpack(const FileRecord& record);
+
+    bool Read(const std::filesystem::path& path, std::vector<Event>& events);
+
+    // Buffers events in memory while recording and writes the file on Stop. Append is called
+    // from the game thread, Start/Stop from the menu.
+    class Recorder {
+        public:
+            static Recorder* GetSingleton() {
+                static Recorder singleton;
+                return &singleton;
+            }
+
+            bool Start(const std::filesystem::path& path);
+            // Writes the file; returns the number of events written, or -1 on failure
+            int64_t Stop();
+
+            bool IsRecording() const { return recording.load(std::memory_order_relaxed); }
+            void Append(int64_t nowNs, const TargetFacts& facts) {
+                if (recording.load(std::memory_order_relaxed)) {
+                    AppendLocked(nowNs, facts);
+                }
+            }
+
+        private:
+            Recorder() = default;
+            void AppendLocked(int64_t nowNs, const TargetFacts& facts);
+
+            static constexpr std::size_t kMaxEvents = 1 << 20;  // 24 MB
+
+            std::atomic<bool> recording = false;
+            std::mutex mutex;
+            std::filesystem::path outputPath;
+            int64_t startNs = 0;
+            Memory::Vector<FileRecord, Memory::Tag::kMonitor> records;
+    };
+}
@@ -1,41 +1,63 @@
 #pragma once
+#include "Allocator.h"
+#include "CrosshairAnimator.h"
 #include "CrosshairMonitor.h"
 #include "imgui.h"
-#include "imgui_impl_dx11.h"
-#include "imgui_impl_win32.h"
+#include <atomic>
 #include <map>
 #include <string>
 
-class CrosshairUI {
+class CrosshairUI : public RE::BSTEventSink<RE::MenuOpenCloseEvent> {
     public:
         static CrosshairUI* GetSingleton() {
             static CrosshairUI singleton;
             return &singleton;
         };
 
+        // Nothing is drawn before the main menu, so Init and the texture loads wait for it.
+        // At kDataLoaded: watches for the main menu. RequestInit queues Init on the render
+        // thread once, then decodes textures on the job pool; safe to call more than once.
+        void InitAfterMainMenu();
+        void RequestInit();
+
         bool Init();
         void Shutdown();
-        void BeginFrame();
-        void EndFrame();
-        ID3D11ShaderResourceView* LoadTextureFromFile(const std::string& filePath);
-        void ReleaseTexture(ID3D11ShaderResourceView* texture);
+        void Draw();
+        void SyncWithMonitor();
+        bool IsInitialized() const { return initialized; }
+        ImTextureID LoadTextureFromFile(const std::string& filePath);
+        void ReleaseTexture(ImTextureID texture);
         void UpdateCrosshairType(CrosshairMonitor::InteractionType iType);
+        const CrosshairAnimator::Stats& GetAnimationStats() const { return animator.GetStats(); }
+
+        RE::BSEventNotifyControl ProcessEvent(const RE::MenuOpenCloseEvent* a_event, RE::BSTEventSource<RE::MenuOpenCloseEvent>*) override;
 
     private:
         CrosshairUI() = default;
 
         bool initialized = false;
-        ID3D11Device* d3d_device = nullptr;
-        ID3D11DeviceContext* d3d_context = nullptr;
+        std::atomic<bool> initRequested = false;
 
-        bool GetD3D11DeviceAndContext();
         CrosshairMonitor::InteractionType currentType = CrosshairMonitor::InteractionType::kNone;
+        CrosshairMonitor::InteractionType previousType = CrosshairMonitor::InteractionType::kNone; // Fading out
+
+        // Transitions between types; advanced once per Present in SyncWithMonitor
+        CrosshairAnimator animator;
+        int64_t lastSyncNs = 0;
+        bool animating = false;
 
-        std::map<CrosshairMonitor::InteractionType, ImTextureID> crosshairTextures;
+        using TextureMap = std::map<CrosshairMonitor::InteractionType, ImTextureID, std::less<>,
+            Memory::StlAllocator<std::pair<const CrosshairMonitor::InteractionType, ImTextureID>, Memory::Tag::kTextures>>;
+        TextureMap crosshairTextures;
 
-        // Dimensions
-        float crosshairSize = 32.0f; // Default size
+        // Dimensions; the size comes from Settings
         ImVec2 screenCenter;
+        uint32_t settingsGeneration = 0; // Last Settings snapshot drawn with
 
+        // Decodes on the job pool; each upload runs as background work on the render thread
         void LoadTextures();
+        uint32_t pendingTextures = 0;   // Render thread
+        uint32_t loadedTextures = 0;
+        int64_t texturesStartNs = 0;
+        void DrawCrosshair(CrosshairMonitor::InteractionType type, float opacity);
 };
\ No newline at end of file
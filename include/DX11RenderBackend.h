@@ -0,0 +1,32 @@
+#pragma once
+#include "RenderBackend.h"
+#include <d3d11.h>
+
+// In-game backend: ImGui's Win32 platform and DX11 renderer backends on the game's device.
+class DX11RenderBackend : public RenderBackend {
+    public:
+        DX11RenderBackend(ID3D11Device* device, ID3D11DeviceContext* context, HWND hWnd);
+        ~DX11RenderBackend() override;
+
+        bool Init() override;
+        void Shutdown() override;
+        void NewFrame() override;
+        void RenderDrawData(ImDrawData* drawData) override;
+        ImVec2 GetDisplaySize() const override;
+
+        ImTextureID CreateTexture(uint32_t width, uint32_t height, const uint8_t* pixels) override;
+        void ReleaseTexture(ImTextureID texture) override;
+
+    private:
+        void TrackFontAtlas(int64_t bytes);
+
+        bool initialized = false;
+        ID3D11Device* d3d_device = nullptr;
+        ID3D11DeviceContext* d3d_context = nullptr;
+        HWND hWnd = nullptr;
+
+        // Video memory owned by ImGui's backend, reported under Memory::Tag::kImGui
+        int64_t fontAtlasBytes = 0;
+        int vertexCapacity = 0;
+        int indexCapacity = 0;
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include "InfoCards.h"
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+// Derived per-base-form data kept between launches. A cache file is a fixed header followed by
+// the entries exactly as they sit in memory, so a file that matches is mapped and used in place
+// instead of being rebuilt from every plugin's forms. Files are keyed by a hash of the load order
+// and of the rules that derived the data; a different key, version, entry size or file size is a
+// miss and the caller rebuilds. Validation reads the header only.
+namespace FormTableCache {
+    inline constexpr uint32_t kMagic = 0x54464344;  // "DCFT"
+    inline constexpr uint16_t kFormatVersion = 1;
+
+    struct Header {
+        uint32_t magic = kMagic;
+        uint16_t formatVersion = kFormatVersion;
+        uint16_t entrySize = sizeof(InfoCards::StaticInfo);
+        uint64_t key = 0;
+        uint32_t entryCount = 0;
+        uint32_t reserved = 0;
+    };
+    static_assert(sizeof(Header) == 24 && sizeof(Header) % alignof(InfoCards::StaticInfo) == 0);
+
+    // 64-bit FNV-1a over the rules version and then every plugin in load order. Names compare
+    // case-insensitively like the game's; size and write time catch a plugin updated in place.
+    class KeyBuilder {
+        public:
+            explicit KeyBuilder(uint32_t rulesVersion);
+            void AddPlugin(std::string_view name, uint64_t fileSize, int64_t writeTime);
+            uint64_t GetKey() const { return hash; }
+
+        private:
+            void Mix(const void* bytes, std::size_t count);
+            uint64_t hash;
+    };
+
+    enum class LoadResult : uint8_t {
+        kLoaded,
+        kMissing,       // No file yet, e.g. the first launch
+        kStale,         // Built for another load order or rule set
+        kInvalid        // Wrong magic, version or size
+    };
+    const char* LoadResultName(LoadResult result);
+
+    // Maps the file into the table when it matches the key; leaves the table alone otherwise
+    LoadResult Load(const std::filesystem::path& path, uint64_t key, InfoCards::StaticTable& table);
+
+    // Writes next to the target and renames over it, so a crash mid-write never leaves a
+    // truncated cache behind. Any thread.
+    bool Save(const std::filesystem::path& path, uint64_t key, std::span<const InfoCards::StaticInfo> entries);
+}
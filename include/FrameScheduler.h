@@ -0,0 +1,85 @@
+#pragma once
+#include "InplaceFunction.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+// Spreads work that must run on one thread (game or render) across frames. Each RunFrame runs
+// every critical task, then normal and background tasks until the frame's budget is spent; the
+// rest waits for the next frame. The budget shrinks while the measured frame time (fed through
+// RecordFrameTime) runs over the target and recovers when it gets back under. Posting is safe
+// from any thread and never allocates; a full queue rejects the task.
+class FrameScheduler {
+    public:
+        using Task = InplaceFunction<void(), 64>;
+
+        enum class Priority : uint8_t {
+            kCritical,   // Latency-sensitive; always runs in the next frame
+            kNormal,
+            kBackground, // Uploads and other bulk work; first to be deferred
+            kCount
+        };
+        static constexpr std::size_t kPriorityCount = static_cast<std::size_t>(Priority::kCount);
+        static constexpr uint32_t kQueueCapacity = 256;  // Per priority
+
+        struct Stats {
+            std::array<uint32_t, kPriorityCount> pending{};
+            uint32_t budgetUs = 0;       // Budget of the last frame, after adapting
+            uint32_t lastSpentUs = 0;    // Time spent running tasks in the last frame
+            float avgFrameMs = 0.0f;     // Smoothed RecordFrameTime samples
+            uint64_t executed = 0;
+            uint64_t deferredFrames = 0; // Frames that ended with work left over
+            uint64_t dropped = 0;        // Posts rejected by a full queue
+        };
+
+        explicit FrameScheduler(const char* name) : name(name) {}
+
+        const char* GetName() const { return name; }
+
+        // Any thread. False (and counted as dropped) when that priority's queue is full.
+        bool Post(Priority priority, Task task);
+
+        // Owning thread, once per frame. Returns the number of tasks run.
+        uint32_t RunFrame();
+
+        // One thread, once per frame: the full frame interval, not just this scheduler's share.
+        // Samples over 250 ms are loading screens or pauses and are ignored.
+        void RecordFrameTime(float frameMs);
+
+        // Budget while frames make the target frame time; slower frames scale it down to base/4
+        void SetBudgetUs(uint32_t budgetUs) { baseBudgetUs.store(budgetUs, std::memory_order_relaxed); }
+        uint32_t GetBudgetUs() const { return baseBudgetUs.load(std::memory_order_relaxed); }
+        void SetTargetFrameMs(float frameMs) { targetFrameMs.store(frameMs, std::memory_order_relaxed); }
+
+        uint32_t GetPendingCount() const;
+        Stats GetStats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Queue {
+            std::array<Task, kQueueCapacity> ring;
+            uint32_t head = 0;
+            uint32_t size = 0;
+        };
+
+        bool Pop(Priority priority, Task& task);
+        uint32_t AdaptBudget();
+
+        const char* name;
+        std::mutex mutex;
+        std::array<Queue, kPriorityCount> queues;
+        std::array<std::atomic<uint32_t>, kPriorityCount> pending{};
+
+        std::atomic<uint32_t> baseBudgetUs = 1000;
+        std::atomic<float> targetFrameMs = 1000.0f / 60.0f;
+
+        std::atomic<float> avgFrameMs = 0.0f;
+        std::atomic<uint32_t> budgetUs = 0;
+        std::atomic<uint32_t> lastSpentUs = 0;
+        std::atomic<uint64_t> executed = 0;
+        std::atomic<uint64_t> deferredFrames = 0;
+        std::atomic<uint64_t> dropped = 0;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include "WorldView.h"
+
+#include "RE/Skyrim.h"
+
+// WorldView over the live game. Stateless; construct one wherever it is needed.
+struct GameWorldView {
+    using Target = RE::TESObjectREFR*;
+
+    uint32_t GetFormID(Target ref) const { return ref->GetFormID(); }
+
+    std::optional<uint8_t> GetBaseType(Target ref) const {
+        auto* baseObj = ref->GetBaseObject();
+        if (!baseObj) return std::nullopt;
+        return static_cast<uint8_t>(baseObj->GetFormType());
+    }
+
+    LockInfo GetLockInfo(Target ref) const {
+        LockInfo lock;
+        lock.locked = ref->IsLocked();
+        if (lock.locked) {
+            lock.level = static_cast<LockLevel>(ref->GetLockLevel());
+        }
+        return lock;
+    }
+
+    bool IsDead(Target ref) const { return ref->IsDead(); }
+
+    bool IsPlayerSneaking() const {
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        return player && player->IsSneaking();
+    }
+
+    int32_t GetPlayerItemCount(uint32_t itemFormID) const {
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        if (!player) return 0;
+
+        auto* item = RE::TESForm::LookupByID<RE::TESBoundObject>(itemFormID);
+        if (!item) return 0;
+
+        return player->GetItemCount(item);
+    }
+};
+static_assert(WorldView<GameWorldView>);
+
+// The neutral enums mirror the game's values so facts convert with a cast
+static_assert(static_cast<uint8_t>(RE::FormType::Activator) == static_cast<uint8_t>(BaseType::kActivator));
+static_assert(static_cast<uint8_t>(RE::FormType::Book) == static_cast<uint8_t>(BaseType::kBook));
+static_assert(static_cast<uint8_t>(RE::FormType::Container) == static_cast<uint8_t>(BaseType::kContainer));
+static_assert(static_cast<uint8_t>(RE::FormType::Door) == static_cast<uint8_t>(BaseType::kDoor));
+static_assert(static_cast<uint8_t>(RE::FormType::Tree) == static_cast<uint8_t>(BaseType::kTree));
+static_assert(static_cast<uint8_t>(RE::FormType::Flora) == static_cast<uint8_t>(BaseType::kFlora));
+static_assert(static_cast<uint8_t>(RE::FormType::Furniture) == static_cast<uint8_t>(BaseType::kFurniture));
+static_assert(static_cast<uint8_t>(RE::FormType::NPC) == static_cast<uint8_t>(BaseType::kNPC));
+static_assert(static_cast<uint8_t>(RE::FormType::ActorCharacter) == static_cast<uint8_t>(BaseType::kActorCharacter));
+static_assert(static_cast<int8_t>(RE::LOCK_LEVEL::kUnlocked) == static_cast<int8_t>(LockLevel::kUnlocked));
+static_assert(static_cast<int8_t>(RE::LOCK_LEVEL::kVeryEasy) == static_cast<int8_t>(LockLevel::kVeryEasy));
+static_assert(static_cast<int8_t>(RE::LOCK_LEVEL::kVeryHard) == static_cast<int8_t>(LockLevel::kVeryHard));
+static_assert(static_cast<int8_t>(RE::LOCK_LEVEL::kRequiresKey) == static_cast<int8_t>(LockLevel::kRequiresKey));
@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Installs the plugin's game hooks once and runs each hook's per-call work from a dispatch
+// table. Tables are rebuilt on the hooked thread when the Settings snapshot changes, so a
+// disabled feature is simply absent from its table; the steady-state cost of a toggle is one
+// generation compare per call. Each hook records the time spent in our work, excluding the
+// game function it wraps.
+class HookManager {
+    public:
+        enum class Hook : uint8_t {
+            kPresent,   // IDXGISwapChain::Present, render thread
+            kInput,     // Input event dispatch, main thread
+            kCount
+        };
+        static constexpr std::size_t kHookCount = static_cast<std::size_t>(Hook::kCount);
+
+        enum class Feature : uint8_t {
+            kOverlay,   // Crosshair layer and target-to-pixel latency
+            kMenu,      // Configuration menu and its input capture
+            kTracing    // Trace captures and thread naming
+        };
+
+        struct HookStats {
+            uint64_t calls = 0;
+            uint64_t totalNs = 0;
+            uint64_t maxNs = 0;
+        };
+
+        static HookManager* GetSingleton() {
+            static HookManager singleton;
+            return &singleton;
+        }
+
+        // Once, after the renderer and UI exist (kDataLoaded). Hooks that fail stay uninstalled.
+        bool Install();
+        bool IsInstalled(Hook hook) const { return installed[static_cast<std::size_t>(hook)]; }
+
+        // Any thread; reads the current Settings snapshot
+        static bool IsFeatureEnabled(Feature feature);
+        static const char* GetHookName(Hook hook);
+
+        // Any thread; each hook's counters are written only by its own thread
+        HookStats GetStats(Hook hook) const;
+        void ResetStats();
+        // Hooked thread only
+        void Record(Hook hook, int64_t elapsedNs);
+
+    private:
+        HookManager() = default;
+
+        struct Counters {
+            std::atomic<uint64_t> calls = 0;
+            std::atomic<uint64_t> totalNs = 0;
+            std::atomic<uint64_t> maxNs = 0;
+        };
+
+        std::array<bool, kHookCount> installed{};
+        std::array<Counters, kHookCount> counters;
+};
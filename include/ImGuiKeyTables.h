@@ -0,0 +1,74 @@
+#pragma once
+#include "KeyTables.h"
+#include "imgui.h"
+
+// Windows virtual key -> ImGuiKey, the last step after KeyTranslator::ToVirtualKey
+namespace KeyTables {
+    inline constexpr std::array<ImGuiKey, 256> kVKToImGuiKey = [] {
+        std::array<ImGuiKey, 256> t{};
+        t[VK::Back] = ImGuiKey_Backspace;
+        t[VK::Tab] = ImGuiKey_Tab;
+        t[VK::Return] = ImGuiKey_Enter;
+        t[VK::KeypadEnter] = ImGuiKey_KeypadEnter;
+        t[VK::Pause] = ImGuiKey_Pause;
+        t[VK::Capital] = ImGuiKey_CapsLock;
+        t[VK::Escape] = ImGuiKey_Escape;
+        t[VK::Space] = ImGuiKey_Space;
+        t[VK::Prior] = ImGuiKey_PageUp;
+        t[VK::Next] = ImGuiKey_PageDown;
+        t[VK::End] = ImGuiKey_End;
+        t[VK::Home] = ImGuiKey_Home;
+        t[VK::Left] = ImGuiKey_LeftArrow;
+        t[VK::Up] = ImGuiKey_UpArrow;
+        t[VK::Right] = ImGuiKey_RightArrow;
+        t[VK::Down] = ImGuiKey_DownArrow;
+        t[VK::Snapshot] = ImGuiKey_PrintScreen;
+        t[VK::Insert] = ImGuiKey_Insert;
+        t[VK::Delete] = ImGuiKey_Delete;
+        for (int i = 0; i < 10; i++) t[VK::Key0 + i] = static_cast<ImGuiKey>(ImGuiKey_0 + i);
+        for (int i = 0; i < 26; i++) t[VK::KeyA + i] = static_cast<ImGuiKey>(ImGuiKey_A + i);
+        t[VK::LWin] = ImGuiKey_LeftSuper;
+        t[VK::RWin] = ImGuiKey_RightSuper;
+        t[VK::Apps] = ImGuiKey_Menu;
+        for (int i = 0; i < 10; i++) t[VK::Numpad0 + i] = static_cast<ImGuiKey>(ImGuiKey_Keypad0 + i);
+        t[VK::Multiply] = ImGuiKey_KeypadMultiply;
+        t[VK::Add] = ImGuiKey_KeypadAdd;
+        t[VK::Subtract] = ImGuiKey_KeypadSubtract;
+        t[VK::Decimal] = ImGuiKey_KeypadDecimal;
+        t[VK::Divide] = ImGuiKey_KeypadDivide;
+        for (int i = 0; i < 12; i++) t[VK::F1 + i] = static_cast<ImGuiKey>(ImGuiKey_F1 + i);
+        // The DIK table reaches F13-F15 (0x64-0x66)
+        for (int i = 0; i < 3; i++) t[VK::F13 + i] = static_cast<ImGuiKey>(ImGuiKey_F13 + i);
+        t[VK::NumLock] = ImGuiKey_NumLock;
+        t[VK::Scroll] = ImGuiKey_ScrollLock;
+        t[VK::LShift] = ImGuiKey_LeftShift;
+        t[VK::RShift] = ImGuiKey_RightShift;
+        t[VK::LControl] = ImGuiKey_LeftCtrl;
+        t[VK::RControl] = ImGuiKey_RightCtrl;
+        t[VK::LMenu] = ImGuiKey_LeftAlt;
+        t[VK::RMenu] = ImGuiKey_RightAlt;
+        t[VK::Oem1] = ImGuiKey_Semicolon;
+        t[VK::OemPlus] = ImGuiKey_Equal;
+        t[VK::OemComma] = ImGuiKey_Comma;
+        t[VK::OemMinus] = ImGuiKey_Minus;
+        t[VK::OemPeriod] = ImGuiKey_Period;
+        t[VK::Oem2] = ImGuiKey_Slash;
+        t[VK::Oem3] = ImGuiKey_GraveAccent;
+        t[VK::Oem4] = ImGuiKey_LeftBracket;
+        t[VK::Oem5] = ImGuiKey_Backslash;
+        t[VK::Oem6] = ImGuiKey_RightBracket;
+        t[VK::Oem7] = ImGuiKey_Apostrophe;
+        return t;
+    }();
+
+    // Modifier state carried by each virtual key, for ImGuiMod_* events
+    inline constexpr std::array<ImGuiKey, 256> kVKToImGuiMod = [] {
+        std::array<ImGuiKey, 256> t{};
+        t[VK::LShift] = t[VK::RShift] = ImGuiMod_Shift;
+        t[VK::LControl] = t[VK::RControl] = ImGuiMod_Ctrl;
+        t[VK::LMenu] = t[VK::RMenu] = ImGuiMod_Alt;
+        t[VK::LWin] = t[VK::RWin] = ImGuiMod_Super;
+        return t;
+    }();
+
+}
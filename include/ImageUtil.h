@@ -0,0 +1,22 @@
+#pragma once
+#include "Allocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// Portable image decode/convert for crosshair textures. Output is always premultiplied BGRA,
+// the layout DX11RenderBackend::CreateTexture and WIC's 32bppPBGRA path hand to the GPU.
+namespace ImageUtil {
+    struct Image {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        Memory::Vector<uint8_t, Memory::Tag::kTextures> pixels;  // width * height * 4, top row first
+    };
+
+    // Truecolor (24/32-bit) and grayscale (8-bit) TGA, raw or RLE; colour-mapped files are rejected
+    bool DecodeTga(const uint8_t* data, std::size_t size, Image& image);
+    bool LoadTga(const std::filesystem::path& path, Image& image);
+
+    // Straight -> premultiplied alpha, in place
+    void PremultiplyAlpha(uint8_t* bgra, std::size_t pixelCount);
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "InfoCards.h"
+#include "imgui.h"
+
+#include "RE/Skyrim.h"
+#include <atomic>
+#include <mutex>
+
+// Compact card under the crosshair for the item or container being looked at. The game thread
+// keeps the card's data current through InfoCards and hands a finished layout over; the render
+// thread draws it as an overlay layer and measures the text only when a new layout arrives.
+class InfoCardUI :
+    public RE::BSTEventSink<RE::TESLockChangedEvent>,
+    public RE::BSTEventSink<RE::TESContainerChangedEvent>,
+    public RE::BSTEventSink<RE::TESCellAttachDetachEvent> {
+    public:
+        struct Stats {
+            uint32_t staticForms = 0;
+            uint64_t cacheHits = 0;
+            uint64_t cacheMisses = 0;
+            uint64_t invalidations = 0;
+            uint64_t layoutsBuilt = 0;
+            int64_t lastUpdateNs = 0;   // Cost of the last target change
+        };
+
+        static InfoCardUI* GetSingleton() {
+            static InfoCardUI singleton;
+            return &singleton;
+        }
+
+        // At kDataLoaded, after the UI renderer: builds the static table, registers the layer
+        // and the events that invalidate cached references
+        bool Init();
+        bool IsInitialized() const { return initialized; }
+
+        // Game thread, for every crosshair change
+        void OnTargetChanged(RE::TESObjectREFR* ref);
+        // Game thread; reference IDs are reused once another save is loaded
+        void OnGameLoaded();
+
+        // Render thread, once per Present; picks up a newly published layout
+        void SyncWithGame();
+
+        Stats GetStats() const;
+
+        RE::BSEventNotifyControl ProcessEvent(const RE::TESLockChangedEvent* a_event, RE::BSTEventSource<RE::TESLockChangedEvent>*) override;
+        RE::BSEventNotifyControl ProcessEvent(const RE::TESContainerChangedEvent* a_event, RE::BSTEventSource<RE::TESContainerChangedEvent>*) override;
+        RE::BSEventNotifyControl ProcessEvent(const RE::TESCellAttachDetachEvent* a_event, RE::BSTEventSource<RE::TESCellAttachDetachEvent>*) override;
+
+    private:
+        InfoCardUI() = default;
+
+        void Draw();
+        void Invalidate(uint32_t refID);
+        void Publish(const InfoCards::Layout* card);    // Null hides the card
+
+        bool initialized = false;
+
+        // Game thread
+        InfoCards::StaticTable staticTable;
+        InfoCards::DynamicCache dynamicCache;
+        InfoCards::Layout layout;
+        RE::ObjectRefHandle currentTarget;
+        struct LayoutKey {
+            uint32_t refID = 0;
+            uint32_t cacheGeneration = UINT32_MAX;
+            bool operator==(const LayoutKey&) const = default;
+        } layoutKey;
+
+        // Game -> render handoff; the lock is taken only when the version moved
+        std::mutex publishMutex;
+        InfoCards::Layout published;
+        bool publishedVisible = false;
+        std::atomic<uint32_t> publishedVersion = 0;
+
+        // Render thread
+        uint32_t drawnVersion = 0;
+        InfoCards::Layout drawn;
+        bool visible = false;
+        bool measured = false;
+        std::array<ImVec2, InfoCards::Layout::kMaxLines> lineSizes{};
+        ImVec2 cardSize;
+
+        std::atomic<uint32_t> staticForms = 0;
+        std::atomic<uint64_t> layoutsBuilt = 0;
+        std::atomic<uint64_t> cacheHits = 0;
+        std::atomic<uint64_t> cacheMisses = 0;
+        std::atomic<uint64_t> invalidations = 0;
+        std::atomic<int64_t> lastUpdateNs = 0;
+};
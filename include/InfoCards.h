@@ -0,0 +1,102 @@
+#pragma once
+#include "Allocator.h"
+#include "InteractionClassifier.h"
+#include "MappedFile.h"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// Data behind the target info card: what never changes per base form (value, weight,
+// enchantment) lives in a table built once when game data has loaded; what can change per
+// reference (lock, owner, count) lives in a small LRU that game events invalidate; the text is
+// formatted only when either input changes. Platform-neutral, so the whole lookup path can be
+// benchmarked off-game. Game thread only.
+namespace InfoCards {
+    enum StaticFlags : uint8_t {
+        kEnchanted = 1 << 0
+    };
+
+    struct StaticInfo {
+        uint32_t formID = 0;    // Base object
+        int32_t value = 0;
+        float weight = 0.0f;
+        uint8_t flags = 0;      // StaticFlags
+        std::array<uint8_t, 3> reserved{};
+    };
+    // Written to and mapped from FormTableCache files as is
+    static_assert(sizeof(StaticInfo) == 16 && std::is_trivially_copyable_v<StaticInfo>);
+
+    // Sorted by form ID; built once, then read-only. The entries live either in the table's own
+    // storage or in a mapped cache file the table keeps open.
+    class StaticTable {
+        public:
+            void Build(Memory::Vector<StaticInfo, Memory::Tag::kUI>&& entries);
+            // Entries already sorted, read in place from the file
+            void Adopt(MappedFile&& file, std::span<const StaticInfo> sorted);
+
+            const StaticInfo* Find(uint32_t formID) const;
+            std::span<const StaticInfo> GetEntries() const { return view; }
+            std::size_t GetSize() const { return view.size(); }
+            bool IsMapped() const { return mapping.IsOpen(); }
+
+        private:
+            Memory::Vector<StaticInfo, Memory::Tag::kUI> entries;
+            MappedFile mapping;
+            std::span<const StaticInfo> view;   // Into one of the two; both keep their address when moved
+    };
+
+    struct DynamicInfo {
+        static constexpr std::size_t kOwnerNameLength = 40;
+
+        uint32_t refID = 0;
+        uint32_t count = 1;
+        bool locked = false;
+        LockLevel lockLevel = LockLevel::kUnlocked;
+        std::array<char, kOwnerNameLength> ownerName{};   // Empty when unowned
+    };
+
+    // Fixed capacity, least recently used entry evicted first. Never allocates.
+    class DynamicCache {
+        public:
+            static constexpr uint32_t kCapacity = 32;
+
+            struct Stats {
+                uint64_t hits = 0;
+                uint64_t misses = 0;
+                uint64_t evictions = 0;
+                uint64_t invalidations = 0;
+            };
+
+            // Marks the entry as most recently used
+            const DynamicInfo* Find(uint32_t refID);
+            const DynamicInfo& Insert(const DynamicInfo& info);
+            bool Invalidate(uint32_t refID);
+            void Clear();
+
+            // Bumped whenever an entry is replaced or dropped, so cached layouts can tell
+            uint32_t GetGeneration() const { return generation; }
+            const Stats& GetStats() const { return stats; }
+
+        private:
+            std::array<uint32_t, kCapacity> keys{};     // 0 marks a free slot
+            std::array<uint64_t, kCapacity> lastUse{};
+            std::array<DynamicInfo, kCapacity> infos{};
+            uint64_t useClock = 0;
+            uint32_t generation = 0;
+            Stats stats;
+    };
+
+    struct Layout {
+        static constexpr std::size_t kMaxLines = 4;
+        static constexpr std::size_t kLineLength = 48;
+
+        std::array<std::array<char, kLineLength>, kMaxLines> lines{};
+        uint32_t lineCount = 0;
+    };
+
+    // Writes the card's lines; names longer than a line are truncated
+    void FormatLayout(const char* name, const StaticInfo* staticInfo, const DynamicInfo& dynamicInfo, Layout& layout);
+
+    const char* LockLevelName(LockLevel level);
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <class Signature, std::size_t Capacity = 32>
+class InplaceFunction;
+
+// std::function replacement that stores the callable in a fixed inline buffer and never
+// allocates. Callables that do not fit are rejected at compile time.
+template <class R, class... Args, std::size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+    public:
+        InplaceFunction() = default;
+        InplaceFunction(std::nullptr_t) {}
+
+        template <class F, class Fn = std::decay_t<F>,
+            class = std::enable_if_t<!std::is_same_v<Fn, InplaceFunction> && std::is_invocable_r_v<R, Fn&, Args...>>>
+        InplaceFunction(F&& f) {
+            static_assert(sizeof(Fn) <= Capacity, "Callable too large for InplaceFunction; capture less or raise Capacity");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t), "Callable is over-aligned for InplaceFunction");
+            static_assert(std::is_nothrow_move_constructible_v<Fn>, "Callable must be nothrow move constructible");
+
+            ::new (static_cast<void*>(storage)) Fn(std::forward<F>(f));
+            invoke = [](void* obj, Args&&... args) -> R {
+                return (*static_cast<Fn*>(obj))(std::forward<Args>(args)...);
+            };
+            manage = [](Operation op, void* dst, void* src) {
+                if (op == Operation::kMove) {
+                    ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                    static_cast<Fn*>(src)->~Fn();
+                } else if (op == Operation::kCopy) {
+                    ::new (dst) Fn(*static_cast<const Fn*>(src));
+                } else {
+                    static_cast<Fn*>(dst)->~Fn();
+                }
+            };
+        }
+
+        InplaceFunction(const InplaceFunction& other) { CopyFrom(other); }
+        InplaceFunction(InplaceFunction&& other) noexcept { MoveFrom(other); }
+
+        InplaceFunction& operator=(const InplaceFunction& other) {
+            if (this != &other) {
+                Reset();
+                CopyFrom(other);
+            }
+            return *this;
+        }
+
+        InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+            if (this != &other) {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        ~InplaceFunction() { Reset(); }
+
+        R operator()(Args... args) const {
+            return invoke(const_cast<void*>(static_cast<const void*>(storage)), std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const { return invoke != nullptr; }
+
+    private:
+        enum class Operation {
+            kMove,
+            kCopy,
+            kDestroy
+        };
+
+        alignas(std::max_align_t) std::byte storage[Capacity];
+        R (*invoke)(void*, Args&&...) = nullptr;
+        void (*manage)(Operation, void*, void*) = nullptr;
+
+        void Reset() {
+            if (manage) {
+                manage(Operation::kDestroy, storage, nullptr);
+            }
+            invoke = nullptr;
+            manage = nullptr;
+        }
+
+        void CopyFrom(const InplaceFunction& other) {
+            if (other.manage) {
+                other.manage(Operation::kCopy, storage, const_cast<std::byte*>(other.storage));
+            }
+            invoke = other.invoke;
+            manage = other.manage;
+        }
+
+        void MoveFrom(InplaceFunction& other) {
+            if (other.manage) {
+                other.manage(Operation::kMove, storage, other.storage);
+            }
+            invoke = other.invoke;
+            manage = other.manage;
+            other.invoke = nullptr;
+            other.manage = nullptr;
+        }
+};
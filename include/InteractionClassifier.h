@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Crosshair interaction classification as a pure function of the facts it reads, with no game
+// dependencies, so recorded traces can be replayed and classification profiled off-game.
+// CrosshairMonitor gathers the facts from the live game; tools/crosshairreplay reads them back.
+
+enum class InteractionType {
+    kNone,
+    kTalk,            // Talk to NPC
+    kOpen,            // Open container/door
+    kActivate,        // Generic activation
+    kTake,            // Take item
+    kHarvest,         // Harvest plants
+    kSearch,          // Search container/corpse
+    kSit,             // Sit in chair/bench
+    kSleep,           // Sleep in bed
+    kPickpocket,      // Pickpocket NPC
+    kLockpick,        // Lockpick door/container
+    kLockpickNone,    // Lockpickable, but player has no lockpicks
+    kRequiresKey,     // Locked, requires key that player doesn't have
+    kUseKey,          // Locked, requires key that player has
+    kRead,            // Read book
+    kDoor,            // Open door
+    kSteal            // Steal item
+};
+
+inline constexpr std::size_t kInteractionTypeCount = static_cast<std::size_t>(InteractionType::kSteal) + 1;
+
+const char* InteractionTypeName(InteractionType type);
+
+// Values match RE::FormType for the base object types classification looks at
+enum class BaseType : uint8_t {
+    kNone = 0,
+    kActivator = 24,
+    kBook = 27,
+    kContainer = 28,
+    kDoor = 29,
+    kTree = 38,
+    kFlora = 39,
+    kFurniture = 40,
+    kNPC = 43,
+    kActorCharacter = 62
+};
+
+// Values match RE::LOCK_LEVEL
+enum class LockLevel : int8_t {
+    kUnlocked = -1,
+    kVeryEasy = 0,
+    kEasy = 1,
+    kAverage = 2,
+    kHard = 3,
+    kVeryHard = 4,
+    kRequiresKey = 5
+};
+
+// Everything classification may read about a crosshair target. Facts the classifier does not
+// need for a given target (sneak state for a door, lockpicks for a chair) are not gathered and
+// stay at their defaults.
+struct TargetFacts {
+    uint32_t formID = 0;
+    bool hasRef = false;
+    bool hasBase = false;
+    uint8_t baseType = 0;   // Raw FormType, compared against BaseType
+    bool locked = false;
+    LockLevel lockLevel = LockLevel::kUnlocked;
+    bool dead = false;
+    bool playerSneaking = false;
+    int32_t lockpickCount = 0;
+
+    bool Is(BaseType type) const { return baseType == static_cast<uint8_t>(type); }
+
+    // Which facts Classify reads beyond the base type, so gatherers can skip the rest
+    bool NeedsSneakState() const { return Is(BaseType::kNPC); }
+    bool NeedsDeadState() const { return Is(BaseType::kActorCharacter); }
+    bool NeedsLockpickCount() const {
+        return Is(BaseType::kDoor) && locked && lockLevel >= LockLevel::kVeryEasy && lockLevel <= LockLevel::kVeryHard;
+    }
+};
+
+// Synthetic activation flags: 0x01 talk, 0x02 container/door, 0x04 read/take, 0x08 unlock,
+// 0x10 furniture, 0x20 harvest/activate
+uint32_t GetActivationFlags(const TargetFacts& facts);
+InteractionType ClassifyInteraction(const TargetFacts& facts);
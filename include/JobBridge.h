@@ -0,0 +1,31 @@
+#pragma once
+#include "FrameScheduler.h"
+#include "JobSystem.h"
+
+// Hands results from the job pool back to the threads that own game and render state. Each
+// target has a FrameScheduler that spreads posted callbacks over frames under a time budget:
+// the render one runs at the start of every Present, the game one is pumped through SKSE's
+// task interface (main thread, between frames) for as long as it has work.
+namespace JobBridge {
+    // Small enough that a completion plus its target fits in one job slot
+    using Callback = FrameScheduler::Task;
+    using Priority = FrameScheduler::Priority;
+
+    enum class Target : uint8_t {
+        kGame,
+        kRender
+    };
+
+    FrameScheduler& GetScheduler(Target target);
+
+    // Any thread. False when the target's queue for that priority is full.
+    bool Post(Target target, Callback callback, Priority priority = Priority::kNormal);
+
+    // Runs work on the pool, then completion on the target thread. Neither runs once the token
+    // is cancelled; the returned handle finishes when completion has been posted.
+    Jobs::JobHandle Run(Jobs::Function work, Target target, Callback completion, Jobs::CancellationToken token = {},
+        Priority priority = Priority::kNormal);
+
+    // Present thread only; runs this frame's share of the render callbacks
+    void RunRenderFrame();
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "Allocator.h"
+#include "InplaceFunction.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+// Small work-stealing thread pool for work that should not run on a game thread: texture
+// decode, prewarming, indexing. Each worker owns a queue it pushes to and pops from (LIFO, for
+// locality); idle workers steal the oldest job from the others. Jobs may depend on other jobs
+// and may be cancelled through a token. No game or Windows dependencies; JobBridge posts
+// results back to the game and render threads.
+namespace Jobs {
+    // Stored inline in the job slot, so scheduling allocates nothing beyond dependency edges
+    using Function = InplaceFunction<void(), 96>;
+
+    class CancellationToken {
+        public:
+            CancellationToken() = default;
+            bool IsCancelled() const { return state && state->load(std::memory_order_relaxed); }
+
+        private:
+            friend class CancellationSource;
+            explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> state) : state(std::move(state)) {}
+
+            std::shared_ptr<const std::atomic<bool>> state;
+    };
+
+    // Cancelling stops jobs holding the token from starting; jobs already running finish (they
+    // can poll the token). A cancelled job still completes, so its dependents are released.
+    class CancellationSource {
+        public:
+            CancellationSource() :
+                state(std::allocate_shared<std::atomic<bool>>(Memory::StlAllocator<std::atomic<bool>, Memory::Tag::kJobs>(), false)) {}
+
+            void Cancel() { state->store(true, std::memory_order_relaxed); }
+            bool IsCancelled() const { return state->load(std::memory_order_relaxed); }
+            CancellationToken GetToken() const { return CancellationToken(state); }
+
+        private:
+            std::shared_ptr<std::atomic<bool>> state;
+    };
+
+    struct Job;
+
+    // Refers to one scheduled job. Stays safe to query after the job's slot is reused; a default
+    // handle, or one for a finished job, counts as finished.
+    struct JobHandle {
+        Job* job = nullptr;
+        uint32_t generation = 0;
+    };
+
+    // Starts the workers; onThreadStart(index) runs first on each (e.g. to name it for tracing)
+    bool Init(uint32_t workerCount, void (*onThreadStart)(uint32_t index) = nullptr);
+    // Waits for every scheduled job, then stops the workers
+    void Shutdown();
+    bool IsRunning();
+    uint32_t GetWorkerCount();
+    // Index of the calling worker, or -1 off the pool
+    int32_t GetCurrentWorkerIndex();
+
+    // Runs fn on the pool once every dependency has finished. If the pool is not running or all
+    // job slots are in use, waits for the dependencies and runs fn inline instead.
+    JobHandle Schedule(Function fn, std::span<const JobHandle> dependencies, CancellationToken token = {});
+    inline JobHandle Schedule(Function fn, CancellationToken token = {}) {
+        return Schedule(std::move(fn), std::span<const JobHandle>(), std::move(token));
+    }
+    inline JobHandle Then(JobHandle dependency, Function fn, CancellationToken token = {}) {
+        return Schedule(std::move(fn), std::span<const JobHandle>(&dependency, 1), std::move(token));
+    }
+
+    bool IsFinished(JobHandle handle);
+    // On a worker, runs other jobs while waiting; elsewhere, blocks. Never call from a game
+    // thread on a job that might take more than a frame.
+    void Wait(JobHandle handle);
+
+    struct Stats {
+        uint64_t executed = 0;
+        uint64_t stolen = 0;
+        uint64_t cancelled = 0;
+        uint64_t ranInline = 0;    // Ran on the scheduling thread (pool stopped or full)
+        uint32_t inFlight = 0;     // Scheduled and not yet finished
+    };
+    Stats GetStats();
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// DirectInput scan code -> Windows virtual key translation tables (VK -> ImGuiKey is in
+// ImGuiKeyTables.h). Virtual-key values are spelled out here so the tables build without
+// <Windows.h>, and this header has no ImGui or game dependencies.
+namespace KeyTables {
+    namespace VK {
+        inline constexpr uint8_t Back = 0x08, Tab = 0x09, Return = 0x0D, Pause = 0x13, Capital = 0x14, Escape = 0x1B;
+        inline constexpr uint8_t Space = 0x20, Prior = 0x21, Next = 0x22, End = 0x23, Home = 0x24;
+        inline constexpr uint8_t Left = 0x25, Up = 0x26, Right = 0x27, Down = 0x28;
+        inline constexpr uint8_t Snapshot = 0x2C, Insert = 0x2D, Delete = 0x2E;
+        inline constexpr uint8_t Key0 = 0x30, KeyA = 0x41;
+        inline constexpr uint8_t LWin = 0x5B, RWin = 0x5C, Apps = 0x5D;
+        inline constexpr uint8_t Numpad0 = 0x60, Multiply = 0x6A, Add = 0x6B, Subtract = 0x6D, Decimal = 0x6E, Divide = 0x6F;
+        inline constexpr uint8_t F1 = 0x70, F13 = 0x7C;
+        inline constexpr uint8_t NumLock = 0x90, Scroll = 0x91;
+        inline constexpr uint8_t LShift = 0xA0, RShift = 0xA1, LControl = 0xA2, RControl = 0xA3, LMenu = 0xA4, RMenu = 0xA5;
+        inline constexpr uint8_t Oem1 = 0xBA, OemPlus = 0xBB, OemComma = 0xBC, OemMinus = 0xBD, OemPeriod = 0xBE, Oem2 = 0xBF, Oem3 = 0xC0;
+        inline constexpr uint8_t Oem4 = 0xDB, Oem5 = 0xDC, Oem6 = 0xDD, Oem7 = 0xDE, Oem102 = 0xE2;
+
+        // Windows has no separate VK for keypad Enter; 0x0E is unassigned, so it stands in for it
+        inline constexpr uint8_t KeypadEnter = 0x0E;
+    }
+
+    // US-layout defaults. Keys in the main character block are refreshed per keyboard layout.
+    inline constexpr std::array<uint8_t, 256> kScanCodeToVK = [] {
+        std::array<uint8_t, 256> t{};
+        t[0x01] = VK::Escape;
+        for (int i = 0; i < 9; i++) t[0x02 + i] = static_cast<uint8_t>('1' + i);
+        t[0x0B] = VK::Key0;
+        t[0x0C] = VK::OemMinus;
+        t[0x0D] = VK::OemPlus;
+        t[0x0E] = VK::Back;
+        t[0x0F] = VK::Tab;
+        const char row1[] = "QWERTYUIOP";
+        for (int i = 0; i < 10; i++) t[0x10 + i] = static_cast<uint8_t>(row1[i]);
+        t[0x1A] = VK::Oem4;
+        t[0x1B] = VK::Oem6;
+        t[0x1C] = VK::Return;
+        t[0x1D] = VK::LControl;
+        const char row2[] = "ASDFGHJKL";
+        for (int i = 0; i < 9; i++) t[0x1E + i] = static_cast<uint8_t>(row2[i]);
+        t[0x27] = VK::Oem1;
+        t[0x28] = VK::Oem7;
+        t[0x29] = VK::Oem3;
+        t[0x2A] = VK::LShift;
+        t[0x2B] = VK::Oem5;
+        const char row3[] = "ZXCVBNM";
+        for (int i = 0; i < 7; i++) t[0x2C + i] = static_cast<uint8_t>(row3[i]);
+        t[0x33] = VK::OemComma;
+        t[0x34] = VK::OemPeriod;
+        t[0x35] = VK::Oem2;
+        t[0x36] = VK::RShift;
+        t[0x37] = VK::Multiply;
+        t[0x38] = VK::LMenu;
+        t[0x39] = VK::Space;
+        t[0x3A] = VK::Capital;
+        for (int i = 0; i < 10; i++) t[0x3B + i] = static_cast<uint8_t>(VK::F1 + i);
+        t[0x45] = VK::NumLock;
+        t[0x46] = VK::Scroll;
+        t[0x47] = VK::Numpad0 + 7;
+        t[0x48] = VK::Numpad0 + 8;
+        t[0x49] = VK::Numpad0 + 9;
+        t[0x4A] = VK::Subtract;
+        t[0x4B] = VK::Numpad0 + 4;
+        t[0x4C] = VK::Numpad0 + 5;
+        t[0x4D] = VK::Numpad0 + 6;
+        t[0x4E] = VK::Add;
+        t[0x4F] = VK::Numpad0 + 1;
+        t[0x50] = VK::Numpad0 + 2;
+        t[0x51] = VK::Numpad0 + 3;
+        t[0x52] = VK::Numpad0;
+        t[0x53] = VK::Decimal;
+        t[0x56] = VK::Oem102;
+        t[0x57] = VK::F1 + 10;
+        t[0x58] = VK::F1 + 11;
+        for (int i = 0; i < 3; i++) t[0x64 + i] = static_cast<uint8_t>(VK::F13 + i);
+        // 0x80 and up are E0-prefixed (extended) keys
+        t[0x9C] = VK::KeypadEnter;
+        t[0x9D] = VK::RControl;
+        t[0xB5] = VK::Divide;
+        t[0xB7] = VK::Snapshot;
+        t[0xB8] = VK::RMenu;
+        t[0xC5] = VK::Pause;
+        t[0xC7] = VK::Home;
+        t[0xC8] = VK::Up;
+        t[0xC9] = VK::Prior;
+        t[0xCB] = VK::Left;
+        t[0xCD] = VK::Right;
+        t[0xCF] = VK::End;
+        t[0xD0] = VK::Down;
+        t[0xD1] = VK::Next;
+        t[0xD2] = VK::Insert;
+        t[0xD3] = VK::Delete;
+        t[0xDB] = VK::LWin;
+        t[0xDC] = VK::RWin;
+        t[0xDD] = VK::Apps;
+        return t;
+    }();
+
+    // Character keys whose VK depends on the active keyboard layout
+    inline constexpr bool IsLayoutDependent(uint32_t scanCode) {
+        return (scanCode >= 0x02 && scanCode <= 0x0D) || (scanCode >= 0x10 && scanCode <= 0x1B) ||
+               (scanCode >= 0x1E && scanCode <= 0x29) || (scanCode >= 0x2B && scanCode <= 0x35) ||
+               scanCode == 0x56;
+    }
+
+    // The other side of a left/right modifier pair
+    inline constexpr std::array<uint8_t, 256> kModifierSibling = [] {
+        std::array<uint8_t, 256> t{};
+        t[VK::LShift] = VK::RShift;
+        t[VK::RShift] = VK::LShift;
+        t[VK::LControl] = VK::RControl;
+        t[VK::RControl] = VK::LControl;
+        t[VK::LMenu] = VK::RMenu;
+        t[VK::RMenu] = VK::LMenu;
+        t[VK::LWin] = VK::RWin;
+        t[VK::RWin] = VK::LWin;
+        return t;
+    }();
+
+    // Skyrim mouse button IDs: 0-7 buttons, 8/9 wheel up/down
+    inline constexpr uint32_t kMouseWheelUp = 8;
+    inline constexpr uint32_t kMouseWheelDown = 9;
+    inline constexpr std::array<int8_t, 8> kMouseButtonToImGui = { 0, 1, 2, 3, 4, -1, -1, -1 };
+}
+
+// Scan code -> VK table for the current keyboard layout. Translating an event is one load
+// here plus one load from kVKToImGuiKey; the layout part is only rebuilt when it changes.
+class KeyTranslator {
+    public:
+        uint8_t ToVirtualKey(uint32_t scanCode) const {
+            return scanCode < scanToVK.size() ? scanToVK[scanCode] : 0;
+        }
+
+        // mapScanCode(scanCode) returns the layout's VK for a character key, or 0 to keep the default
+        template <class MapFn>
+        bool RefreshLayout(uintptr_t layoutId, MapFn&& mapScanCode) {
+            if (layoutId == currentLayout) return false;
+
+            currentLayout = layoutId;
+            scanToVK = KeyTables::kScanCodeToVK;
+            for (uint32_t scanCode = 0; scanCode < 0x80; scanCode++) {
+                if (!KeyTables::IsLayoutDependent(scanCode)) continue;
+                if (const uint32_t vk = mapScanCode(scanCode); vk != 0 && vk < 256) {
+                    scanToVK[scanCode] = static_cast<uint8_t>(vk);
+                }
+            }
+            return true;
+        }
+
+    private:
+        std::array<uint8_t, 256> scanToVK = KeyTables::kScanCodeToVK;
+        uintptr_t currentLayout = 0;
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// Read-only memory mapping of a whole file, unmapped on destruction. Move-only; moving keeps the
+// mapped address, so spans into GetData() stay valid across a move.
+class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // False for a missing, empty or unreadable file
+        bool Open(const std::filesystem::path& path);
+        void Close();
+
+        bool IsOpen() const { return data != nullptr; }
+        const std::byte* GetData() const { return data; }
+        std::size_t GetSize() const { return size; }
+
+    private:
+        const std::byte* data = nullptr;
+        std::size_t size = 0;
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include "MarkerProjection.h"
+
+#include "RE/Skyrim.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+// Optional icons over interactables around the player. The game thread gathers and classifies
+// everything in range a few times a second and hands the set over; the render thread culls and
+// projects it against the camera every frame and draws all markers as one batch.
+class MarkerOverlayUI {
+    public:
+        struct Stats {
+            uint32_t gathered = 0;      // In the last set handed over
+            uint32_t visible = 0;       // On screen last frame
+            uint64_t gathers = 0;
+            int64_t lastGatherNs = 0;
+            int64_t lastProjectNs = 0;
+        };
+
+        static MarkerOverlayUI* GetSingleton() {
+            static MarkerOverlayUI singleton;
+            return &singleton;
+        }
+
+        // At kDataLoaded; registers the layer. Nothing is gathered while Markers.Enabled is off.
+        bool Init();
+        bool IsInitialized() const { return initialized; }
+
+        // Render thread, once per Present: asks for a gather when one is due, picks up a new set
+        // and projects it
+        void SyncWithGame();
+
+        Stats GetStats() const;
+
+    private:
+        MarkerOverlayUI() = default;
+
+        void Gather();  // Game thread
+        void Draw();
+
+        const Markers::ScreenMarkers& GetScreen() const { return screens[screenIndex]; }
+
+        bool initialized = false;
+
+        // Game thread
+        Markers::MarkerSet gathering;
+
+        // Game -> render handoff; the lock is taken only when the version moved
+        std::mutex publishMutex;
+        Markers::MarkerSet published;
+        std::atomic<uint32_t> publishedVersion = 0;
+        std::atomic<bool> gatherPending = false;
+
+        // Render thread
+        Markers::MarkerSet markers;
+        uint32_t markersVersion = 0;
+        // Last frame's projection and the one before, to tell whether the overlay needs redrawing
+        std::array<Markers::ScreenMarkers, 2> screens;
+        uint32_t screenIndex = 0;
+        int64_t lastGatherRequestNs = 0;
+
+        std::atomic<uint32_t> gathered = 0;
+        std::atomic<uint32_t> visible = 0;
+        std::atomic<uint64_t> gathers = 0;
+        std::atomic<int64_t> lastGatherNs = 0;
+        std::atomic<int64_t> lastProjectNs = 0;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include "InteractionClassifier.h"
+#include <array>
+#include <cstdint>
+#include <optional>
+
+// World-space markers over interactables near the player, and the per-frame frustum cull and
+// world-to-screen projection that places them. Positions are kept as structure of arrays so the
+// projection handles four markers per SSE instruction. Platform-neutral; the plugin gathers the
+// markers from the game and draws them, the bench runs the same projection over a synthetic scene.
+namespace Markers {
+    enum class Kind : uint8_t {
+        kCorpse,    // Dead actor that can be searched
+        kHarvest,   // Flora or tree; gatherers drop those with no produce item
+        kLocked     // Locked container or door
+    };
+    inline constexpr std::size_t kKindCount = 3;
+
+    const char* KindName(Kind kind);
+
+    // Which marker a target gets, if any. Unlike ClassifyInteraction this needs the lock state of
+    // containers as well as doors, and whether an NPC is dead (an actor's base is its TESNPC), so
+    // gatherers fill those in.
+    std::optional<Kind> Classify(const TargetFacts& facts);
+
+    // Kept a multiple of the SIMD width
+    inline constexpr uint32_t kMaxMarkers = 1024;
+
+    struct MarkerSet {
+        alignas(16) std::array<float, kMaxMarkers> x{};
+        alignas(16) std::array<float, kMaxMarkers> y{};
+        alignas(16) std::array<float, kMaxMarkers> z{};
+        std::array<uint32_t, kMaxMarkers> formID{};
+        std::array<Kind, kMaxMarkers> kind{};
+        uint32_t count = 0;
+
+        // False once full
+        bool Add(uint32_t id, Kind markerKind, float worldX, float worldY, float worldZ);
+        void Clear() { count = 0; }
+    };
+
+    struct Camera {
+        // Row-major; rows 0 to 3 give clip x, y, z and w of (x, y, z, 1), as in NiCamera::worldToCam
+        std::array<float, 16> worldToClip{};
+        float positionX = 0.0f;
+        float positionY = 0.0f;
+        float positionZ = 0.0f;
+        float screenWidth = 0.0f;
+        float screenHeight = 0.0f;
+    };
+
+    // Markers that survived culling, in pixels with y down
+    struct ScreenMarkers {
+        alignas(16) std::array<float, kMaxMarkers> x{};
+        alignas(16) std::array<float, kMaxMarkers> y{};
+        alignas(16) std::array<float, kMaxMarkers> distance{};  // Fraction of the radius, 0 to 1
+        std::array<uint16_t, kMaxMarkers> source{};             // Index into the MarkerSet
+        uint32_t count = 0;
+    };
+
+    // Drops markers behind the camera, outside the view or beyond radius, and projects the rest
+    // in their original order. SSE2 unless built with DCF_MARKERS_NO_SIMD.
+    uint32_t Project(const MarkerSet& markers, const Camera& camera, float radius, ScreenMarkers& out);
+    // One marker at a time; same results, kept as the reference and for the bench
+    uint32_t ProjectScalar(const MarkerSet& markers, const Camera& camera, float radius, ScreenMarkers& out);
+}
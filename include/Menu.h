@@ -1,14 +1,16 @@
 #pragma once
 
+#include "ImGuiKeyTables.h"
+#include "SPSCQueue.h"
+#include "Settings.h"
 #include "imgui.h"
-#include "imgui_impl_dx11.h"
-#include "imgui_impl_win32.h"
 #include "imgui_internal.h"
-#include <d3d11.h>
 #ifndef DIRECTINPUT_VERSION
 #	define DIRECTINPUT_VERSION 0x0800
 #endif
 #include <dinput.h>
+#include <atomic>
+#include <bitset>
 
 class Menu {
     public:
@@ -24,30 +26,34 @@ class Menu {
         bool Init();
         void DrawMenu();
         
-        // Crosshair source options
-        enum class CrosshairSource {
-            Images,
-            IconFont,
-            WebIconPack
-        };
-        CrosshairSource currentSource = CrosshairSource::Images;
+        // Crosshair source options; the current one lives in Settings
+        using CrosshairSource = Settings::CrosshairSource;
 
-        void ProcessInputEvents(RE::InputEvent* const* a_event);
+        void ProcessInputEvents(RE::InputEvent* const* a_event); // Input thread (producer)
         bool ShouldSwallowInput();
-        void ProcessInputEventQueue(); // Moved to public
+        void ProcessInputEventQueue(); // Present thread (consumer)
+        // Present thread. Input is queued before Init, so the first toggle key press can build the menu.
+        bool HasQueuedInput() const { return _keyEventQueue.Size() > 0; }
+        void DiscardQueuedInput() { _keyEventQueue.Drain([](const KeyEvent&) {}); }
+
+        uint64_t GetDroppedInputEvents() const { return _keyEventQueue.GetOverflowCount(); }
+        uint64_t GetFilteredInputEvents() const { return _filteredEvents.load(std::memory_order_relaxed); }
 
-        uint32_t toggleKey = VK_F10;
-        bool menuToggle = false; // Added to track menu visibility
+        bool showLatencyOverlay = false; // Present thread only
+        std::atomic<bool> menuToggle = false; // Written on the Present thread, read on the input thread
 
     private:
     
         Menu() = default;
 
-        ID3D11Device* d3d_device = nullptr;
-        ID3D11DeviceContext* d3d_context = nullptr;
-
         const char* KeyIdToString(uint32_t a_keyId);
-        const ImGuiKey VirtualKeyToImGuiKey(WPARAM vkKey);
+        void DrawMemoryStats();
+        void DrawTracing();
+        void DrawLatency();
+        void DrawLatencyOverlay();
+        void DrawScheduler();
+        void DrawHooks();
+        int traceSeconds = 5;
 
         class CharEvent : public RE::InputEvent {
             public:
@@ -55,6 +61,8 @@ class Menu {
         };
 
         struct KeyEvent {
+            KeyEvent() = default;
+
             explicit KeyEvent(const RE::ButtonEvent* a_event) :
                 keyCode(a_event->GetIDCode()),
                 device(a_event->GetDevice()),
@@ -73,13 +81,21 @@ class Menu {
             [[nodiscard]] constexpr bool IsHeld() const noexcept { return IsPressed() && IsRepeating(); }
             [[nodiscard]] constexpr bool IsUp() const noexcept { return (value == 0.0F) && IsRepeating(); }
 
-            uint32_t keyCode;
-            RE::INPUT_DEVICE device;
-            RE::INPUT_EVENT_TYPE eventType;
+            uint32_t keyCode = 0;
+            uint8_t virtualKey = 0; // Keyboard only, translated on the input thread
+            RE::INPUT_DEVICE device = RE::INPUT_DEVICE::kNone;
+            RE::INPUT_EVENT_TYPE eventType = RE::INPUT_EVENT_TYPE::kButton;
             float value = 0;
             float heldDownSecs = 0;
         };
-        const uint32_t DIKToVK(uint32_t DIK);
-        std::vector<KeyEvent> _keyEventQueue{};
-        void addToEventQueue(KeyEvent e);
+        KeyTranslator keyTranslator;    // Input thread only
+        std::bitset<256> keysDown;      // Present thread only, by virtual key
+        bool IsToggleKeyEvent(const KeyEvent& e) const;
+        void AddKeyboardEvent(ImGuiIO& io, const KeyEvent& e);
+        void AddMouseEvent(ImGuiIO& io, const KeyEvent& e);
+
+        // Input thread -> Present thread. Sized for several frames of typing at a low frame rate.
+        SPSCQueue<KeyEvent, 256> _keyEventQueue;
+        std::atomic<uint64_t> _filteredEvents = 0; // Dropped at the producer while the menu is closed
+        void addToEventQueue(const KeyEvent& e);
 };
\ No newline at end of file
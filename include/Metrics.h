@@ -0,0 +1,32 @@
+#pragma once
+#include "CrosshairMonitor.h"
+#include "LatencyHistogram.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+
+// Target-to-pixel latency and crosshair counters. The latency is measured from the
+// CrosshairRefEvent that changed the interaction type to the end of the first Present that
+// draws the new crosshair.
+namespace Metrics {
+    // Game thread
+    void CountInteractionChange(CrosshairMonitor::InteractionType type);
+
+    // Render thread: the change is pending from SyncWithMonitor until the frame that shows it is presented
+    void BeginPresentLatency(int64_t eventTimeNs);
+    // Returns true if a sample was recorded
+    bool EndPresentLatency();
+
+    // Render thread only
+    const LatencyHistogram& GetPresentLatency();
+    void ResetPresentLatency();
+
+    uint64_t GetInteractionChangeCount(CrosshairMonitor::InteractionType type);
+
+    void SetOutputDirectory(const std::filesystem::path& directory);
+    // Render thread. Writes every counter as metric,value rows and returns false on failure.
+    bool DumpCsv(std::filesystem::path& writtenPath);
+
+    // steady_clock nanoseconds, comparable across threads
+    int64_t NowNs();
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "ScriptEvents.h"
+
+// Papyrus side of the crosshair state (scripts/DCF_Crosshair.psc). The getters return what the
+// monitor already published, so a script never re-classifies the target or waits for a frame.
+// OnCrosshairInteractionChanged goes only to registered scripts, at most once per frame; the
+// registrations are saved with the game.
+namespace PapyrusBridge {
+    // At SKSEPlugin_Load: natives and the save/load callbacks
+    bool Init();
+
+    // Game thread, for every crosshair change; cheap when no script is registered and never
+    // allocates. True when the caller must call ScheduleFlush once it is free to allocate.
+    bool OnInteractionChanged(uint32_t formID, InteractionType type);
+    // Game thread; queues the flush for later in this frame through the game scheduler
+    void ScheduleFlush();
+
+    InteractionEventBatcher::Stats GetStats();
+}
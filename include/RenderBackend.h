@@ -0,0 +1,19 @@
+#pragma once
+#include "imgui.h"
+#include <cstdint>
+
+// Renderer underneath UIRenderer. Consumes ImGui draw data and owns the textures it samples.
+// Texture pixels are tightly packed, premultiplied BGRA8 (the layout WIC's 32bppPBGRA produces).
+class RenderBackend {
+    public:
+        virtual ~RenderBackend() = default;
+
+        virtual bool Init() = 0;
+        virtual void Shutdown() = 0;
+        virtual void NewFrame() = 0;
+        virtual void RenderDrawData(ImDrawData* drawData) = 0;
+        virtual ImVec2 GetDisplaySize() const = 0;
+
+        virtual ImTextureID CreateTexture(uint32_t width, uint32_t height, const uint8_t* pixels) = 0;
+        virtual void ReleaseTexture(ImTextureID texture) = 0;
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity, lock-free single-producer/single-consumer ring buffer.
+// Never allocates; a push into a full queue fails and is counted as an overflow.
+template <class T, std::size_t Capacity>
+class SPSCQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SPSCQueue capacity must be a power of two");
+
+    public:
+        static constexpr std::size_t kCapacity = Capacity;
+
+        // Producer thread only
+        bool TryPush(const T& item) {
+            const std::size_t currentTail = tail.load(std::memory_order_relaxed);
+            if (currentTail - cachedHead >= Capacity) {
+                cachedHead = head.load(std::memory_order_acquire);
+                if (currentTail - cachedHead >= Capacity) {
+                    overflowCount.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+            buffer[currentTail & kMask] = item;
+            tail.store(currentTail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer thread only
+        bool TryPop(T& item) {
+            const std::size_t currentHead = head.load(std::memory_order_relaxed);
+            if (currentHead == cachedTail) {
+                cachedTail = tail.load(std::memory_order_acquire);
+                if (currentHead == cachedTail) {
+                    return false;
+                }
+            }
+            item = buffer[currentHead & kMask];
+            head.store(currentHead + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer thread only. Hands every queued item to fn and releases the slots in one store.
+        template <class F>
+        std::size_t Drain(F&& fn) {
+            const std::size_t currentHead = head.load(std::memory_order_relaxed);
+            cachedTail = tail.load(std::memory_order_acquire);
+            for (std::size_t i = currentHead; i != cachedTail; i++) {
+                fn(buffer[i & kMask]);
+            }
+            head.store(cachedTail, std::memory_order_release);
+            return cachedTail - currentHead;
+        }
+
+        // Approximate when called from a thread that is neither producer nor consumer
+        std::size_t Size() const {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        uint64_t GetOverflowCount() const { return overflowCount.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr std::size_t kMask = Capacity - 1;
+        static constexpr std::size_t kCacheLine = 64;
+
+        // Producer and consumer state live on separate cache lines to avoid false sharing
+        alignas(kCacheLine) std::atomic<std::size_t> head{ 0 };
+        std::size_t cachedTail = 0;
+
+        alignas(kCacheLine) std::atomic<std::size_t> tail{ 0 };
+        std::size_t cachedHead = 0;
+        std::atomic<uint64_t> overflowCount{ 0 };
+
+        alignas(kCacheLine) std::array<T, Capacity> buffer{};
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include "Allocator.h"
+#include "InteractionClassifier.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// One OnCrosshairInteractionChanged event, after coalescing
+struct InteractionEvent {
+    uint32_t formID = 0;                                // Target now; 0 when nothing is targeted
+    InteractionType type = InteractionType::kNone;
+    InteractionType previousType = InteractionType::kNone; // Type before the first change folded in
+    uint32_t changes = 0;                               // Raw changes folded into this event
+};
+
+// The part of a script VM that event batching talks to. The plugin implements it over Papyrus;
+// the benchmarks use a stand-in, so the dispatch path can be measured off-game.
+class ScriptVM {
+    public:
+        using Handle = uint64_t;    // RE::VMHandle of a registered script object
+
+        virtual ~ScriptVM() = default;
+
+        // Queues the event on every handle. Game thread, once per flushed batch.
+        virtual void SendInteractionChanged(const Handle* handles, std::size_t count, const InteractionEvent& event) = 0;
+};
+
+// Coalesces crosshair changes into at most one script event per frame. OnChange runs for every
+// change on the game thread and only records the latest state; Flush, run once later in the same
+// thread's frame, sends the net change to registered scripts. With nobody registered, OnChange
+// is two stores and a load. A batch whose changes cancel out (A -> B -> A) sends nothing.
+class InteractionEventBatcher {
+    public:
+        struct Stats {
+            uint32_t registrations = 0;
+            uint64_t changes = 0;       // Changes seen while anyone was registered
+            uint64_t batches = 0;       // Flushes that sent an event
+            uint64_t events = 0;        // Events queued, i.e. batches times registrations
+            uint64_t cancelled = 0;     // Batches that netted out to no change
+        };
+
+        // Any thread (script natives run on VM threads). False if already (or not) registered.
+        bool Register(ScriptVM::Handle handle);
+        bool Unregister(ScriptVM::Handle handle);
+        void Clear();
+        uint32_t GetRegistrationCount() const { return registrationCount.load(std::memory_order_relaxed); }
+
+        // Visits registrations under the lock, for saving and releasing them
+        template <class F>
+        void ForEachRegistration(F&& visit) const {
+            std::lock_guard lock(mutex);
+            for (const auto handle : handles) {
+                visit(handle);
+            }
+        }
+
+        // Game thread. Never allocates. True when the caller must schedule a Flush this frame.
+        bool OnChange(uint32_t formID, InteractionType type);
+        // Game thread. Returns the number of events queued.
+        uint32_t Flush(ScriptVM& vm);
+
+        Stats GetStats() const;
+
+    private:
+        // Registrations, sorted; guarded by mutex
+        mutable std::mutex mutex;
+        Memory::Vector<ScriptVM::Handle, Memory::Tag::kMonitor> handles;
+        std::atomic<uint32_t> registrationCount = 0;
+
+        // Game thread only
+        uint32_t lastFormID = 0;
+        InteractionType lastType = InteractionType::kNone;
+        bool batchOpen = false;
+        bool flushQueued = false;
+        uint32_t batchStartFormID = 0;
+        InteractionEvent pending;
+
+        std::atomic<uint64_t> changes = 0;
+        std::atomic<uint64_t> batches = 0;
+        std::atomic<uint64_t> events = 0;
+        std::atomic<uint64_t> cancelled = 0;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include "InplaceFunction.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// User settings, parsed once from DynamicCrosshairFramework.ini into a flat struct. Readers on
+// any thread get the current snapshot with one atomic load; changes publish a new snapshot and
+// swap the pointer (RCU-style), so no reader ever takes a lock or looks up a key by name.
+namespace Settings {
+    enum class CrosshairSource : uint8_t {
+        Images,
+        IconFont,
+        WebIconPack
+    };
+    inline constexpr std::size_t kCrosshairSourceCount = 3;
+
+    const char* CrosshairSourceName(CrosshairSource source);
+
+    struct Snapshot {
+        uint32_t toggleKey = 0x79;      // Virtual-key code; VK_F10
+        float crosshairSize = 32.0f;    // Pixels
+        CrosshairSource crosshairSource = CrosshairSource::Images;
+        uint32_t transitionMs = 150;    // Crosshair change animation; 0 switches instantly
+        bool infoCardsEnabled = true;   // Value, weight, lock and owner under the crosshair
+        bool markersEnabled = false;    // Icons over nearby corpses, harvestables and locked containers
+        float markerRadius = 3072.0f;   // Game units around the player
+        uint32_t frameBudgetUs = 1000;  // Base FrameScheduler budget for deferred work
+
+        // Features the hooks dispatch to; a disabled one drops out of the per-frame path
+        bool overlayEnabled = true;
+        bool menuEnabled = true;
+        bool tracingEnabled = true;
+
+        uint32_t generation = 0;        // Bumped by every Publish; compare to notice changes
+    };
+
+    // Starts from defaults. Unknown keys and malformed values are skipped and described in
+    // warnings, one line each.
+    Snapshot Parse(std::string_view text, std::vector<std::string>& warnings);
+    std::string Serialize(const Snapshot& snapshot);
+
+    // Any thread, lock-free. A snapshot is freed no sooner than kGracePeriodMs after it was
+    // replaced, so read fields straight away, or copy the snapshot (it is small) where the code
+    // goes on to Update or holds it for longer.
+    const Snapshot& Get();
+    inline constexpr uint32_t kGracePeriodMs = 1000;
+
+    // Any thread; writers are serialized. Publish ignores the incoming generation.
+    void Publish(const Snapshot& snapshot);
+    // Copies the current snapshot, applies edit and publishes the result as one write
+    void Update(const InplaceFunction<void(Snapshot&), 32>& edit);
+
+    // Any thread. Frees replaced snapshots whose grace period is over; Publish does the same, this
+    // is for the periodic tick, so the last snapshots of a burst of edits do not wait for the next one.
+    // Returns how many are still waiting.
+    std::size_t Reclaim();
+}
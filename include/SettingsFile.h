@@ -0,0 +1,15 @@
+#pragma once
+#include "Settings.h"
+#include <filesystem>
+
+// Keeps Settings in sync with DynamicCrosshairFramework.ini. A background thread polls the
+// file's write time and publishes a fresh snapshot when it changes, and writes the current
+// snapshot back once menu edits have settled, so neither parsing nor disk I/O happens on a frame.
+namespace SettingsFile {
+    // Loads the file (writing defaults if it does not exist) and starts the watcher
+    bool Init(const std::filesystem::path& path);
+    void Shutdown();
+
+    // Any thread; call after Settings::Update. Bursts (a slider drag) are written once.
+    void RequestSave();
+}
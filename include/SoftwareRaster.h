@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// CPU triangle rasterizer underneath SoftwareRenderBackend: edge-function triangle setup, 4-wide
+// SSE2 span filling, nearest-neighbour sampling and premultiplied "over" blending into an RGBA8
+// framebuffer. No ImGui, Windows or game dependencies, so golden images and fill benchmarks run
+// on Linux; the backend feeds it ImGui draw data.
+namespace Raster {
+    // Mirrors ImDrawVert: position in pixels, normalized texture coordinates, and a straight-alpha
+    // colour packed like IM_COL32 (R in the low byte)
+    struct Vertex {
+        float x, y;
+        float u, v;
+        uint32_t color;
+    };
+
+    struct ClipRect {
+        int x0, y0, x1, y1; // Half-open pixel range
+    };
+
+    struct Texture {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint32_t> pixels; // Premultiplied RGBA8, packed like the framebuffer
+    };
+
+    // Straight-alpha channels to a premultiplied pixel
+    uint32_t Premultiply(uint32_t r, uint32_t g, uint32_t b, uint32_t a);
+
+    class Framebuffer {
+        public:
+            Framebuffer() = default;
+            Framebuffer(uint32_t width, uint32_t height) { Resize(width, height); }
+
+            void Resize(uint32_t width, uint32_t height);
+            void Clear(uint32_t rgba = 0);
+
+            // Either winding; a pixel centre on an edge shared by two triangles is filled once
+            void FillTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2, const Texture& texture, const ClipRect& clip);
+            // An indexed triangle list, as one ImDrawCmd describes it
+            void FillTriangles(const Vertex* vertices, const uint16_t* indices, std::size_t indexCount, const Texture& texture, const ClipRect& clip);
+
+            // Pixels are packed like IM_COL32 (R in the low byte), rows GetStride() apart
+            uint32_t GetWidth() const { return width; }
+            uint32_t GetHeight() const { return height; }
+            uint32_t GetStride() const { return stride; }
+            const uint32_t* GetPixels() const { return pixels.data(); }
+            ClipRect GetBounds() const { return { 0, 0, static_cast<int>(width), static_cast<int>(height) }; }
+            bool WriteTGA(const char* path) const;
+
+        private:
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t stride = 0; // Rounded up to 4 pixels so SIMD spans never straddle two rows
+            std::vector<uint32_t> pixels;
+    };
+
+    // Reads back what Framebuffer::WriteTGA writes (uncompressed, 32 bpp, top-left origin), into
+    // tightly packed rows; false for anything else
+    bool ReadTGA(const char* path, uint32_t& width, uint32_t& height, std::vector<uint32_t>& pixels);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "RenderBackend.h"
+#include "SoftwareRaster.h"
+#include <cstdint>
+#include <vector>
+
+// ImGui draw data through the CPU rasterizer (SoftwareRaster.h), into a premultiplied RGBA8
+// framebuffer, so UI frames can be produced without a GPU (golden images, CPU-side benchmarks).
+// Has no Windows or game dependencies; built with the headless ImGui target.
+class SoftwareRenderBackend : public RenderBackend {
+    public:
+        SoftwareRenderBackend(uint32_t width, uint32_t height);
+
+        bool Init() override;
+        void Shutdown() override;
+        void NewFrame() override;
+        void RenderDrawData(ImDrawData* drawData) override;
+        ImVec2 GetDisplaySize() const override;
+
+        ImTextureID CreateTexture(uint32_t width, uint32_t height, const uint8_t* pixels) override;
+        void ReleaseTexture(ImTextureID texture) override;
+
+        void Resize(uint32_t width, uint32_t height);
+        void Clear(uint32_t rgba = 0);
+
+        // Framebuffer pixels are packed like IM_COL32 (R in the low byte), rows GetStride() apart
+        uint32_t GetWidth() const { return framebuffer.GetWidth(); }
+        uint32_t GetHeight() const { return framebuffer.GetHeight(); }
+        uint32_t GetStride() const { return framebuffer.GetStride(); }
+        const uint32_t* GetPixels() const { return framebuffer.GetPixels(); }
+        bool WriteTGA(const char* path) const { return framebuffer.WriteTGA(path); }
+
+    private:
+        bool initialized = false;
+        Raster::Framebuffer framebuffer;
+
+        std::vector<Raster::Texture> textures; // ImTextureID is index + 1
+        ImTextureID fontTexture{};
+
+        const Raster::Texture* LookupTexture(ImTextureID id) const;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// Named startup phases and their wall time, logged as each one ends. Blocking phases run while
+// the game is loading and add directly to its load time; deferred ones (first menu open,
+// background asset loading) run later and are totalled separately, so the log shows what the
+// plugin costs the loading screen.
+namespace StartupProfiler {
+    enum class Kind : uint8_t {
+        kBlocking,
+        kDeferred
+    };
+
+    struct Phase {
+        const char* name = nullptr;     // String literal
+        Kind kind = Kind::kBlocking;
+        int64_t startNs = 0;            // Metrics::NowNs() time
+        int64_t durationNs = 0;
+    };
+    inline constexpr uint32_t kMaxPhases = 32;
+
+    // Any thread. Phases past kMaxPhases are logged but not kept.
+    void Record(const char* name, Kind kind, int64_t startNs, int64_t durationNs);
+
+    // Copies the recorded phases in the order they ended
+    uint32_t GetPhases(std::array<Phase, kMaxPhases>& out);
+    int64_t GetTotalNs(Kind kind);
+
+    // One line with both totals
+    void LogSummary();
+
+    // Records a phase from construction to destruction
+    class Scope {
+        public:
+            explicit Scope(const char* name, Kind kind = Kind::kBlocking);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            const char* name;
+            Kind kind;
+            int64_t startNs;
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "WorldView.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// In-memory WorldView for running the classifier without the game: benchmarks, the replay
+// tool's synthetic mode, and anything else that wants thousands of targets on Linux.
+class SyntheticWorld {
+    public:
+        struct Object {
+            uint32_t formID = 0;
+            bool hasBase = true;
+            uint8_t baseType = 0;   // Raw FormType, see BaseType
+            LockInfo lock;
+            bool dead = false;
+        };
+        using Target = const Object*;
+
+        // Object pointers stay valid until the next Add/Populate/Clear
+        Object& Add(uint8_t baseType);
+        Object& Add(BaseType baseType) { return Add(static_cast<uint8_t>(baseType)); }
+        // Appends count objects with a fixed, seed-determined mix of every classified base type
+        // plus some unclassified ones; identical across platforms for a given seed
+        void Populate(std::size_t count, uint64_t seed);
+        void Clear();
+
+        std::size_t GetObjectCount() const { return objects.size(); }
+        Target GetObject(std::size_t index) const { return &objects[index]; }
+
+        void SetPlayerSneaking(bool sneaking) { playerSneaking = sneaking; }
+        void SetPlayerItemCount(uint32_t itemFormID, int32_t count);
+
+        // WorldView
+        uint32_t GetFormID(Target object) const { return object->formID; }
+        std::optional<uint8_t> GetBaseType(Target object) const {
+            if (!object->hasBase) return std::nullopt;
+            return object->baseType;
+        }
+        LockInfo GetLockInfo(Target object) const { return object->lock; }
+        bool IsDead(Target object) const { return object->dead; }
+        bool IsPlayerSneaking() const { return playerSneaking; }
+        int32_t GetPlayerItemCount(uint32_t itemFormID) const {
+            for (const auto& [formID, count] : inventory) {
+                if (formID == itemFormID) return count;
+            }
+            return 0;
+        }
+
+    private:
+        static constexpr uint32_t kFirstFormID = 0xFF000800;  // Dynamic range, as spawned refs get
+
+        std::vector<Object> objects;
+        std::vector<std::pair<uint32_t, int32_t>> inventory;  // A handful of entries at most
+        bool playerSneaking = false;
+        uint32_t nextFormID = kFirstFormID;
+};
+static_assert(WorldView<SyntheticWorld>);
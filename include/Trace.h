@@ -0,0 +1,66 @@
+#pragma once
+#include "BinaryLog.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Scoped hot-path tracing. Outside a capture a TRACE_SCOPE costs one relaxed load; during a
+// capture it records begin/end ticks into the calling thread's ring. StartCapture records for
+// N seconds, then writes a Chrome trace JSON (chrome://tracing, ui.perfetto.dev) into the
+// output directory from a background thread.
+//
+// Define DCF_DISABLE_TRACING to compile every TRACE_SCOPE out.
+namespace Trace {
+    enum class State : uint8_t {
+        kIdle,
+        kCapturing,
+        kWriting
+    };
+
+    void SetOutputDirectory(const std::filesystem::path& directory);
+
+    // Fails if a capture is already running or no output directory is set
+    bool StartCapture(float seconds);
+    State GetState();
+    // Path of the last trace written, empty if none
+    std::string GetLastCapturePath();
+
+    // Shown on the thread's track in the trace; name must outlive the capture (a literal)
+    void SetThreadName(const char* name);
+
+    namespace detail {
+        inline std::atomic<bool> capturing{ false };
+
+        void Record(const char* name, uint64_t begin, uint64_t end);
+    }
+
+    class Scope {
+        public:
+            explicit Scope(const char* name) :
+                name(name),
+                begin(detail::capturing.load(std::memory_order_relaxed) ? BinaryLog::Now() : 0) {}
+
+            ~Scope() {
+                if (begin) {
+                    detail::Record(name, begin, BinaryLog::Now());
+                }
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            const char* name;
+            uint64_t begin;
+    };
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if defined(DCF_DISABLE_TRACING)
+#define TRACE_SCOPE(name) ((void)0)
+#else
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+#endif
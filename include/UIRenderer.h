@@ -0,0 +1,73 @@
+#pragma once
+#include "Allocator.h"
+#include "RenderBackend.h"
+#include "imgui.h"
+#include <chrono>
+#include <memory>
+
+// Owns the single ImGui context shared by the crosshair overlay and the config menu,
+// and runs exactly one ImGui frame per Present. Each UI component submits into that
+// frame as a layer.
+//
+// While nothing visible has changed, the last frame's draw lists are replayed instead of
+// building a new ImGui frame. Components call Invalidate() when their visual state changes.
+class UIRenderer {
+    public:
+        struct Layer {
+            const char* name;
+            bool (*isActive)();   // Checked before the frame is built; inactive layers cost nothing
+            void (*draw)();
+            bool interactive = false; // Rebuilt every frame while active (reads input)
+            Memory::Tag allocationTag = Memory::Tag::kImGui;  // Counts what ImGui allocates while this layer draws
+        };
+
+        struct FrameStats {
+            float lastFrameMs = 0.0f;
+            float avgFrameMs = 0.0f;  // Exponential moving average
+            float maxFrameMs = 0.0f;
+            uint64_t frameCount = 0;
+            uint64_t replayedFrames = 0;
+            uint64_t rebuiltFrames = 0;
+            uint64_t heapCallsLastFrame = 0; // Plugin allocations that reached the process heap
+        };
+
+        static UIRenderer* GetSingleton() {
+            static UIRenderer singleton;
+            return &singleton;
+        };
+
+        bool Init();                                          // In-game, on the DX11 backend
+        bool Init(std::unique_ptr<RenderBackend> renderBackend);
+        void Shutdown();
+        void RegisterLayer(const Layer& layer);
+        void Render();
+        void Invalidate() { dirty = true; }
+
+        bool IsInitialized() const { return initialized; }
+        RenderBackend* GetBackend() const { return backend.get(); }
+        const FrameStats& GetFrameStats() const { return frameStats; }
+
+    private:
+        UIRenderer() = default;
+
+        bool initialized = false;
+        std::unique_ptr<RenderBackend> backend;
+
+        Memory::Vector<Layer, Memory::Tag::kUI> layers;
+        FrameStats frameStats;
+        Memory::Tag imguiAllocationTag = Memory::Tag::kImGui;   // Render thread; read by ImGui's allocator hook
+
+        // Replay cache
+        bool dirty = true;
+        uint32_t lastActiveLayers = 0;
+        ImVec2 lastDisplaySize;
+        ImDrawData cachedDrawData;
+        Memory::Vector<ImDrawList*, Memory::Tag::kUI> cachedDrawLists;   // Owned, reused frame to frame
+        uint64_t heapCallsAtFrameStart = 0;
+
+        uint32_t GetActiveLayers(bool& interactive) const;
+        void BuildFrame(uint32_t activeLayers, bool interactive);
+        void CacheDrawData(const ImDrawData* drawData);
+        void ClearCachedDrawData();
+        void RecordFrameTime(std::chrono::steady_clock::time_point start, bool replayed);
+};
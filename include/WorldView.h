@@ -0,0 +1,70 @@
+#pragma once
+#include "InteractionClassifier.h"
+#include <concepts>
+#include <cstdint>
+#include <optional>
+
+// The narrow read-only slice of the world classification needs. GameWorldView answers from the
+// live game (Windows only); SyntheticWorld answers from memory so the classifier can be built,
+// profiled and exercised at scale on Linux. Views are small value types with inline accessors,
+// so GatherFacts/ClassifyInteraction below compile down to direct calls for either one.
+
+struct LockInfo {
+    bool locked = false;
+    LockLevel level = LockLevel::kUnlocked;
+};
+
+// Skyrim.esm's Lockpick misc item
+inline constexpr uint32_t kLockpickFormID = 0x0000000A;
+
+template <class View>
+concept WorldView = requires(const View& view, typename View::Target target, uint32_t itemFormID) {
+    // Target is a nullable handle (a pointer in both implementations); null means no target
+    { target == nullptr } -> std::convertible_to<bool>;
+    { view.GetFormID(target) } -> std::convertible_to<uint32_t>;
+    // Raw FormType of the target's base object, or nullopt if it has none
+    { view.GetBaseType(target) } -> std::same_as<std::optional<uint8_t>>;
+    { view.GetLockInfo(target) } -> std::same_as<LockInfo>;
+    { view.IsDead(target) } -> std::convertible_to<bool>;
+    { view.IsPlayerSneaking() } -> std::convertible_to<bool>;
+    { view.GetPlayerItemCount(itemFormID) } -> std::convertible_to<int32_t>;
+};
+
+// Reads only the facts ClassifyInteraction will look at for this target's base type
+template <WorldView View>
+TargetFacts GatherFacts(const View& world, typename View::Target target) {
+    TargetFacts facts;
+    if (target == nullptr) return facts;
+
+    facts.hasRef = true;
+    facts.formID = world.GetFormID(target);
+
+    const auto baseType = world.GetBaseType(target);
+    if (!baseType) return facts;
+
+    facts.hasBase = true;
+    facts.baseType = *baseType;
+
+    if (facts.Is(BaseType::kDoor)) {
+        const LockInfo lock = world.GetLockInfo(target);
+        facts.locked = lock.locked;
+        if (lock.locked) {
+            facts.lockLevel = lock.level;
+        }
+    }
+    if (facts.NeedsDeadState()) {
+        facts.dead = world.IsDead(target);
+    }
+    if (facts.NeedsSneakState()) {
+        facts.playerSneaking = world.IsPlayerSneaking();
+    }
+    if (facts.NeedsLockpickCount()) {
+        facts.lockpickCount = world.GetPlayerItemCount(kLockpickFormID);
+    }
+    return facts;
+}
+
+template <WorldView View>
+InteractionType ClassifyInteraction(const View& world, typename View::Target target) {
+    return ClassifyInteraction(GatherFacts(world, target));
+}
@@ -0,0 +1,358 @@
+#include "Allocator.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Memory {
+    namespace {
+        // Precedes every block so Free() needs only the pointer (ImGui's free callback has no size)
+        struct alignas(kPoolAlignment) Header {
+            uint32_t size;
+            uint8_t tag;
+            uint8_t sizeClass;
+            uint32_t offset;    // kAlignedClass only: bytes back to the start of the real block
+        };
+        static_assert(sizeof(Header) == kPoolAlignment);
+
+        constexpr std::array<std::size_t, 9> kClassSizes = { 16, 32, 64, 128, 256, 512, 1024, 2048, kMaxPooledSize };
+        constexpr uint8_t kLargeClass = 0xFF;
+        constexpr uint8_t kAlignedClass = 0xFE;   // Header in front of an over-aligned address
+        constexpr std::size_t kChunkSize = 64 * 1024;
+
+        class SpinLock {
+            public:
+                void lock() {
+                    while (flag.test_and_set(std::memory_order_acquire)) {
+                        while (flag.test(std::memory_order_relaxed)) {}
+                    }
+                }
+                void unlock() { flag.clear(std::memory_order_release); }
+
+            private:
+                std::atomic_flag flag;
+        };
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        // Chunks are never handed back to the heap; the pools keep the plugin's high-water mark
+        struct SizeClassPool {
+            SpinLock lock;
+            FreeBlock* freeList = nullptr;
+        };
+
+        std::array<SizeClassPool, kClassSizes.size()> pools;
+        std::array<TagStats, static_cast<std::size_t>(Tag::kCount)> tagStats;
+        std::array<GpuStats, static_cast<std::size_t>(Tag::kCount)> gpuStats;
+        std::atomic<uint64_t> heapCalls{ 0 };
+        std::atomic<int64_t> poolReservedBytes{ 0 };
+        thread_local uint64_t threadAllocations = 0;
+
+        void AbortOnViolation(const char* scope, uint64_t allocations) {
+            std::fprintf(stderr, "%llu allocation(s) inside no-allocation scope '%s'\n", static_cast<unsigned long long>(allocations), scope);
+            std::abort();
+        }
+
+        std::atomic<AllocationViolationHandler> violationHandler{ AbortOnViolation };
+
+        uint8_t SizeClassFor(std::size_t size) {
+            for (uint8_t i = 0; i < kClassSizes.size(); i++) {
+                if (size <= kClassSizes[i]) return i;
+            }
+            return kLargeClass;
+        }
+
+        // Called with the pool locked
+        bool Refill(SizeClassPool& pool, std::size_t blockSize) {
+            auto* chunk = static_cast<std::byte*>(std::malloc(kChunkSize));
+            heapCalls.fetch_add(1, std::memory_order_relaxed);
+            if (!chunk) return false;
+            poolReservedBytes.fetch_add(static_cast<int64_t>(kChunkSize), std::memory_order_relaxed);
+
+            for (std::size_t offset = 0; offset + blockSize <= kChunkSize; offset += blockSize) {
+                auto* block = reinterpret_cast<FreeBlock*>(chunk + offset);
+                block->next = pool.freeList;
+                pool.freeList = block;
+            }
+            return true;
+        }
+
+        TagStats& StatsFor(uint8_t tag) {
+            return tagStats[tag < tagStats.size() ? tag : static_cast<std::size_t>(Tag::kOther)];
+        }
+
+        GpuStats& GpuStatsFor(Tag tag) {
+            const auto index = static_cast<std::size_t>(tag);
+            return gpuStats[index < gpuStats.size() ? index : static_cast<std::size_t>(Tag::kOther)];
+        }
+
+        // Relaxed max; a racing reader may see a peak one update late, never one that did not happen
+        void RaisePeak(std::atomic<int64_t>& peak, int64_t value) {
+            int64_t current = peak.load(std::memory_order_relaxed);
+            while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+
+        // A pool block (or a heap one past kMaxPooledSize) with the header in front, counted under tag
+        void* AllocateBlock(std::size_t size, Tag tag) {
+            threadAllocations++;
+            const uint8_t sizeClass = SizeClassFor(size);
+
+            void* block = nullptr;
+            if (sizeClass == kLargeClass) {
+                block = std::malloc(sizeof(Header) + size);
+                heapCalls.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                auto& pool = pools[sizeClass];
+                pool.lock.lock();
+                if (pool.freeList || Refill(pool, sizeof(Header) + kClassSizes[sizeClass])) {
+                    block = pool.freeList;
+                    pool.freeList = pool.freeList->next;
+                }
+                pool.lock.unlock();
+            }
+            if (!block) return nullptr;
+
+            auto* header = static_cast<Header*>(block);
+            header->size = static_cast<uint32_t>(size);
+            header->tag = static_cast<uint8_t>(tag);
+            header->sizeClass = sizeClass;
+
+            auto& stats = StatsFor(header->tag);
+            const int64_t bytes = stats.bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+            RaisePeak(stats.peakBytes, bytes);
+            stats.allocations.fetch_add(1, std::memory_order_relaxed);
+            return header + 1;
+        }
+    }
+
+    const char* TagName(Tag tag) {
+        switch (tag) {
+            case Tag::kMonitor:  return "Monitor";
+            case Tag::kUI:       return "UI";
+            case Tag::kMenu:     return "Menu";
+            case Tag::kImGui:    return "ImGui";
+            case Tag::kTextures: return "Textures";
+            case Tag::kLogging:  return "Logging";
+            case Tag::kJobs:     return "Jobs";
+            case Tag::kSettings: return "Settings";
+            default:             return "Other";
+        }
+    }
+
+    void* Allocate(std::size_t size, Tag tag, std::size_t alignment) {
+        if (alignment <= kPoolAlignment) return AllocateBlock(size, tag);
+
+        // Rounded up inside a larger block, leaving room for a header that leads Free back to it
+        auto* block = static_cast<std::byte*>(AllocateBlock(size + alignment, tag));
+        if (!block) return nullptr;
+        const auto start = reinterpret_cast<std::uintptr_t>(block);
+        const std::uintptr_t address = (start + sizeof(Header) + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+        auto* header = reinterpret_cast<Header*>(address) - 1;
+        header->sizeClass = kAlignedClass;
+        header->offset = static_cast<uint32_t>(address - start);
+        return reinterpret_cast<void*>(address);
+    }
+
+    void Free(void* ptr) {
+        if (!ptr) return;
+
+        auto* header = static_cast<Header*>(ptr) - 1;
+        if (header->sizeClass == kAlignedClass) {
+            ptr = static_cast<std::byte*>(ptr) - header->offset;
+            header = static_cast<Header*>(ptr) - 1;
+        }
+        auto& stats = StatsFor(header->tag);
+        stats.bytes.fetch_sub(static_cast<int64_t>(header->size), std::memory_order_relaxed);
+        stats.frees.fetch_add(1, std::memory_order_relaxed);
+
+        if (header->sizeClass == kLargeClass) {
+            std::free(header);
+            heapCalls.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto& pool = pools[header->sizeClass];
+        auto* block = reinterpret_cast<FreeBlock*>(header);
+        pool.lock.lock();
+        block->next = pool.freeList;
+        pool.freeList = block;
+        pool.lock.unlock();
+    }
+
+    const TagStats& GetStats(Tag tag) {
+        return StatsFor(static_cast<uint8_t>(tag));
+    }
+
+    void TrackGpuAllocation(Tag tag, int64_t bytes) {
+        auto& stats = GpuStatsFor(tag);
+        RaisePeak(stats.peakBytes, stats.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+        stats.resources.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TrackGpuFree(Tag tag, int64_t bytes) {
+        auto& stats = GpuStatsFor(tag);
+        stats.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+        stats.resources.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    const GpuStats& GetGpuStats(Tag tag) {
+        return GpuStatsFor(tag);
+    }
+
+    int64_t GetPoolReservedBytes() {
+        return poolReservedBytes.load(std::memory_order_relaxed);
+    }
+
+    void ResetPeaks() {
+        for (auto& stats : tagStats) {
+            stats.peakBytes.store(stats.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        for (auto& stats : gpuStats) {
+            stats.peakBytes.store(stats.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t GetHeapCallCount() {
+        return heapCalls.load(std::memory_order_relaxed);
+    }
+
+    FrameArena::FrameArena(std::size_t capacity) :
+        buffer(static_cast<std::byte*>(std::malloc(capacity))),
+        capacity(buffer ? capacity : 0) {
+        heapCalls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    FrameArena::~FrameArena() {
+        Reset();
+        std::free(buffer);
+    }
+
+    void* FrameArena::Allocate(std::size_t size, std::size_t alignment) {
+        const std::size_t aligned = (used + alignment - 1) & ~(alignment - 1);
+        if (aligned + size <= capacity) {
+            used = aligned + size;
+            highWater = (std::max)(highWater, used);
+            return buffer + aligned;
+        }
+
+        // Oversized frame: keep going from the pools, chained so Reset can release them
+        overflowCount++;
+        const std::size_t headerSize = (sizeof(Overflow) + alignment - 1) & ~(alignment - 1);
+        auto* overflow = static_cast<Overflow*>(Memory::Allocate(headerSize + size, Tag::kOther, alignment));
+        if (!overflow) return nullptr;
+        overflow->next = overflowList;
+        overflowList = overflow;
+        return reinterpret_cast<std::byte*>(overflow) + headerSize;
+    }
+
+    void FrameArena::Reset() {
+        while (overflowList) {
+            Overflow* next = overflowList->next;
+            Memory::Free(overflowList);
+            overflowList = next;
+        }
+        used = 0;
+    }
+
+    FrameArena& GetFrameArena() {
+        static FrameArena arena(256 * 1024);
+        return arena;
+    }
+
+    uint64_t GetThreadAllocationCount() {
+        return threadAllocations;
+    }
+
+    void SetAllocationViolationHandler(AllocationViolationHandler handler) {
+        violationHandler.store(handler ? handler : AbortOnViolation, std::memory_order_relaxed);
+    }
+
+#if defined(DCF_COUNT_ALLOCATIONS)
+    NoAllocationScope::~NoAllocationScope() {
+        const uint64_t allocations = GetThreadAllocationCount() - start;
+        if (allocations != 0) {
+            violationHandler.load(std::memory_order_relaxed)(name, allocations);
+        }
+    }
+#endif
+}
+
+#if defined(DCF_COUNT_ALLOCATIONS)
+// Counting replacements for the global allocation functions (the nothrow forms forward to
+// these). Test and bench builds only: the game build keeps the CRT's allocator.
+void* operator new(std::size_t size) {
+    Memory::threadAllocations++;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+// Over-aligned types (alignas above the default new alignment) take these instead
+namespace {
+    void* AlignedAllocate(std::size_t size, std::align_val_t alignment) {
+        const auto align = static_cast<std::size_t>(alignment);
+        // aligned_alloc wants a whole number of alignments
+        const std::size_t rounded = (std::max)((size + align - 1) & ~(align - 1), align);
+#if defined(_MSC_VER)
+        return _aligned_malloc(rounded, align);
+#else
+        return std::aligned_alloc(align, rounded);
+#endif
+    }
+
+    void AlignedFree(void* ptr) {
+#if defined(_MSC_VER)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    Memory::threadAllocations++;
+    if (void* ptr = AlignedAllocate(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    AlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    AlignedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    AlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    AlignedFree(ptr);
+}
+#endif
@@ -0,0 +1,275 @@
+#include "BinaryLog.h"
+#include "Allocator.h"
+#include "SPSCQueue.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace BinaryLog {
+    namespace {
+        using namespace BinaryLogFormat;
+
+        constexpr std::size_t kMaxFormats = 1024;
+        constexpr std::size_t kMaxThreads = 32;
+        constexpr std::size_t kRingCapacity = 512;  // 64 KB per logging thread
+        constexpr auto kDrainInterval = std::chrono::milliseconds(20);
+
+        struct FormatEntry {
+            Level level;
+            uint32_t line;
+            const char* file;
+            const char* format;
+            const char* signature;
+
+            // Rate limiting state, shared by every thread hitting this call site
+            std::atomic<uint64_t> windowStart{ 0 };
+            std::atomic<uint32_t> windowCount{ 0 };
+            std::atomic<uint32_t> suppressed{ 0 };
+        };
+
+        struct ThreadRing {
+            uint16_t threadIndex;
+            SPSCQueue<Record, kRingCapacity> queue;
+        };
+
+        std::array<FormatEntry, kMaxFormats> formats;
+        std::atomic<uint32_t> formatCount{ 0 };
+        std::mutex registerMutex;
+
+        // Rings are created on a thread's first record and live until Shutdown
+        std::array<std::atomic<ThreadRing*>, kMaxThreads> rings;
+        std::atomic<uint32_t> ringCount{ 0 };   // Never above kMaxThreads, so readers can index by it
+        thread_local ThreadRing* threadRing = nullptr;
+        thread_local bool threadOutOfRings = false; // Every slot was taken when this thread first logged
+
+        std::atomic<uint64_t> windowTicks{ 1'000'000'000 };
+        std::atomic<uint64_t> droppedRecords{ 0 };
+        std::atomic<uint64_t> suppressedRecords{ 0 };   // Totalled by the drain thread
+
+        std::FILE* file = nullptr;
+        // Never destroyed: Shutdown is not called at process exit, and ~thread on a joinable thread terminates
+        std::thread& drainThread = *new std::thread;
+        std::mutex drainMutex;
+        std::condition_variable drainWake;
+        bool stopRequested = false;
+
+        // Drain thread only
+        using Buffer = Memory::Vector<uint8_t, Memory::Tag::kLogging>;
+        uint32_t formatsWritten = 0;
+        Buffer formatChunks;
+        Buffer recordChunks;
+
+        template <class T>
+        void Append(Buffer& out, T value) {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        void AppendBytes(Buffer& out, const void* data, std::size_t size) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+        template <class LengthType>
+        void AppendString(Buffer& out, const char* text) {
+            const std::size_t length = (std::min)(std::strlen(text), static_cast<std::size_t>(static_cast<LengthType>(~LengthType{ 0 })));
+            Append(out, static_cast<LengthType>(length));
+            AppendBytes(out, text, length);
+        }
+
+        uint64_t MeasureTicksPerSecond() {
+            const auto wallStart = std::chrono::steady_clock::now();
+            const uint64_t tickStart = Now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            const uint64_t tickEnd = Now();
+            const auto wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wallStart).count();
+            return wallNs > 0 ? static_cast<uint64_t>((tickEnd - tickStart) * 1e9 / static_cast<double>(wallNs)) : 1'000'000'000;
+        }
+
+        void DrainOnce() {
+            formatChunks.clear();
+            recordChunks.clear();
+
+            const uint32_t threads = ringCount.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < threads; i++) {
+                ThreadRing* ring = rings[i].load(std::memory_order_acquire);
+                if (!ring) continue;
+                ring->queue.Drain([&](const Record& record) {
+                    Append(recordChunks, ChunkKind::kRecord);
+                    Append(recordChunks, record.ticks);
+                    Append(recordChunks, ring->threadIndex);
+                    Append(recordChunks, record.formatId);
+                    Append(recordChunks, record.size);
+                    AppendBytes(recordChunks, record.payload, record.size);
+                });
+            }
+
+            // Snapshot the format table after draining: every record above was registered before it
+            // was pushed, so its format is covered and gets written ahead of it
+            const uint32_t registered = formatCount.load(std::memory_order_acquire);
+            for (; formatsWritten < registered; formatsWritten++) {
+                const FormatEntry& entry = formats[formatsWritten];
+                Append(formatChunks, ChunkKind::kFormat);
+                Append(formatChunks, static_cast<uint16_t>(formatsWritten));
+                Append(formatChunks, entry.level);
+                Append(formatChunks, entry.line);
+                AppendString<uint16_t>(formatChunks, entry.format);
+                AppendString<uint8_t>(formatChunks, entry.signature);
+                AppendString<uint16_t>(formatChunks, entry.file);
+            }
+
+            const uint64_t now = Now();
+            for (uint32_t id = 0; id < formatsWritten; id++) {
+                if (const uint32_t count = formats[id].suppressed.exchange(0, std::memory_order_relaxed)) {
+                    suppressedRecords.fetch_add(count, std::memory_order_relaxed);
+                    Append(recordChunks, ChunkKind::kSuppressed);
+                    Append(recordChunks, now);
+                    Append(recordChunks, static_cast<uint16_t>(id));
+                    Append(recordChunks, count);
+                }
+            }
+
+            if (formatChunks.empty() && recordChunks.empty()) return;
+            std::fwrite(formatChunks.data(), 1, formatChunks.size(), file);
+            std::fwrite(recordChunks.data(), 1, recordChunks.size(), file);
+            std::fflush(file);
+        }
+
+        void DrainLoop(uint64_t startTicks, int64_t startUnixNs) {
+            const uint64_t ticksPerSecond = MeasureTicksPerSecond();
+            windowTicks.store(ticksPerSecond, std::memory_order_relaxed);
+
+            FileHeader header{};
+            std::memcpy(header.magic, kMagic, sizeof(kMagic));
+            header.version = kVersion;
+            header.ticksPerSecond = ticksPerSecond;
+            header.startTicks = startTicks;
+            header.startUnixNs = startUnixNs;
+            std::fwrite(&header, sizeof(header), 1, file);
+
+            std::unique_lock lock(drainMutex);
+            while (!stopRequested) {
+                drainWake.wait_for(lock, kDrainInterval);
+                lock.unlock();
+                DrainOnce();
+                lock.lock();
+            }
+            lock.unlock();
+            DrainOnce();
+        }
+    }
+
+    bool Init(const std::filesystem::path& path, Level minLevel) {
+        if (file) return true;
+
+        file = std::fopen(path.string().c_str(), "wb");
+        if (!file) return false;
+
+        const uint64_t startTicks = Now();
+        const int64_t startUnixNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        stopRequested = false;
+        drainThread = std::thread(DrainLoop, startTicks, startUnixNs);
+        detail::minLevel.store(minLevel, std::memory_order_relaxed);
+        return true;
+    }
+
+    void Shutdown() {
+        if (!file) return;
+
+        detail::minLevel.store(Level::kOff, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(drainMutex);
+            stopRequested = true;
+        }
+        drainWake.notify_one();
+        if (drainThread.joinable()) {
+            drainThread.join();
+        }
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    void SetMinLevel(Level level) {
+        if (file) {
+            detail::minLevel.store(level, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t GetDroppedRecords() {
+        uint64_t dropped = droppedRecords.load(std::memory_order_relaxed);
+        const uint32_t threads = ringCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < threads; i++) {
+            if (ThreadRing* ring = rings[i].load(std::memory_order_acquire)) {
+                dropped += ring->queue.GetOverflowCount();
+            }
+        }
+        return dropped;
+    }
+
+    uint64_t GetSuppressedRecords() {
+        return suppressedRecords.load(std::memory_order_relaxed);
+    }
+
+    namespace detail {
+        uint16_t Register(Level level, const char* file, uint32_t line, const char* format, const char* signature) {
+            std::lock_guard lock(registerMutex);
+            const uint32_t id = formatCount.load(std::memory_order_relaxed);
+            if (id >= kMaxFormats) return kInvalidFormat;
+
+            FormatEntry& entry = formats[id];
+            entry.level = level;
+            entry.line = line;
+            entry.file = file;
+            entry.format = format;
+            entry.signature = signature;
+            formatCount.store(id + 1, std::memory_order_release);
+            return static_cast<uint16_t>(id);
+        }
+
+        bool Admit(uint16_t formatId, uint64_t ticks) {
+            FormatEntry& entry = formats[formatId];
+            if (ticks - entry.windowStart.load(std::memory_order_relaxed) >= windowTicks.load(std::memory_order_relaxed)) {
+                entry.windowStart.store(ticks, std::memory_order_relaxed);
+                entry.windowCount.store(1, std::memory_order_relaxed);
+                return true;
+            }
+            // Plain load first so a site that is already over its budget skips the locked increment
+            if (entry.windowCount.load(std::memory_order_relaxed) < kMaxRecordsPerSecond &&
+                entry.windowCount.fetch_add(1, std::memory_order_relaxed) < kMaxRecordsPerSecond) {
+                return true;
+            }
+            entry.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Claims the next slot only while one is free; a bare increment would let the drain
+        // thread read past the array until the failed claim was rolled back
+        bool ReserveRingSlot(uint32_t& index) {
+            uint32_t count = ringCount.load(std::memory_order_relaxed);
+            do {
+                if (count >= kMaxThreads) return false;
+            } while (!ringCount.compare_exchange_weak(count, count + 1, std::memory_order_relaxed));
+            index = count;
+            return true;
+        }
+
+        void Push(const Record& record) {
+            if (!threadRing) {
+                uint32_t index = 0;
+                if (threadOutOfRings || !ReserveRingSlot(index)) {
+                    threadOutOfRings = true;
+                    droppedRecords.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                threadRing = Memory::New<ThreadRing>(Memory::Tag::kLogging);
+                threadRing->threadIndex = static_cast<uint16_t>(index);
+                rings[index].store(threadRing, std::memory_order_release);
+            }
+            threadRing->queue.TryPush(record);
+        }
+    }
+}
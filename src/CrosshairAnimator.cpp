@@ -0,0 +1,197 @@
+#include "CrosshairAnimator.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace {
+    using Easing = CrosshairAnimator::Easing;
+    constexpr uint32_t kLutSize = CrosshairAnimator::kLutSize;
+    constexpr float kPi = 3.14159265358979f;
+    constexpr float kCostSmoothing = 0.1f;
+
+    // kLutSize + 1 samples per curve, so the last interval has an upper end at x = 1
+    using Curve = std::array<float, kLutSize + 1>;
+
+    float EvaluateCurve(Easing easing, float x) {
+        switch (easing) {
+            case Easing::kOutCubic:  return 1.0f - (1.0f - x) * (1.0f - x) * (1.0f - x);
+            case Easing::kInOutQuad: return x < 0.5f ? 2.0f * x * x : 1.0f - 2.0f * (1.0f - x) * (1.0f - x);
+            case Easing::kPulse:     return std::sin(kPi * x);
+            case Easing::kWiggle:    return std::sin(6.0f * kPi * x) * (1.0f - x);
+            default:                 return x;
+        }
+    }
+
+    const std::array<Curve, CrosshairAnimator::kEasingCount> kCurves = [] {
+        std::array<Curve, CrosshairAnimator::kEasingCount> curves{};
+        for (std::size_t e = 0; e < curves.size(); e++) {
+            for (uint32_t i = 0; i <= kLutSize; i++) {
+                curves[e][i] = EvaluateCurve(static_cast<Easing>(e), static_cast<float>(i) / kLutSize);
+            }
+        }
+        // sinf(kPi) is not quite 0, and Retire adds additive layers' end value into the rest pose
+        curves[static_cast<std::size_t>(Easing::kPulse)][kLutSize] = 0.0f;
+        curves[static_cast<std::size_t>(Easing::kWiggle)][kLutSize] = 0.0f;
+        return curves;
+    }();
+}
+
+CrosshairAnimator::CrosshairAnimator() {
+    rest.values.fill(0.0f);
+    rest.values[static_cast<std::size_t>(Channel::kOpacity)] = 1.0f;
+    rest.values[static_cast<std::size_t>(Channel::kScale)] = 1.0f;
+    rest.values[static_cast<std::size_t>(Channel::kTintR)] = 1.0f;
+    rest.values[static_cast<std::size_t>(Channel::kTintG)] = 1.0f;
+    rest.values[static_cast<std::size_t>(Channel::kTintB)] = 1.0f;
+    previousStep = currentStep = pose = rest;
+}
+
+void CrosshairAnimator::SetRest(Channel target, float restValue) {
+    rest.values[static_cast<std::size_t>(target)] = restValue;
+    if (!activeMask) {
+        previousStep = currentStep = pose = rest;
+    }
+}
+
+uint32_t CrosshairAnimator::AcquireSlot(Channel target, Blend mode) {
+    if (mode == Blend::kSet) {
+        for (uint32_t mask = activeMask; mask; mask &= mask - 1) {
+            const auto slot = static_cast<uint32_t>(std::countr_zero(mask));
+            if (channel[slot] == target && blend[slot] == Blend::kSet) return slot;
+        }
+    }
+    return static_cast<uint32_t>(std::countr_zero(~activeMask));   // kMaxLayers when full
+}
+
+bool CrosshairAnimator::Start(Channel target, Easing curve, Blend mode, float fromValue, float toValue, float seconds) {
+    const uint32_t slot = AcquireSlot(target, mode);
+    if (slot >= kMaxLayers) {
+        stats.dropped++;
+        return false;
+    }
+
+    const auto steps = std::max(1u, static_cast<uint32_t>(std::lround(seconds / kStepSeconds)));
+    startTick[slot] = tick;
+    endTick[slot] = tick + steps;
+    invDuration[slot] = 1.0f / static_cast<float>(steps);
+    from[slot] = fromValue;
+    delta[slot] = toValue - fromValue;
+    easing[slot] = curve;
+    channel[slot] = target;
+    blend[slot] = mode;
+
+    activeMask |= 1u << slot;
+    stats.started++;
+    stats.activeLayers = static_cast<uint32_t>(std::popcount(activeMask));
+    return true;
+}
+
+void CrosshairAnimator::Crossfade(float seconds) {
+    // The outgoing crosshair fades from however visible the current one is right now
+    Start(Channel::kPreviousOpacity, Easing::kInOutQuad, Blend::kSet, pose.Get(Channel::kOpacity), 0.0f, seconds);
+    Start(Channel::kOpacity, Easing::kInOutQuad, Blend::kSet, 0.0f, 1.0f, seconds);
+}
+
+void CrosshairAnimator::Pulse(Channel target, float amplitude, float seconds) {
+    Start(target, Easing::kPulse, Blend::kAdd, 0.0f, amplitude, seconds);
+}
+
+void CrosshairAnimator::Wiggle(Channel target, float amplitude, float seconds) {
+    Start(target, Easing::kWiggle, Blend::kAdd, 0.0f, amplitude, seconds);
+}
+
+void CrosshairAnimator::TintTo(float r, float g, float b, float seconds) {
+    Start(Channel::kTintR, Easing::kOutCubic, Blend::kSet, pose.Get(Channel::kTintR), r, seconds);
+    Start(Channel::kTintG, Easing::kOutCubic, Blend::kSet, pose.Get(Channel::kTintG), g, seconds);
+    Start(Channel::kTintB, Easing::kOutCubic, Blend::kSet, pose.Get(Channel::kTintB), b, seconds);
+}
+
+void CrosshairAnimator::Evaluate(Pose& out) {
+    // Every slot, live or not, so the loops have no branches; a free slot has invDuration 0
+    for (uint32_t i = 0; i < kMaxLayers; i++) {
+        const auto elapsed = static_cast<float>(static_cast<int32_t>(tick - startTick[i]));
+        progress[i] = std::clamp(elapsed * invDuration[i], 0.0f, 1.0f);
+    }
+    for (uint32_t i = 0; i < kMaxLayers; i++) {
+        const Curve& curve = kCurves[static_cast<std::size_t>(easing[i])];
+        const float position = progress[i] * kLutSize;
+        const uint32_t index = std::min(static_cast<uint32_t>(position), kLutSize - 1);
+        const float eased = curve[index] + (curve[index + 1] - curve[index]) * (position - static_cast<float>(index));
+        value[i] = from[i] + delta[i] * eased;
+    }
+
+    // Compose: kSet layers first, then kAdd ones on top
+    out = rest;
+    for (uint32_t mask = activeMask; mask; mask &= mask - 1) {
+        const auto slot = static_cast<uint32_t>(std::countr_zero(mask));
+        if (blend[slot] == Blend::kSet) out.values[static_cast<std::size_t>(channel[slot])] = value[slot];
+    }
+    for (uint32_t mask = activeMask; mask; mask &= mask - 1) {
+        const auto slot = static_cast<uint32_t>(std::countr_zero(mask));
+        if (blend[slot] == Blend::kAdd) out.values[static_cast<std::size_t>(channel[slot])] += value[slot];
+    }
+}
+
+void CrosshairAnimator::Retire(uint32_t slot) {
+    // The final value becomes the rest value, so the channel stays where the layer left it
+    auto& restValue = rest.values[static_cast<std::size_t>(channel[slot])];
+    const Curve& curve = kCurves[static_cast<std::size_t>(easing[slot])];
+    const float finalValue = from[slot] + delta[slot] * curve[kLutSize];
+    restValue = blend[slot] == Blend::kSet ? finalValue : restValue + finalValue;
+
+    invDuration[slot] = 0.0f;
+    activeMask &= ~(1u << slot);
+}
+
+void CrosshairAnimator::Step() {
+    tick++;
+    previousStep = currentStep;
+    Evaluate(currentStep);
+
+    for (uint32_t mask = activeMask; mask; mask &= mask - 1) {
+        const auto slot = static_cast<uint32_t>(std::countr_zero(mask));
+        if (static_cast<int32_t>(tick - endTick[slot]) >= 0) Retire(slot);
+    }
+}
+
+void CrosshairAnimator::Advance(float elapsedSeconds) {
+    stats.lastSteps = 0;
+    if (!activeMask) {
+        stats.lastAdvanceNs = 0;
+        return;
+    }
+    const auto start = Clock::now();
+
+    accumulator += std::max(elapsedSeconds, 0.0f);
+    while (accumulator >= kStepSeconds && stats.lastSteps < kMaxStepsPerAdvance && activeMask) {
+        Step();
+        accumulator -= kStepSeconds;
+        stats.lastSteps++;
+    }
+
+    if (!activeMask) {
+        accumulator = 0.0f;
+        previousStep = currentStep = pose = rest;
+    } else {
+        accumulator = std::fmod(accumulator, kStepSeconds);
+        const float alpha = accumulator / kStepSeconds;
+        for (std::size_t i = 0; i < kChannelCount; i++) {
+            pose.values[i] = previousStep.values[i] + (currentStep.values[i] - previousStep.values[i]) * alpha;
+        }
+    }
+
+    const int64_t spent = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    stats.activeLayers = static_cast<uint32_t>(std::popcount(activeMask));
+    stats.lastAdvanceNs = spent;
+    stats.maxAdvanceNs = std::max(stats.maxAdvanceNs, spent);
+    stats.avgAdvanceNs = stats.avgAdvanceNs > 0.0f ? stats.avgAdvanceNs + (static_cast<float>(spent) - stats.avgAdvanceNs) * kCostSmoothing : static_cast<float>(spent);
+}
+
+void CrosshairAnimator::Reset() {
+    for (uint32_t mask = activeMask; mask; mask &= mask - 1) {
+        Retire(static_cast<uint32_t>(std::countr_zero(mask)));
+    }
+    accumulator = 0.0f;
+    previousStep = currentStep = pose = rest;
+    stats.activeLayers = 0;
+}
@@ -1,14 +1,26 @@
 #include "CrosshairMonitor.h"
+#include "BinaryLog.h"
+#include "Trace.h"
+#include "Metrics.h"
+#include "CrosshairTrace.h"
+#include "CrosshairStateBlock.h"
+#include "GameWorldView.h"
+#include "JobBridge.h"
+#include "PapyrusBridge.h"
+#include "InfoCardUI.h"
 #include "RE/C/CrosshairPickData.h"
 #include "RE/C/ConsoleLog.h"
 #include "RE/A/Actor.h"
 #include "RE/Skyrim.h"
+#include <array>
+#include <fmt/format.h>
 
 // Add logger namespace
 namespace logger = SKSE::log;
 
 void CrosshairMonitor::Init() {
-    lastCrosshairRef.reset();
+    Trace::SetThreadName("Main");
+    dispatcher.Reset();
     lastTarget.reset();
     lastTargetActor.reset();
 
@@ -23,86 +35,83 @@ void CrosshairMonitor::Init() {
 }
 
 RE::BSEventNotifyControl CrosshairMonitor::ProcessEvent(const SKSE::CrosshairRefEvent* a_event, RE::BSTEventSource<SKSE::CrosshairRefEvent>*) {
+    TRACE_SCOPE("CrosshairMonitor::ProcessEvent");
+    eventTimeNs = Metrics::NowNs();
     if (!a_event) { return RE::BSEventNotifyControl::kContinue; }
 
+    // A null target is a change too: the crosshair has to fall back to the default
     RE::TESObjectREFR* crosshairTarget = a_event->crosshairRef.get();
-    if (!crosshairTarget) { return RE::BSEventNotifyControl::kContinue; }
-    
-    // Process the reference change
-    ProcessReferenceChange(crosshairTarget);
-    
-    // Get interaction type for more detailed processing
-    CrosshairMonitor::InteractionType iType = GetInteractionTypeForRef(crosshairTarget);
-
-    switch (iType) {
-        case CrosshairMonitor::InteractionType::kTalk:
-            // Display talk crosshair TODO
-        case CrosshairMonitor::InteractionType::kOpen:
-            // Display open crosshair TODO
-        case CrosshairMonitor::InteractionType::kActivate:
-            // Display activate crosshair TODO
-        case CrosshairMonitor::InteractionType::kTake:
-            // Display take crosshair TODO
-        case CrosshairMonitor::InteractionType::kHarvest:
-            // Display harvest crosshair TODO
-        case CrosshairMonitor::InteractionType::kSearch:
-            // Display search crosshair TODO
-        case CrosshairMonitor::InteractionType::kSit:
-            // Display sit crosshair TODO
-        case CrosshairMonitor::InteractionType::kSleep:
-            // Display sleep crosshair TODO
-        case CrosshairMonitor::InteractionType::kPickpocket:
-            // Display pickpocket crosshair TODO
-        case CrosshairMonitor::InteractionType::kLockpick:
-            // Display lockpick crosshair TODO
-        case CrosshairMonitor::InteractionType::kLockpickNone:
-            // Display lockpick none crosshair TODO
-        case CrosshairMonitor::InteractionType::kRead:
-            // Display read crosshair TODO
-        case CrosshairMonitor::InteractionType::kDoor:
-            // Display door crosshair TODO
-        case CrosshairMonitor::InteractionType::kSteal:
-            // Display steal crosshair TODO
-        default: // and also kNone
-            // Display default crosshair TODO
-            break;
-    };
-    
+
+    // Classify once; the UI picks the crosshair up from the published interaction type
+    TargetFacts facts;
+    InteractionType interactionType;
+    {
+        TRACE_SCOPE("CrosshairMonitor::Classify");
+        facts = GatherFacts(crosshairTarget);
+        interactionType = ClassifyInteraction(facts);
+    }
+    CrosshairTrace::Recorder::GetSingleton()->Append(eventTimeNs, facts);
+    BLOG_TRACE("Crosshair target {:08X} -> interaction type {}", crosshairTarget ? crosshairTarget->GetFormID() : 0u, interactionType);
+    ProcessReferenceChange(crosshairTarget, interactionType, facts);
+
     return RE::BSEventNotifyControl::kContinue;
 }
 
 void CrosshairMonitor::ProcessReferenceChange(RE::TESObjectREFR* newRef) {
+    eventTimeNs = Metrics::NowNs();
+    const TargetFacts facts = GatherFacts(newRef);
+    ProcessReferenceChange(newRef, ClassifyInteraction(facts), facts);
+}
+
+void CrosshairMonitor::ProcessReferenceChange(RE::TESObjectREFR* newRef, InteractionType currentInteractionType, const TargetFacts& facts) {
     // Check if it's different from last reference
     RE::ObjectRefHandle currentHandle;
     if (newRef) {
         currentHandle = newRef->GetHandle();
     }
-    
-    // Detect changes in interaction type
-    auto currentInteractionType = GetInteractionTypeForRef(newRef);
-    
-    // If either the reference or the interaction type has changed
-    if (currentHandle != lastCrosshairRef || currentInteractionType != lastInteractionType) {
-        // Update tracking variables
-        lastCrosshairRef = currentHandle;
-        lastInteractionType = currentInteractionType;
-        
-        // Update the UI with the new crosshair information
-        /*auto* crosshairUI = CrosshairUI::GetSingleton();
-        if (crosshairUI) {
-            crosshairUI->UpdateCrosshairInfo(newRef);
-        }*/
-        
-        // Only proceed if we have a valid reference
-        if (newRef) {
-            // Write to console based on interaction type (keep for debugging)
-            PrintInteractionToConsole(newRef, currentInteractionType);
+
+    bool papyrusFlushDue = false;
+    {
+        // Everything from here to the end of callback dispatch runs on the game thread for every target change
+        Memory::NoAllocationScope noAllocations("CrosshairMonitor::ProcessReferenceChange");
+
+        const InteractionType previousType = dispatcher.GetLastType();
+
+        // If either the reference or the interaction type has changed
+        if (!dispatcher.Update(currentHandle.native_handle(), currentInteractionType)) return;
+
+        if (currentInteractionType != previousType) {
+            Metrics::CountInteractionChange(currentInteractionType);
         }
-        
+        // The timestamp is released together with the type
+        publishedChangeTimeNs.store(eventTimeNs, std::memory_order_relaxed);
+        publishedInteractionType.store(currentInteractionType, std::memory_order_release);
+        // Other plugins read the same change through the C ABI block
+        CrosshairStateBlock::Publish(facts, currentInteractionType, eventTimeNs);
+        // and scripts through a batched Papyrus event, if any registered
+        papyrusFlushDue = PapyrusBridge::OnInteractionChanged(facts.hasRef ? facts.formID : 0u, currentInteractionType);
+
         // Notify all registered callbacks
-        for (const auto& callback : callbacks) {
-            callback(newRef);
-        }
+        TRACE_SCOPE("CrosshairMonitor::DispatchCallbacks");
+        dispatcher.Dispatch(newRef);
+    }
+
+    // Posting reaches SKSE's task queue, which allocates, so it waits until the scope has closed
+    if (papyrusFlushDue) {
+        PapyrusBridge::ScheduleFlush();
+    }
+
+    // Card data comes from tables and a small cache; it only reads the game on a cache miss
+    InfoCardUI::GetSingleton()->OnTargetChanged(newRef);
+
+    // Console output (kept for debugging) is off the change path: it runs in a later slice of the
+    // game thread's frame budget, by which time the reference may be gone
+    if (newRef) {
+        JobBridge::Post(JobBridge::Target::kGame, [handle = currentHandle.native_handle(), currentInteractionType] {
+            if (const auto ref = RE::TESObjectREFR::LookupByHandle(handle)) {
+                PrintInteractionToConsole(ref.get(), currentInteractionType);
+            }
+        }, JobBridge::Priority::kBackground);
     }
 }
 
@@ -112,47 +121,7 @@ uint32_t CrosshairMonitor::GetActivationFlags() {
 }
 
 uint32_t CrosshairMonitor::GetActivationFlagsForRef(RE::TESObjectREFR* ref) {
-    if (!ref) return 0;
-    
-    // Since GetActivateFlags doesn't exist, we'll return a synthetic value
-    // based on the form type to simulate activation flags
-    auto* baseObj = ref->GetBaseObject();
-    if (!baseObj) return 0;
-    
-    uint32_t flags = 0;
-    
-    // Set synthetic flags based on form type
-    auto formType = baseObj->GetFormType();
-    
-    if (formType == RE::FormType::NPC) {
-        // Set talk flag for NPCs
-        flags |= 0x01;  // Talk flag
-        
-        // For hostility checking, we'd need to cast to Actor and use appropriate methods
-        // But for now, just use the NPC type
-    } 
-    if (formType == RE::FormType::Container) {
-        flags |= 0x02;  // Container flag
-    }
-    if (formType == RE::FormType::Door) {
-        flags |= 0x02;  // Use door flag (same as container)
-        if (ref->IsLocked()) {
-            flags |= 0x08;  // Unlock flag
-        }
-    }
-    if (formType == RE::FormType::Book) {
-        flags |= 0x04;  // Read flag
-    }
-    if (formType == RE::FormType::Furniture) {
-        flags |= 0x10;  // Use object (furniture) flag
-    }
-    if (formType == RE::FormType::Flora || 
-        formType == RE::FormType::Tree ||
-        formType == RE::FormType::Activator) {
-        flags |= 0x20;  // Harvest/Activate flag
-    }
-    
-    return flags;
+    return ::GetActivationFlags(GatherFacts(ref));
 }
 
 CrosshairMonitor::InteractionType CrosshairMonitor::GetInteractionType() {
@@ -183,167 +152,78 @@ RE::TESObjectREFR* CrosshairMonitor::GetCrosshairReference() {
     return nullptr;
 }
 
-void CrosshairMonitor::RegisterChangeCallback(CrosshairChangeCallback callback) {
-    callbacks.push_back(callback);
+bool CrosshairMonitor::RegisterChangeCallback(CrosshairChangeCallback callback) {
+    if (!dispatcher.Subscribe(std::move(callback))) {
+        logger::error("Crosshair change callback rejected; {} are already registered", dispatcher.GetSubscriberCount());
+        return false;
+    }
+    return true;
+}
+
+namespace {
+    // Interned console messages, indexed by InteractionType. The target name is appended unless
+    // appendName is false; a null prefix means nothing is printed.
+    struct MessageTemplate {
+        const char* prefix;
+        bool appendName;
+    };
+
+    constexpr MessageTemplate kUnknownInteraction{ "Unknown interaction with ", true };
+
+    constexpr std::array<MessageTemplate, 17> kMessageTemplates = {{
+        { nullptr, false },                       // kNone
+        { "You can talk to ", true },             // kTalk
+        { "You can open ", true },                // kOpen
+        { "You can activate ", true },            // kActivate
+        { "You can take ", true },                // kTake
+        { "You can harvest ", true },             // kHarvest
+        { "You can search ", true },              // kSearch
+        { "You can sit on ", true },              // kSit
+        { "You can sleep in ", true },            // kSleep
+        { "You can pickpocket ", true },          // kPickpocket
+        { "You can lockpick ", true },            // kLockpick
+        { "You are out of lockpicks", false },    // kLockpickNone
+        kUnknownInteraction,                      // kRequiresKey
+        kUnknownInteraction,                      // kUseKey
+        kUnknownInteraction,                      // kRead
+        kUnknownInteraction,                      // kDoor
+        kUnknownInteraction                       // kSteal
+    }};
+    static_assert(kMessageTemplates.size() == static_cast<std::size_t>(CrosshairMonitor::InteractionType::kSteal) + 1);
 }
 
 void CrosshairMonitor::PrintInteractionToConsole(RE::TESObjectREFR* ref, InteractionType type) {
     if (!ref) return;
-    
+
+    const auto index = static_cast<std::size_t>(type);
+    const MessageTemplate& message = index < kMessageTemplates.size() ? kMessageTemplates[index] : kUnknownInteraction;
+    if (!message.prefix) return;
+
     // Get the object name
-    std::string objName = ref->GetName();
-    if (objName.empty()) {
+    const char* objName = ref->GetName();
+    if (!objName || !*objName) {
         objName = "Unknown Object";
     }
-    
-    // Construct message based on interaction type
-    std::string message;
-    
-    switch (type) {
-        case InteractionType::kTalk:
-            message = "You can talk to " + objName;
-            break;
-            
-        case InteractionType::kOpen:
-            message = "You can open " + objName;
-            break;
-            
-        case InteractionType::kTake:
-            message = "You can take " + objName;
-            break;
-            
-        case InteractionType::kActivate:
-            message = "You can activate " + objName;
-            break;
-            
-        case InteractionType::kHarvest:
-            message = "You can harvest " + objName;
-            break;
-            
-        case InteractionType::kSearch:
-            message = "You can search " + objName;
-            break;
-            
-        case InteractionType::kSit:
-            message = "You can sit on " + objName;
-            break;
-            
-        case InteractionType::kSleep:
-            message = "You can sleep in " + objName;
-            break;
-            
-        case InteractionType::kPickpocket:
-            message = "You can pickpocket " + objName;
-            break;
-            
-        case InteractionType::kLockpick:
-            message = "You can lockpick " + objName;
-            break;
-        
-        case InteractionType::kLockpickNone:
-            message = "You are out of lockpicks";
-            break;
-            
-        case InteractionType::kNone:
-            // No interaction possible
-            return;
-            
-        default:
-            message = "Unknown interaction with " + objName;
-            break;
-    }
-    
-    // Print to console log instead of using Console::GetSingleton
-    RE::ConsoleLog::GetSingleton()->Print(message.c_str());
+
+    // Long names are truncated rather than spilling to the heap
+    char buffer[256];
+    auto result = message.appendName ?
+        fmt::format_to_n(buffer, sizeof(buffer) - 1, "{}{}", message.prefix, objName) :
+        fmt::format_to_n(buffer, sizeof(buffer) - 1, "{}", message.prefix);
+    *result.out = '\0';
+
+    // Print takes a printf-style format, so the name must not be passed as one
+    RE::ConsoleLog::GetSingleton()->Print("%s", buffer);
+}
+
+TargetFacts CrosshairMonitor::GatherFacts(RE::TESObjectREFR* ref) {
+    return ::GatherFacts(GameWorldView{}, ref);
 }
 
 // Get interaction type for a specific reference
 CrosshairMonitor::InteractionType CrosshairMonitor::GetInteractionTypeForRef(RE::TESObjectREFR* ref) {
-    if (!ref) { return InteractionType::kNone; }
-    
-    auto flags = GetActivationFlagsForRef(ref);
-    if (flags == 0) return InteractionType::kNone;
-    
-    // Check our synthetic activation flags
-    
-    // Talk flag (0x01)
-    if (flags & 0x01) {
-        if (ref && ref->GetBaseObject()->Is(RE::FormType::NPC)) {
-            // Check if sneaking for pickpocket
-            auto* player = RE::PlayerCharacter::GetSingleton();
-            if (player && player->IsSneaking()) {
-                return InteractionType::kPickpocket;
-            }
-            return InteractionType::kTalk;
-        }
-    }
-    
-    // Container/Door flag (0x02)
-    if (flags & 0x02) {
-        if (ref) {
-            auto* baseObj = ref->GetBaseObject();
-            if (baseObj) {
-                // Check if it's a dead body
-                if (baseObj->Is(RE::FormType::ActorCharacter) && ref->IsDead()) {
-                    return InteractionType::kSearch;
-                }
-                else if (baseObj->Is(RE::FormType::Door)) {
-                    // Check if door is locked.
-                    if (ref->IsLocked()) {
-                        // Get Lock Level
-                        auto lockLevel = ref->GetLockLevel();
-                        if (lockLevel == RE::LOCK_LEVEL::kRequiresKey) {
-                            // Check if player has key - for now just return open
-                            return InteractionType::kOpen;
-                        }
-                        // Check if between 0 and 4 (very easy to very hard)
-                        else if (lockLevel >= RE::LOCK_LEVEL::kVeryEasy && lockLevel <= RE::LOCK_LEVEL::kVeryHard) {
-                            // Check if player has lockpicks
-                            if (PlayerHasLockPicks()) {
-                                return InteractionType::kLockpick;
-                            }
-                            else {
-                                return InteractionType::kLockpickNone;
-                            }
-                        }
-                    }
-                    else {
-                        // Door is not locked, just open it
-                        return InteractionType::kOpen;
-                    }
-                }
-                // Otherwise normal open
-                return InteractionType::kOpen;
-            }
-        }
-    }
-    
-    // Take/Read flag (0x04)
-    if (flags & 0x04) {
-        return InteractionType::kTake;
-    }
-    
-    // Unlock flag (0x08)
-    if (flags & 0x08) {
-        return InteractionType::kLockpick;
-    }
-    
-    // Furniture flag (0x10)
-    if (flags & 0x10) {
-        if (ref) {
-            return InteractionType::kSit;
-        }
-    }
-    
-    // Harvest/Activate flag (0x20)
-    if (flags & 0x20) {
-        if (ref && ref->GetBaseObject()->Is(RE::FormType::Flora)) {
-            return InteractionType::kHarvest;
-        }
-    }
-    
-    // Default generic activation
-    return InteractionType::kActivate;
+    TRACE_SCOPE("CrosshairMonitor::GetInteractionTypeForRef");
+    return ClassifyInteraction(GameWorldView{}, ref);
 }
 
 bool CrosshairMonitor::HasInteractionType(InteractionType type) {
@@ -359,24 +239,9 @@ bool CrosshairMonitor::IsFormType(RE::FormType type) {
 }
 
 bool CrosshairMonitor::PlayerHasLockPicks() {
-    auto player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return false;
-    } 
-
-    // Get lockpick form (Form ID 0x0000000A)
-    auto lpForm = RE::TESForm::LookupByID(0x0000000A);
-    if (!lpForm) {
-        return false;
-    }
-
-    // Get the inv object for lockpick form type
-    auto boundObject = lpForm->As<RE::TESBoundObject>();
-    if (!boundObject) {
-        return false;
-    }
+    return GetPlayerLockpickCount() > 0;
+}
 
-    // Check if player has any lockpicks
-    std::int32_t count = player->GetItemCount(boundObject);
-    return count > 0;
-}
\ No newline at end of file
+int32_t CrosshairMonitor::GetPlayerLockpickCount() {
+    return GameWorldView{}.GetPlayerItemCount(kLockpickFormID);
+}
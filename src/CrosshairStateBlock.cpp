@@ -0,0 +1,159 @@
+#include "CrosshairStateBlock.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#if defined(_WIN32)
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <Windows.h>
+#else
+#	include <sys/eventfd.h>
+#	include <unistd.h>
+#endif
+
+namespace CrosshairStateBlock {
+    namespace {
+        constexpr uint32_t kMaxSubscribers = 16;
+        constexpr DCF_ChangeHandle kNoHandle = -1;
+
+        DCF_CrosshairState state{};
+
+        // Publish signals under the lock so a handle cannot be closed mid-signal. Changes are
+        // rare next to the frame rate, and consumers only take it to (un)subscribe.
+        std::mutex subscriberMutex;
+        std::array<DCF_ChangeHandle, kMaxSubscribers> subscribers = [] {
+            std::array<DCF_ChangeHandle, kMaxSubscribers> handles;
+            handles.fill(kNoHandle);
+            return handles;
+        }();
+        uint32_t subscriberCount = 0;
+
+        DCF_ChangeHandle CreateHandle() {
+#if defined(_WIN32)
+            HANDLE event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+            return event ? reinterpret_cast<DCF_ChangeHandle>(event) : kNoHandle;
+#else
+            const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            return fd >= 0 ? static_cast<DCF_ChangeHandle>(fd) : kNoHandle;
+#endif
+        }
+
+        void DestroyHandle(DCF_ChangeHandle handle) {
+#if defined(_WIN32)
+            ::CloseHandle(reinterpret_cast<HANDLE>(handle));
+#else
+            close(static_cast<int>(handle));
+#endif
+        }
+
+        void Signal(DCF_ChangeHandle handle) {
+#if defined(_WIN32)
+            SetEvent(reinterpret_cast<HANDLE>(handle));
+#else
+            // A full counter already means "changed"; nothing to do if the write fails
+            const uint64_t one = 1;
+            [[maybe_unused]] const auto written = write(static_cast<int>(handle), &one, sizeof(one));
+#endif
+        }
+
+        DCF_ChangeHandle SubscribeChanges() {
+            std::lock_guard lock(subscriberMutex);
+            for (auto& slot : subscribers) {
+                if (slot == kNoHandle) {
+                    slot = CreateHandle();
+                    if (slot != kNoHandle) {
+                        subscriberCount++;
+                    }
+                    return slot;
+                }
+            }
+            return kNoHandle;
+        }
+
+        void UnsubscribeChanges(DCF_ChangeHandle handle) {
+            if (handle == kNoHandle) return;
+
+            std::lock_guard lock(subscriberMutex);
+            for (auto& slot : subscribers) {
+                if (slot == handle) {
+                    DestroyHandle(slot);
+                    slot = kNoHandle;
+                    subscriberCount--;
+                    return;
+                }
+            }
+        }
+
+        const char* GetTypeName(uint32_t interactionType) {
+            return interactionType < kInteractionTypeCount ? InteractionTypeName(static_cast<InteractionType>(interactionType)) : "Unknown";
+        }
+
+        const DCF_CrosshairAPI api = {
+            DCF_API_VERSION,
+            sizeof(DCF_CrosshairAPI),
+            &state,
+            SubscribeChanges,
+            UnsubscribeChanges,
+            GetTypeName
+        };
+
+        template <class T>
+        void Store(T& field, T value) {
+            std::atomic_ref<T>(field).store(value, std::memory_order_relaxed);
+        }
+    }
+
+    void Publish(const TargetFacts& facts, InteractionType type, int64_t changeTimeNs) {
+        uint32_t stateFlags = 0;
+        if (facts.hasRef) stateFlags |= DCF_STATE_HAS_TARGET;
+        if (facts.locked) stateFlags |= DCF_STATE_LOCKED;
+        if (facts.dead) stateFlags |= DCF_STATE_DEAD;
+        if (facts.playerSneaking) stateFlags |= DCF_STATE_PLAYER_SNEAKING;
+
+        // Seqlock write: odd while the fields are in flux, even (and two higher) once they are consistent
+        std::atomic_ref<uint32_t> sequence(state.sequence);
+        const uint32_t start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Store(state.formID, facts.hasRef ? facts.formID : 0u);
+        Store(state.interactionType, static_cast<uint32_t>(type));
+        Store(state.activationFlags, GetActivationFlags(facts));
+        Store(state.stateFlags, stateFlags);
+        Store(state.changeTimeNs, changeTimeNs);
+        Store(state.changeCount, state.changeCount + 1);
+
+        sequence.store(start + 2, std::memory_order_release);
+
+        std::lock_guard lock(subscriberMutex);
+        if (subscriberCount == 0) return;
+        for (const auto handle : subscribers) {
+            if (handle != kNoHandle) {
+                Signal(handle);
+            }
+        }
+    }
+
+    const DCF_CrosshairState& GetState() {
+        return state;
+    }
+
+    bool HandleRequest(DCF_APIRequest& request) {
+        if (request.requestedVersion == 0 || request.requestedVersion > DCF_API_VERSION) {
+            request.api = nullptr;
+            return false;
+        }
+        request.api = &api;
+        return true;
+    }
+
+    uint32_t GetSubscriberCount() {
+        std::lock_guard lock(subscriberMutex);
+        return subscriberCount;
+    }
+}
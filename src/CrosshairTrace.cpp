@@ -0,0 +1,105 @@
+#include "CrosshairTrace.h"
+#include <cstdio>
+#include <cstring>
+
+namespace CrosshairTrace {
+    FileRecord Pack(int64_t timeNs, const TargetFacts& facts) {
+        FileRecord record{};
+        record.timeNs = timeNs;
+        record.formID = facts.formID;
+        record.baseType = facts.baseType;
+        record.flags = static_cast<uint8_t>((facts.hasRef ? kHasRef : 0) | (facts.hasBase ? kHasBase : 0) |
+                                            (facts.locked ? kLocked : 0) | (facts.dead ? kDead : 0) |
+                                            (facts.playerSneaking ? kSneaking : 0));
+        record.lockLevel = static_cast<int8_t>(facts.lockLevel);
+        record.lockpickCount = facts.lockpickCount;
+        return record;
+    }
+
+    Event Unpack(const FileRecord& record) {
+        Event event;
+        event.timeNs = record.timeNs;
+        event.facts.formID = record.formID;
+        event.facts.hasRef = record.flags & kHasRef;
+        event.facts.hasBase = record.flags & kHasBase;
+        event.facts.baseType = record.baseType;
+        event.facts.locked = record.flags & kLocked;
+        event.facts.lockLevel = static_cast<LockLevel>(record.lockLevel);
+        event.facts.dead = record.flags & kDead;
+        event.facts.playerSneaking = record.flags & kSneaking;
+        event.facts.lockpickCount = record.lockpickCount;
+        return event;
+    }
+
+    bool Read(const std::filesystem::path& path, std::vector<Event>& events) {
+        std::FILE* file = std::fopen(path.string().c_str(), "rb");
+        if (!file) return false;
+
+        // The count is checked against what the file can hold before anything is sized by it
+        std::error_code error;
+        const uint64_t fileSize = std::filesystem::file_size(path, error);
+        FileHeader header;
+        bool ok = !error && std::fread(&header, sizeof(header), 1, file) == 1 &&
+                  std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+                  header.version == kVersion &&
+                  header.recordCount <= (fileSize - sizeof(header)) / sizeof(FileRecord);
+        if (ok) {
+            events.clear();
+            events.reserve(header.recordCount);
+            FileRecord record;
+            for (uint32_t i = 0; i < header.recordCount && ok; i++) {
+                ok = std::fread(&record, sizeof(record), 1, file) == 1;
+                if (ok) {
+                    events.push_back(Unpack(record));
+                }
+            }
+        }
+        std::fclose(file);
+        return ok;
+    }
+
+    bool Recorder::Start(const std::filesystem::path& path) {
+        std::lock_guard lock(mutex);
+        if (recording.load(std::memory_order_relaxed)) return false;
+
+        outputPath = path;
+        startNs = 0;
+        records.clear();
+        records.reserve(4096);
+        recording.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    int64_t Recorder::Stop() {
+        std::lock_guard lock(mutex);
+        if (!recording.exchange(false, std::memory_order_relaxed)) return -1;
+
+        std::FILE* file = std::fopen(outputPath.string().c_str(), "wb");
+        if (!file) return -1;
+
+        FileHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.recordCount = static_cast<uint32_t>(records.size());
+        std::fwrite(&header, sizeof(header), 1, file);
+        std::fwrite(records.data(), sizeof(FileRecord), records.size(), file);
+
+        const bool ok = std::ferror(file) == 0;
+        std::fclose(file);
+
+        const int64_t written = ok ? static_cast<int64_t>(records.size()) : -1;
+        records.clear();
+        records.shrink_to_fit();
+        return written;
+    }
+
+    void Recorder::AppendLocked(int64_t nowNs, const TargetFacts& facts) {
+        std::lock_guard lock(mutex);
+        if (!recording.load(std::memory_order_relaxed) || records.size() >= kMaxEvents) return;
+
+        if (records.empty()) {
+            startNs = nowNs;
+        }
+        records.push_back(Pack(nowNs - startNs, facts));
+    }
+}
@@ -1,11 +1,19 @@
 #include "CrosshairUI.h"
+#include "UIRenderer.h"
+#include "BinaryLog.h"
+#include "Trace.h"
+#include "Metrics.h"
+#include "ImageUtil.h"
+#include "Settings.h"
+#include "HookManager.h"
+#include "JobBridge.h"
+#include "StartupProfiler.h"
 #include "SKSE/Interfaces.h"
 #include "RE/Skyrim.h"
-#include "RE/R/Renderer.h"
 #include "imgui.h"
-#include "imgui_impl_dx11.h"
-#include "imgui_impl_win32.h"
-#include <d3d11.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <wrl/client.h>
 #include <wincodec.h>
 
@@ -14,188 +22,345 @@ namespace logger = SKSE::log;
 bool CrosshairUI::Init() {
     if (initialized) return true;
 
-    auto* renderer = RE::BSGraphics::Renderer::GetSingleton();
-    if (!renderer) {
-        logger::error("Failed to get BSGraphics::Renderer singleton for crosshair UI.");
+    auto* uiRenderer = UIRenderer::GetSingleton();
+    if (!uiRenderer->Init()) {
+        logger::error("Failed to initialize UI renderer for crosshair UI.");
         return false;
     }
-    
-    REX::W32::ID3D11Device* device = RE::BSGraphics::Renderer::GetDevice();
-    auto* rendererData = RE::BSGraphics::Renderer::GetRendererDataSingleton();
-    if (!device || !rendererData || !rendererData->context) {
-        logger::error("Failed to get device, renderer data, or context for crosshair UI.");
-        return false;
+
+    uiRenderer->RegisterLayer({
+        "Crosshair",
+        [] { return CrosshairUI::GetSingleton()->initialized && HookManager::IsFeatureEnabled(HookManager::Feature::kOverlay); },
+        [] { CrosshairUI::GetSingleton()->Draw(); }
+    });
+
+    initialized = true;
+    logger::info("Successfully initialized crosshair UI.");
+    return true;
+}
+
+void CrosshairUI::Shutdown() {
+    if (!initialized) return;
+
+    for (auto& [type, texture] : crosshairTextures) {
+        ReleaseTexture(texture);
     }
+    crosshairTextures.clear();
 
-    device->AddRef();
-    rendererData->context->AddRef();
-    d3d_device = reinterpret_cast<ID3D11Device*>(device);
-    d3d_context = reinterpret_cast<ID3D11DeviceContext*>(rendererData->context);
+    initialized = false;
+    logger::info("Successfully shutdown crosshair UI.");
+}
 
-    auto* currentWindow = RE::BSGraphics::Renderer::GetCurrentRenderWindow();
-    if (!currentWindow) {
-        logger::error("Failed to get current render window for crosshair UI.");
-        return false;
+namespace {
+    using Channel = CrosshairAnimator::Channel;
+    using InteractionType = CrosshairMonitor::InteractionType;
+
+    constexpr float kScalePulse = 0.15f;    // Fraction of the size added at the pulse's peak
+    constexpr float kLockWiggle = 0.12f;    // Radians
+    constexpr float kMinVisibleOpacity = 1.0f / 255.0f;
+
+    struct Tint {
+        float r, g, b;
+    };
+
+    // Crimes read red and dead ends grey; everything else keeps the texture's own colours
+    Tint TintFor(InteractionType type) {
+        switch (type) {
+            case InteractionType::kSteal:
+            case InteractionType::kPickpocket:   return { 1.0f, 0.45f, 0.45f };
+            case InteractionType::kLockpickNone:
+            case InteractionType::kRequiresKey:  return { 0.6f, 0.6f, 0.6f };
+            default:                             return { 1.0f, 1.0f, 1.0f };
+        }
     }
 
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
-    ImGuiIO& io = ImGui::GetIO(); 
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
-    
-    io.MouseDrawCursor = false;
-    io.WantCaptureMouse = false;
-    io.WantCaptureKeyboard = false;
-    
-    ImGui::StyleColorsDark();
-    
-    if (!ImGui_ImplWin32_Init(currentWindow->hWnd)) {
-        logger::error("Failed to initialize ImGui_ImplWin32 for crosshair UI.");
-        return false;
+    bool IsLockType(InteractionType type) {
+        return type == InteractionType::kLockpick || type == InteractionType::kLockpickNone ||
+            type == InteractionType::kRequiresKey || type == InteractionType::kUseKey;
     }
+}
 
-    if (!ImGui_ImplDX11_Init(d3d_device, d3d_context)) {
-        logger::error("Failed to initialize ImGui_ImplDX11 for crosshair UI.");
-        return false;
+void CrosshairUI::Draw() {
+    const ImVec2 displaySize = ImGui::GetIO().DisplaySize;
+    screenCenter = ImVec2(displaySize.x * 0.5f, displaySize.y * 0.5f);
+
+    // Outgoing first, so the incoming crosshair ends up on top
+    const auto& pose = animator.GetPose();
+    DrawCrosshair(previousType, pose.Get(Channel::kPreviousOpacity));
+    DrawCrosshair(currentType, pose.Get(Channel::kOpacity));
+}
+
+void CrosshairUI::DrawCrosshair(CrosshairMonitor::InteractionType type, float opacity) {
+    if (opacity < kMinVisibleOpacity) return;
+    auto it = crosshairTextures.find(type);
+    if (it == crosshairTextures.end() || !it->second) {
+        return; // No custom texture for this type, leave the vanilla crosshair alone
     }
 
-    initialized = true;
-    logger::info("Successfully initialized ImGui for crosshair UI.");
-    return true;
+    const auto& pose = animator.GetPose();
+    const float halfSize = Settings::Get().crosshairSize * pose.Get(Channel::kScale) * 0.5f;
+    const float cosine = std::cos(pose.Get(Channel::kRotation));
+    const float sine = std::sin(pose.Get(Channel::kRotation));
+    const auto corner = [&](float x, float y) {
+        return ImVec2(screenCenter.x + (x * cosine - y * sine) * halfSize, screenCenter.y + (x * sine + y * cosine) * halfSize);
+    };
+    const ImU32 color = ImGui::ColorConvertFloat4ToU32(ImVec4(
+        pose.Get(Channel::kTintR), pose.Get(Channel::kTintG), pose.Get(Channel::kTintB), std::min(opacity, 1.0f)));
+
+    ImGui::GetBackgroundDrawList()->AddImageQuad(
+        it->second,
+        corner(-1.0f, -1.0f), corner(1.0f, -1.0f), corner(1.0f, 1.0f), corner(-1.0f, 1.0f),
+        ImVec2(0.0f, 0.0f), ImVec2(1.0f, 0.0f), ImVec2(1.0f, 1.0f), ImVec2(0.0f, 1.0f),
+        color);
 }
 
-void CrosshairUI::Shutdown() {
-    if (!initialized) return;
-    
-    ImGui_ImplDX11_Shutdown();
-    ImGui_ImplWin32_Shutdown();
-    ImGui::DestroyContext();
-    
-    initialized = false;
-    d3d_device = nullptr;
-    d3d_context = nullptr;
-    logger::info("Successfully shutdown ImGui for crosshair UI.");
+void CrosshairUI::SyncWithMonitor() {
+    const auto publishedType = CrosshairMonitor::GetPublishedInteractionType();
+    if (publishedType != currentType) {
+        Metrics::BeginPresentLatency(CrosshairMonitor::GetPublishedChangeTimeNs());
+        UpdateCrosshairType(publishedType);
+    }
+
+    // Fixed-step animation; the cached frame is redrawn while anything moves, and once more
+    // for the frame a transition settles
+    const int64_t now = Metrics::NowNs();
+    const float elapsed = lastSyncNs ? static_cast<float>(now - lastSyncNs) * 1e-9f : 0.0f;
+    lastSyncNs = now;
+    if (animator.IsAnimating() || animating) {
+        animator.Advance(elapsed);
+        animating = animator.IsAnimating();
+        UIRenderer::GetSingleton()->Invalidate();
+    }
+
+    // A reload or menu edit may have changed how the crosshair is drawn
+    if (const uint32_t generation = Settings::Get().generation; generation != settingsGeneration) {
+        settingsGeneration = generation;
+        UIRenderer::GetSingleton()->Invalidate();
+    }
 }
 
-void CrosshairUI::BeginFrame() {
-    if (!initialized) return;
-    
-    ImGui_ImplDX11_NewFrame();
-    ImGui_ImplWin32_NewFrame();
-    ImGui::NewFrame();
+void CrosshairUI::UpdateCrosshairType(CrosshairMonitor::InteractionType iType) {
+    if (iType == currentType) return;
+
+    previousType = currentType;
+    currentType = iType;
+
+    const Tint tint = TintFor(iType);
+    const float seconds = static_cast<float>(Settings::Get().transitionMs) * 0.001f;
+    if (seconds <= 0.0f) {
+        // Instant switch: whatever was in flight settles, then the new tint applies directly
+        animator.Reset();
+        animator.SetRest(Channel::kPreviousOpacity, 0.0f);
+        animator.SetRest(Channel::kTintR, tint.r);
+        animator.SetRest(Channel::kTintG, tint.g);
+        animator.SetRest(Channel::kTintB, tint.b);
+    } else {
+        animator.Crossfade(seconds);
+        animator.TintTo(tint.r, tint.g, tint.b, seconds);
+        if (iType != InteractionType::kNone) {
+            animator.Pulse(Channel::kScale, kScalePulse, seconds * 1.5f);
+        }
+        if (IsLockType(iType)) {
+            animator.Wiggle(Channel::kRotation, kLockWiggle, seconds * 2.0f);
+        }
+        animating = true;
+    }
+    UIRenderer::GetSingleton()->Invalidate();
 }
 
-void CrosshairUI::EndFrame() {
-    if (!initialized) return;
-    
-    ImGui::Render();
-    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+namespace {
+    constexpr const char* kCrosshairDirectory = "Data/SKSE/Plugins/DynamicCrosshairFramework/Crosshairs";
+    constexpr std::array<const char*, 2> kImageExtensions = { ".png", ".tga" };
+
+    // Any thread; WIC is initialized for the calling thread if it has not been already
+    bool DecodeImage(const std::filesystem::path& path, ImageUtil::Image& image) {
+        // WIC has no TGA codec; decode those ourselves
+        if (_stricmp(path.extension().string().c_str(), ".tga") == 0) {
+            if (!ImageUtil::LoadTga(path, image)) {
+                logger::error("Failed to decode TGA file: {}", path.string());
+                return false;
+            }
+            return true;
+        }
+
+        // Job workers start without COM; the render thread already has it in another mode,
+        // which WIC works with as well
+        const HRESULT coInit = ::CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        const bool uninitialize = SUCCEEDED(coInit);
+        const auto decode = [&]() -> bool {
+            Microsoft::WRL::ComPtr<IWICImagingFactory> wicFactory;
+            HRESULT hr = ::CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&wicFactory));
+            if (FAILED(hr)) {
+                logger::error("Failed to create WIC factory: 0x{:08X}", static_cast<uint32_t>(hr));
+                return false;
+            }
+
+            Microsoft::WRL::ComPtr<IWICBitmapDecoder> decoder;
+            hr = wicFactory->CreateDecoderFromFilename(path.wstring().c_str(), nullptr, GENERIC_READ, WICDecodeMetadataCacheOnDemand, &decoder);
+            if (FAILED(hr)) {
+                logger::error("Failed to create decoder for file: {} - HRESULT: 0x{:08X}", path.string(), static_cast<uint32_t>(hr));
+                logger::error("This usually means the file doesn't exist or isn't accessible");
+                return false;
+            }
+
+            Microsoft::WRL::ComPtr<IWICBitmapFrameDecode> frame;
+            hr = decoder->GetFrame(0, &frame);
+            if (FAILED(hr)) {
+                logger::error("Failed to get frame from image.");
+                return false;
+            }
+
+            Microsoft::WRL::ComPtr<IWICFormatConverter> converter;
+            hr = wicFactory->CreateFormatConverter(&converter);
+            if (FAILED(hr)) {
+                logger::error("Failed to create format converter.");
+                return false;
+            }
+            hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
+            if (FAILED(hr)) {
+                logger::error("Failed to initialize format converter.");
+                return false;
+            }
+
+            UINT width, height;
+            hr = converter->GetSize(&width, &height);
+            if (FAILED(hr)) {
+                logger::error("Failed to get image dimensions.");
+                return false;
+            }
+
+            image.width = width;
+            image.height = height;
+            image.pixels.resize(static_cast<std::size_t>(width) * height * 4);
+            hr = converter->CopyPixels(nullptr, width * 4, static_cast<UINT>(image.pixels.size()), image.pixels.data());
+            if (FAILED(hr)) {
+                logger::error("Failed to copy pixel data.");
+                return false;
+            }
+            return true;
+        };
+        const bool decoded = decode();
+        if (uninitialize) {
+            ::CoUninitialize();
+        }
+        return decoded;
+    }
+
+    // A texture on its way from the job pool to the render thread
+    struct PendingTexture {
+        CrosshairMonitor::InteractionType type;
+        ImageUtil::Image image;
+        bool decoded = false;
+    };
+}
+
+void CrosshairUI::InitAfterMainMenu() {
+    if (auto* ui = RE::UI::GetSingleton()) {
+        ui->AddEventSink<RE::MenuOpenCloseEvent>(this);
+    } else {
+        // Nothing to wait for; the first loaded game will request it
+        logger::warn("No UI event source; the crosshair overlay starts with the first loaded game");
+    }
+}
+
+void CrosshairUI::RequestInit() {
+    if (initRequested.exchange(true)) return;
+
+    JobBridge::Post(JobBridge::Target::kRender, [] {
+        auto* crosshairUI = CrosshairUI::GetSingleton();
+        {
+            StartupProfiler::Scope phase("CrosshairUI", StartupProfiler::Kind::kDeferred);
+            if (!crosshairUI->Init()) {
+                logger::error("Failed to initialize CrosshairUI");
+                return;
+            }
+        }
+        crosshairUI->LoadTextures();
+    });
+}
+
+RE::BSEventNotifyControl CrosshairUI::ProcessEvent(const RE::MenuOpenCloseEvent* a_event, RE::BSTEventSource<RE::MenuOpenCloseEvent>*) {
+    if (a_event && a_event->opening && a_event->menuName == RE::MainMenu::MENU_NAME) {
+        RequestInit();
+    }
+    return RE::BSEventNotifyControl::kContinue;
+}
+
+void CrosshairUI::LoadTextures() {
+    texturesStartNs = Metrics::NowNs();
+    for (std::size_t i = 1; i < kInteractionTypeCount; i++) {
+        auto* pending = Memory::New<PendingTexture>(Memory::Tag::kTextures);
+        pending->type = static_cast<CrosshairMonitor::InteractionType>(i);
+        pendingTextures++;
+
+        JobBridge::Run(
+            [pending] {
+                // Types without an image keep the vanilla crosshair
+                const std::filesystem::path stem = std::filesystem::path(kCrosshairDirectory) / CrosshairMonitor::GetInteractionTypeName(pending->type);
+                for (const char* extension : kImageExtensions) {
+                    std::filesystem::path path = stem;
+                    path += extension;
+                    std::error_code error;
+                    if (std::filesystem::exists(path, error)) {
+                        pending->decoded = DecodeImage(path, pending->image);
+                        break;
+                    }
+                }
+            },
+            JobBridge::Target::kRender,
+            [pending] {
+                // One upload per slice of the render thread's budget, behind anything more urgent
+                auto* crosshairUI = CrosshairUI::GetSingleton();
+                auto* backend = UIRenderer::GetSingleton()->GetBackend();
+                if (pending->decoded && backend) {
+                    if (ImTextureID texture = backend->CreateTexture(pending->image.width, pending->image.height, pending->image.pixels.data())) {
+                        auto& slot = crosshairUI->crosshairTextures[pending->type];
+                        crosshairUI->ReleaseTexture(slot);
+                        slot = texture;
+                        crosshairUI->loadedTextures++;
+                        UIRenderer::GetSingleton()->Invalidate();
+                    } else {
+                        logger::error("Failed to create texture for {}", CrosshairMonitor::GetInteractionTypeName(pending->type));
+                    }
+                }
+                Memory::Delete(pending);
+
+                if (--crosshairUI->pendingTextures == 0) {
+                    StartupProfiler::Record("CrosshairTextures", StartupProfiler::Kind::kDeferred,
+                        crosshairUI->texturesStartNs, Metrics::NowNs() - crosshairUI->texturesStartNs);
+                    logger::info("Loaded {} crosshair texture(s)", crosshairUI->loadedTextures);
+                    StartupProfiler::LogSummary();
+                }
+            },
+            {}, JobBridge::Priority::kBackground);
+    }
 }
 
-ID3D11ShaderResourceView* CrosshairUI::LoadTextureFromFile(const std::string& filePath) {
-    logger::info("Loading texture from file: {}...", filePath);
-    if (!d3d_device) {
-        logger::error("Failed to load texture: D3D device is not initialized.");
-        return nullptr;
-    }
-    
-    std::wstring wFilePath(filePath.begin(), filePath.end());
-    logger::info("Converted string to wide path, attempting WIC factory creation...");
-
-    Microsoft::WRL::ComPtr<IWICImagingFactory> wicFactory;
-    HRESULT hr = ::CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&wicFactory));
-    if (FAILED(hr)) {
-        logger::error("Failed to create WIC factory: 0x{:08X}", static_cast<uint32_t>(hr));
-        return nullptr;
-    }
-    logger::info("Successfully created WIC factory, attempting to create decoder...");
-    
-    Microsoft::WRL::ComPtr<IWICBitmapDecoder> decoder;
-    hr = wicFactory->CreateDecoderFromFilename(wFilePath.c_str(), nullptr, GENERIC_READ, WICDecodeMetadataCacheOnDemand, &decoder);
-    if (FAILED(hr)) {
-        logger::error("Failed to create decoder for file: {} - HRESULT: 0x{:08X}", filePath, static_cast<uint32_t>(hr));
-        logger::error("This usually means the file doesn't exist or isn't accessible");
-        return nullptr;
-    }
-    logger::info("Successfully created decoder, attempting to create frame...");
-    
-    Microsoft::WRL::ComPtr<IWICBitmapFrameDecode> frame;
-    hr = decoder->GetFrame(0, &frame);
-    if (FAILED(hr)) {
-        logger::error("Failed to get frame from image.");
-        return nullptr;
-    }
-    logger::info("Successfully created frame, attempting to convert format...");
-    
-    Microsoft::WRL::ComPtr<IWICFormatConverter> converter;
-    hr = wicFactory->CreateFormatConverter(&converter);
-    if (FAILED(hr)) {
-        logger::error("Failed to create format converter.");
-        return nullptr;
-    }
-    hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
-    if (FAILED(hr)) {
-        logger::error("Failed to initialize format converter.");
-        return nullptr;
-    }
-    logger::info("Successfully initialized format converter, attempting to get image dimensions.");
-    
-    UINT width, height;
-    hr = converter->GetSize(&width, &height);
-    if (FAILED(hr)) {
-        logger::error("Failed to get image dimensions.");
-        return nullptr;
-    }
-    logger::info("Successfully got image dimensions, attempting to copy pixel data.");
-    
-    std::vector<BYTE> pixels(width * height * 4);
-    hr = converter->CopyPixels(nullptr, width * 4, static_cast<UINT>(pixels.size()), pixels.data());
-    if (FAILED(hr)) {
-        logger::error("Failed to copy pixel data.");
-        return nullptr;
-    }
-    logger::info("Successfully copied pixel data, attempting to create D3D11 texture.");
-    
-    D3D11_TEXTURE2D_DESC textureDesc = {};
-    textureDesc.Width = width;
-    textureDesc.Height = height;
-    textureDesc.MipLevels = 1;
-    textureDesc.ArraySize = 1;
-    textureDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
-    textureDesc.SampleDesc.Count = 1;
-    textureDesc.Usage = D3D11_USAGE_DEFAULT;
-    textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-    
-    D3D11_SUBRESOURCE_DATA initData = {};
-    initData.pSysMem = pixels.data();
-    initData.SysMemPitch = width * 4;
-    
-    Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
-    hr = d3d_device->CreateTexture2D(&textureDesc, &initData, &texture);
-    if (FAILED(hr)) {
-        logger::error("Failed to create D3D11 texture.");
-        return nullptr;
-    }
-    logger::info("Successfully created D3D11 texture, attempting to create shader resource view.");
-    
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-    srvDesc.Format = textureDesc.Format;
-    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Texture2D.MipLevels = 1;
-    
-    ID3D11ShaderResourceView* srv = nullptr;
-    hr = d3d_device->CreateShaderResourceView(texture.Get(), &srvDesc, &srv);
-    if (FAILED(hr)) {
-        logger::error("Failed to create shader resource view.");
-        return nullptr;
-    }
-    logger::info("Successfully created shader resource view.");
-    return srv;
+ImTextureID CrosshairUI::LoadTextureFromFile(const std::string& filePath) {
+    TRACE_SCOPE("CrosshairUI::LoadTextureFromFile");
+    BLOG_DEBUG("Loading texture from file: {}", filePath);
+    auto* backend = UIRenderer::GetSingleton()->GetBackend();
+    if (!backend) {
+        logger::error("Failed to load texture: render backend is not initialized.");
+        return ImTextureID{};
+    }
+
+    ImageUtil::Image image;
+    if (!DecodeImage(filePath, image)) {
+        return ImTextureID{};
+    }
+    ImTextureID texture = backend->CreateTexture(image.width, image.height, image.pixels.data());
+    if (!texture) {
+        logger::error("Failed to create texture.");
+        return ImTextureID{};
+    }
+    BLOG_DEBUG("Created {}x{} texture from {}", image.width, image.height, filePath);
+    return texture;
 }
 
-void CrosshairUI::ReleaseTexture(ID3D11ShaderResourceView* texture) {
-    if (texture) {
-        texture->Release();
+void CrosshairUI::ReleaseTexture(ImTextureID texture) {
+    auto* backend = UIRenderer::GetSingleton()->GetBackend();
+    if (texture && backend) {
+        backend->ReleaseTexture(texture);
     }
 }
@@ -0,0 +1,167 @@
+#include "DX11RenderBackend.h"
+#include "Allocator.h"
+#include "imgui_impl_dx11.h"
+#include "imgui_impl_win32.h"
+#include <wrl/client.h>
+
+namespace logger = SKSE::log;
+
+namespace {
+    // imgui_impl_dx11 creates its buffers with this much room beyond the frame that first needs
+    // them, and recreates them the same way when a frame outgrows them; it never shrinks them
+    constexpr int kVertexHeadroom = 5000;
+    constexpr int kIndexHeadroom = 10000;
+
+    int64_t TextureBytes(ID3D11ShaderResourceView* srv) {
+        Microsoft::WRL::ComPtr<ID3D11Resource> resource;
+        srv->GetResource(&resource);
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+        if (!resource || FAILED(resource.As(&texture))) return 0;
+
+        D3D11_TEXTURE2D_DESC desc{};
+        texture->GetDesc(&desc);
+        return static_cast<int64_t>(desc.Width) * desc.Height * 4;    // Only BGRA8/RGBA8 are created
+    }
+}
+
+DX11RenderBackend::DX11RenderBackend(ID3D11Device* device, ID3D11DeviceContext* context, HWND hWnd) :
+    d3d_device(device),
+    d3d_context(context),
+    hWnd(hWnd) {
+    d3d_device->AddRef();
+    d3d_context->AddRef();
+}
+
+DX11RenderBackend::~DX11RenderBackend() {
+    Shutdown();
+    if (d3d_context) d3d_context->Release();
+    if (d3d_device) d3d_device->Release();
+}
+
+bool DX11RenderBackend::Init() {
+    if (initialized) return true;
+
+    if (!ImGui_ImplWin32_Init(hWnd)) {
+        logger::error("Failed to initialize ImGui_ImplWin32.");
+        return false;
+    }
+
+    if (!ImGui_ImplDX11_Init(d3d_device, d3d_context)) {
+        logger::error("Failed to initialize ImGui_ImplDX11.");
+        ImGui_ImplWin32_Shutdown();
+        return false;
+    }
+
+    initialized = true;
+    return true;
+}
+
+void DX11RenderBackend::Shutdown() {
+    if (!initialized) return;
+
+    TrackFontAtlas(0);
+    if (vertexCapacity) {
+        Memory::TrackGpuFree(Memory::Tag::kImGui, static_cast<int64_t>(vertexCapacity) * sizeof(ImDrawVert));
+        vertexCapacity = 0;
+    }
+    if (indexCapacity) {
+        Memory::TrackGpuFree(Memory::Tag::kImGui, static_cast<int64_t>(indexCapacity) * sizeof(ImDrawIdx));
+        indexCapacity = 0;
+    }
+    ImGui_ImplDX11_Shutdown();
+    ImGui_ImplWin32_Shutdown();
+    initialized = false;
+}
+
+void DX11RenderBackend::NewFrame() {
+    ImGui_ImplDX11_NewFrame();
+    ImGui_ImplWin32_NewFrame();
+
+    // The backend uploads the font atlas on its first NewFrame, and again after a rebuild
+    const ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+    TrackFontAtlas(fonts->TexID ? static_cast<int64_t>(fonts->TexWidth) * fonts->TexHeight * 4 : 0);
+}
+
+void DX11RenderBackend::RenderDrawData(ImDrawData* drawData) {
+    ImGui_ImplDX11_RenderDrawData(drawData);
+
+    // The backend's buffers are private; follow its growth rule to know their size
+    if (drawData->DisplaySize.x <= 0.0f || drawData->DisplaySize.y <= 0.0f) return;
+    if (!vertexCapacity || drawData->TotalVtxCount > vertexCapacity) {
+        if (vertexCapacity) {
+            Memory::TrackGpuFree(Memory::Tag::kImGui, static_cast<int64_t>(vertexCapacity) * sizeof(ImDrawVert));
+        }
+        vertexCapacity = drawData->TotalVtxCount + kVertexHeadroom;
+        Memory::TrackGpuAllocation(Memory::Tag::kImGui, static_cast<int64_t>(vertexCapacity) * sizeof(ImDrawVert));
+    }
+    if (!indexCapacity || drawData->TotalIdxCount > indexCapacity) {
+        if (indexCapacity) {
+            Memory::TrackGpuFree(Memory::Tag::kImGui, static_cast<int64_t>(indexCapacity) * sizeof(ImDrawIdx));
+        }
+        indexCapacity = drawData->TotalIdxCount + kIndexHeadroom;
+        Memory::TrackGpuAllocation(Memory::Tag::kImGui, static_cast<int64_t>(indexCapacity) * sizeof(ImDrawIdx));
+    }
+}
+
+void DX11RenderBackend::TrackFontAtlas(int64_t bytes) {
+    if (bytes == fontAtlasBytes) return;
+    if (fontAtlasBytes) {
+        Memory::TrackGpuFree(Memory::Tag::kImGui, fontAtlasBytes);
+    }
+    if (bytes) {
+        Memory::TrackGpuAllocation(Memory::Tag::kImGui, bytes);
+    }
+    fontAtlasBytes = bytes;
+}
+
+ImVec2 DX11RenderBackend::GetDisplaySize() const {
+    RECT rect{};
+    if (!hWnd || !::GetClientRect(hWnd, &rect)) {
+        return ImGui::GetIO().DisplaySize;
+    }
+    return ImVec2(static_cast<float>(rect.right - rect.left), static_cast<float>(rect.bottom - rect.top));
+}
+
+ImTextureID DX11RenderBackend::CreateTexture(uint32_t width, uint32_t height, const uint8_t* pixels) {
+    D3D11_TEXTURE2D_DESC textureDesc = {};
+    textureDesc.Width = width;
+    textureDesc.Height = height;
+    textureDesc.MipLevels = 1;
+    textureDesc.ArraySize = 1;
+    textureDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    textureDesc.SampleDesc.Count = 1;
+    textureDesc.Usage = D3D11_USAGE_DEFAULT;
+    textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = pixels;
+    initData.SysMemPitch = width * 4;
+
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+    HRESULT hr = d3d_device->CreateTexture2D(&textureDesc, &initData, &texture);
+    if (FAILED(hr)) {
+        logger::error("Failed to create D3D11 texture: 0x{:08X}", static_cast<uint32_t>(hr));
+        return ImTextureID{};
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = textureDesc.Format;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = 1;
+
+    ID3D11ShaderResourceView* srv = nullptr;
+    hr = d3d_device->CreateShaderResourceView(texture.Get(), &srvDesc, &srv);
+    if (FAILED(hr)) {
+        logger::error("Failed to create shader resource view: 0x{:08X}", static_cast<uint32_t>(hr));
+        return ImTextureID{};
+    }
+    Memory::TrackGpuAllocation(Memory::Tag::kTextures, static_cast<int64_t>(width) * height * 4);
+    return (ImTextureID)srv;
+}
+
+void DX11RenderBackend::ReleaseTexture(ImTextureID texture) {
+    if (auto* srv = (ID3D11ShaderResourceView*)texture) {
+        Memory::TrackGpuFree(Memory::Tag::kTextures, TextureBytes(srv));
+        srv->Release();
+    }
+}
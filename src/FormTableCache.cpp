@@ -0,0 +1,97 @@
+#include "FormTableCache.h"
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+namespace FormTableCache {
+    namespace {
+        constexpr uint64_t kFnvOffset = 0xCBF29CE484222325ull;
+        constexpr uint64_t kFnvPrime = 0x100000001B3ull;
+    }
+
+    KeyBuilder::KeyBuilder(uint32_t rulesVersion) : hash(kFnvOffset) {
+        const uint16_t formatVersion = kFormatVersion;
+        Mix(&formatVersion, sizeof(formatVersion));
+        Mix(&rulesVersion, sizeof(rulesVersion));
+    }
+
+    void KeyBuilder::AddPlugin(std::string_view name, uint64_t fileSize, int64_t writeTime) {
+        for (const char c : name) {
+            const auto lower = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            Mix(&lower, 1);
+        }
+        // Ends the name, so "a.esp" + "b.esp" cannot hash like "a.espb" + ".esp"
+        const char separator = '\0';
+        Mix(&separator, 1);
+        Mix(&fileSize, sizeof(fileSize));
+        Mix(&writeTime, sizeof(writeTime));
+    }
+
+    void KeyBuilder::Mix(const void* bytes, std::size_t count) {
+        const auto* data = static_cast<const uint8_t*>(bytes);
+        for (std::size_t i = 0; i < count; i++) {
+            hash = (hash ^ data[i]) * kFnvPrime;
+        }
+    }
+
+    const char* LoadResultName(LoadResult result) {
+        switch (result) {
+            case LoadResult::kLoaded:  return "loaded";
+            case LoadResult::kMissing: return "missing";
+            case LoadResult::kStale:   return "stale";
+            case LoadResult::kInvalid: return "invalid";
+            default:                   return "unknown";
+        }
+    }
+
+    LoadResult Load(const std::filesystem::path& path, uint64_t key, InfoCards::StaticTable& table) {
+        MappedFile file;
+        if (!file.Open(path)) return LoadResult::kMissing;
+        if (file.GetSize() < sizeof(Header)) return LoadResult::kInvalid;
+
+        Header header;
+        std::memcpy(&header, file.GetData(), sizeof(header));
+        if (header.magic != kMagic || header.formatVersion != kFormatVersion || header.entrySize != sizeof(InfoCards::StaticInfo)) {
+            return LoadResult::kInvalid;
+        }
+        if (header.key != key) return LoadResult::kStale;
+        if (file.GetSize() != sizeof(Header) + static_cast<std::size_t>(header.entryCount) * sizeof(InfoCards::StaticInfo)) {
+            return LoadResult::kInvalid;
+        }
+
+        // Mappings are page aligned and the header keeps the entries aligned after it
+        const auto* entries = reinterpret_cast<const InfoCards::StaticInfo*>(file.GetData() + sizeof(Header));
+        table.Adopt(std::move(file), { entries, header.entryCount });
+        return LoadResult::kLoaded;
+    }
+
+    bool Save(const std::filesystem::path& path, uint64_t key, std::span<const InfoCards::StaticInfo> entries) {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        Header header;
+        header.key = key;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size_bytes()));
+            if (!out.flush()) {
+                out.close();
+                std::filesystem::remove(temporary, error);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+}
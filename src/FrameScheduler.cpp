@@ -0,0 +1,117 @@
+#include "FrameScheduler.h"
+#include <algorithm>
+
+namespace {
+    constexpr float kMaxFrameIntervalMs = 250.0f;
+    constexpr float kFrameTimeSmoothing = 0.1f;
+    constexpr float kMinBudgetScale = 0.25f;
+}
+
+bool FrameScheduler::Post(Priority priority, Task task) {
+    const auto index = static_cast<std::size_t>(priority);
+    {
+        std::lock_guard lock(mutex);
+        Queue& queue = queues[index];
+        if (queue.size == kQueueCapacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        queue.ring[(queue.head + queue.size++) % kQueueCapacity] = std::move(task);
+        // Under the lock, so a concurrent Pop cannot decrement ahead of it
+        pending[index].fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool FrameScheduler::Pop(Priority priority, Task& task) {
+    const auto index = static_cast<std::size_t>(priority);
+    {
+        std::lock_guard lock(mutex);
+        Queue& queue = queues[index];
+        if (queue.size == 0) return false;
+        task = std::move(queue.ring[queue.head]);
+        queue.ring[queue.head] = nullptr;
+        queue.head = (queue.head + 1) % kQueueCapacity;
+        queue.size--;
+        pending[index].fetch_sub(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void FrameScheduler::RecordFrameTime(float frameMs) {
+    if (frameMs <= 0.0f || frameMs >= kMaxFrameIntervalMs) return;
+
+    const float average = avgFrameMs.load(std::memory_order_relaxed);
+    avgFrameMs.store(average > 0.0f ? average + (frameMs - average) * kFrameTimeSmoothing : frameMs, std::memory_order_relaxed);
+}
+
+uint32_t FrameScheduler::AdaptBudget() {
+    // Frames over the target leave no headroom, so give the game back the difference
+    const float average = avgFrameMs.load(std::memory_order_relaxed);
+    const float target = targetFrameMs.load(std::memory_order_relaxed);
+    const float scale = average > target ? std::max(target / average, kMinBudgetScale) : 1.0f;
+    const auto budget = static_cast<uint32_t>(static_cast<float>(baseBudgetUs.load(std::memory_order_relaxed)) * scale);
+
+    budgetUs.store(budget, std::memory_order_relaxed);
+    return budget;
+}
+
+uint32_t FrameScheduler::RunFrame() {
+    if (GetPendingCount() == 0) {
+        lastSpentUs.store(0, std::memory_order_relaxed);
+        return 0;
+    }
+    const Clock::time_point start = Clock::now();
+    const uint32_t budget = AdaptBudget();
+
+    uint32_t ran = 0;
+    Task task;
+    while (Pop(Priority::kCritical, task)) {
+        task();
+        task = nullptr;
+        ran++;
+    }
+
+    // Budgeted work, most important first. One task always runs so nothing starves when
+    // critical work eats the whole budget; tasks are expected to be small slices.
+    const auto deadline = start + std::chrono::microseconds(budget);
+    bool ranBudgeted = false;
+    for (const Priority priority : { Priority::kNormal, Priority::kBackground }) {
+        while ((!ranBudgeted || Clock::now() < deadline) && Pop(priority, task)) {
+            task();
+            task = nullptr;
+            ranBudgeted = true;
+            ran++;
+        }
+    }
+
+    const auto spent = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    lastSpentUs.store(static_cast<uint32_t>(spent), std::memory_order_relaxed);
+    executed.fetch_add(ran, std::memory_order_relaxed);
+    if (GetPendingCount() > 0) {
+        deferredFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ran;
+}
+
+uint32_t FrameScheduler::GetPendingCount() const {
+    uint32_t total = 0;
+    for (const auto& count : pending) {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+FrameScheduler::Stats FrameScheduler::GetStats() const {
+    Stats stats;
+    for (std::size_t i = 0; i < kPriorityCount; i++) {
+        stats.pending[i] = pending[i].load(std::memory_order_relaxed);
+    }
+    stats.budgetUs = budgetUs.load(std::memory_order_relaxed);
+    stats.lastSpentUs = lastSpentUs.load(std::memory_order_relaxed);
+    stats.avgFrameMs = avgFrameMs.load(std::memory_order_relaxed);
+    stats.executed = executed.load(std::memory_order_relaxed);
+    stats.deferredFrames = deferredFrames.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,245 @@
+#include "HookManager.h"
+#include "CrosshairUI.h"
+#include "InfoCardUI.h"
+#include "JobBridge.h"
+#include "MarkerOverlayUI.h"
+#include "Menu.h"
+#include "Metrics.h"
+#include "Settings.h"
+#include "StartupProfiler.h"
+#include "Trace.h"
+#include "UIRenderer.h"
+#include "RE/R/Renderer.h"
+#include <dxgi.h>
+
+namespace logger = SKSE::log;
+
+namespace {
+    using Feature = HookManager::Feature;
+
+    // Per-call work of one hook, in order. Owned by the hooked thread, which rebuilds it when it
+    // sees a new Settings generation; nothing else ever touches it.
+    template <class Step, std::size_t Capacity>
+    struct DispatchTable {
+        std::array<Step, Capacity> steps{};
+        uint32_t count = 0;
+        uint32_t generation = UINT32_MAX;   // Settings generation it was built from
+
+        void Add(Step step) { steps[count++] = step; }
+    };
+
+    // Present steps
+    void NameRenderThread() {
+        Trace::SetThreadName("Render"); // Two thread-local stores; cheaper than tracking whether it was done
+    }
+
+    void RunDeferredRenderWork() {
+        JobBridge::RunRenderFrame(); // This frame's share of the work posted for the render thread
+    }
+
+    void DrainMenuInput() {
+        auto* menu = Menu::GetSingleton();
+        if (!menu->initialized) {
+            // Built the first time it is opened; while closed only the toggle key gets queued
+            if (!menu->HasQueuedInput()) return;
+            StartupProfiler::Scope phase("Menu", StartupProfiler::Kind::kDeferred);
+            if (!menu->Init()) {
+                menu->DiscardQueuedInput();
+                return;
+            }
+        }
+        menu->ProcessInputEventQueue(); // Process queued inputs before drawing
+    }
+
+    void SyncCrosshair() {
+        auto* crosshairUI = CrosshairUI::GetSingleton();
+        if (crosshairUI->IsInitialized()) {
+            crosshairUI->SyncWithMonitor(); // Invalidates the cached frame only when the type changed
+        }
+    }
+
+    void SyncInfoCard() {
+        auto* infoCard = InfoCardUI::GetSingleton();
+        if (infoCard->IsInitialized()) {
+            infoCard->SyncWithGame(); // One atomic load unless the game thread published a new card
+        }
+    }
+
+    void SyncMarkers() {
+        auto* markers = MarkerOverlayUI::GetSingleton();
+        if (markers->IsInitialized()) {
+            markers->SyncWithGame(); // Culls and projects against this frame's camera
+        }
+    }
+
+    void RenderUI() {
+        // One shared ImGui frame for the crosshair overlay and the menu
+        UIRenderer::GetSingleton()->Render();
+    }
+
+    void EndPresentLatency() {
+        // Our draw calls are submitted; the game's Present follows as soon as this returns.
+        // The overlay shows the histogram, so a new sample has to rebuild the next frame.
+        if (Metrics::EndPresentLatency() && Menu::GetSingleton()->showLatencyOverlay) {
+            UIRenderer::GetSingleton()->Invalidate();
+        }
+    }
+
+    DispatchTable<void (*)(), 10> presentTable;
+
+    void BuildPresentTable(const Settings::Snapshot& settings) {
+        auto& table = presentTable;
+        table.count = 0;
+        if (settings.tracingEnabled) table.Add(NameRenderThread);
+        table.Add(RunDeferredRenderWork);
+        if (settings.menuEnabled) table.Add(DrainMenuInput);
+        if (settings.overlayEnabled) table.Add(SyncCrosshair);
+        if (settings.overlayEnabled && settings.infoCardsEnabled) table.Add(SyncInfoCard);
+        if (settings.overlayEnabled && settings.markersEnabled) table.Add(SyncMarkers);
+        if (settings.menuEnabled || settings.overlayEnabled) table.Add(RenderUI);
+        if (settings.overlayEnabled) table.Add(EndPresentLatency);
+        table.generation = settings.generation;
+
+        // A menu left open would keep swallowing input it no longer draws for
+        auto* menu = Menu::GetSingleton();
+        if (!settings.menuEnabled && menu->menuToggle.exchange(false) && UIRenderer::GetSingleton()->IsInitialized()) {
+            ImGui::GetIO().MouseDrawCursor = false;
+        }
+    }
+
+    // Input handlers return true to hide the events from the game
+    bool HandleMenuInput(RE::InputEvent* const* events) {
+        auto* menu = Menu::GetSingleton();
+        menu->ProcessInputEvents(events);
+        return menu->ShouldSwallowInput();
+    }
+
+    DispatchTable<bool (*)(RE::InputEvent* const*), 1> inputTable;
+
+    void BuildInputTable(const Settings::Snapshot& settings) {
+        auto& table = inputTable;
+        table.count = 0;
+        if (settings.menuEnabled) table.Add(HandleMenuInput);
+        table.generation = settings.generation;
+    }
+
+    struct PresentHook {
+        static HRESULT WINAPI thunk(IDXGISwapChain* a_swapChain, UINT a_syncInterval, UINT a_flags) {
+            {
+                TRACE_SCOPE("HookManager::Present");
+                const int64_t start = Metrics::NowNs();
+                const Settings::Snapshot& settings = Settings::Get();
+                if (presentTable.generation != settings.generation) {
+                    BuildPresentTable(settings);
+                }
+                for (uint32_t i = 0; i < presentTable.count; i++) {
+                    presentTable.steps[i]();
+                }
+                HookManager::GetSingleton()->Record(HookManager::Hook::kPresent, Metrics::NowNs() - start);
+            }
+            return func(a_swapChain, a_syncInterval, a_flags);
+        }
+        static inline decltype(&thunk) func;
+    };
+
+    struct InputHook {
+        static void thunk(RE::BSTEventSource<RE::InputEvent*>* a_dispatcher, RE::InputEvent* const* a_events) {
+            const Settings::Snapshot& settings = Settings::Get();
+            if (inputTable.generation != settings.generation) {
+                BuildInputTable(settings);
+            }
+            if (inputTable.count == 0 || !a_events) {
+                func(a_dispatcher, a_events);
+                return;
+            }
+
+            const int64_t start = Metrics::NowNs();
+            bool swallow = false;
+            for (uint32_t i = 0; i < inputTable.count; i++) {
+                swallow |= inputTable.steps[i](a_events);
+            }
+            HookManager::GetSingleton()->Record(HookManager::Hook::kInput, Metrics::NowNs() - start);
+
+            // The game still gets a dispatch, just with nothing in it
+            constexpr RE::InputEvent* const kNoEvents[] = { nullptr };
+            func(a_dispatcher, swallow ? kNoEvents : a_events);
+        }
+        static inline REL::Relocation<decltype(thunk)> func;
+    };
+}
+
+bool HookManager::Install() {
+    auto& present = installed[static_cast<std::size_t>(Hook::kPresent)];
+    auto& input = installed[static_cast<std::size_t>(Hook::kInput)];
+    if (present && input) return true;
+
+    if (!present) {
+        auto* window = RE::BSGraphics::Renderer::GetCurrentRenderWindow();
+        if (!window || !window->swapChain) {
+            logger::error("Cannot install Present hook: no swap chain yet.");
+        } else {
+            stl::detour_vfunc<8, PresentHook>(window->swapChain); // IDXGISwapChain::Present
+            present = PresentHook::func != nullptr;
+            if (!present) {
+                logger::error("Failed to install Present hook.");
+            }
+        }
+    }
+
+    if (!input) {
+        // The call that hands a frame's input events to the dispatcher's sinks
+        REL::Relocation<std::uintptr_t> target{ REL::RelocationID(67315, 68617), REL::Relocate(0x7B, 0x7B, 0x81) };
+        stl::write_thunk_call<InputHook>(target.address());
+        input = true;
+    }
+
+    logger::info("Hooks installed: Present {}, input {}", present, input);
+    return present && input;
+}
+
+bool HookManager::IsFeatureEnabled(Feature feature) {
+    const Settings::Snapshot settings = Settings::Get();
+    switch (feature) {
+        case Feature::kOverlay: return settings.overlayEnabled;
+        case Feature::kMenu:    return settings.menuEnabled;
+        case Feature::kTracing: return settings.tracingEnabled;
+        default:                return false;
+    }
+}
+
+const char* HookManager::GetHookName(Hook hook) {
+    switch (hook) {
+        case Hook::kPresent: return "Present";
+        case Hook::kInput:   return "Input";
+        default:             return "Unknown";
+    }
+}
+
+void HookManager::Record(Hook hook, int64_t elapsedNs) {
+    // Single writer per hook, so plain load/store rather than read-modify-write
+    Counters& c = counters[static_cast<std::size_t>(hook)];
+    const auto ns = static_cast<uint64_t>(elapsedNs > 0 ? elapsedNs : 0);
+    c.calls.store(c.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    c.totalNs.store(c.totalNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    if (ns > c.maxNs.load(std::memory_order_relaxed)) {
+        c.maxNs.store(ns, std::memory_order_relaxed);
+    }
+}
+
+HookManager::HookStats HookManager::GetStats(Hook hook) const {
+    const Counters& c = counters[static_cast<std::size_t>(hook)];
+    HookStats stats;
+    stats.calls = c.calls.load(std::memory_order_relaxed);
+    stats.totalNs = c.totalNs.load(std::memory_order_relaxed);
+    stats.maxNs = c.maxNs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void HookManager::ResetStats() {
+    // Racy against the hooks by design: a call landing mid-reset is at worst half counted
+    for (auto& c : counters) {
+        c.calls.store(0, std::memory_order_relaxed);
+        c.totalNs.store(0, std::memory_order_relaxed);
+        c.maxNs.store(0, std::memory_order_relaxed);
+    }
+}
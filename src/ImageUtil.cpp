@@ -0,0 +1,205 @@
+#include "ImageUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace ImageUtil {
+    namespace {
+        constexpr std::size_t kTgaHeaderSize = 18;
+        constexpr uint32_t kMaxDimension = 16384;
+
+        enum TgaType : uint8_t {
+            kTrueColor = 2,
+            kGrayscale = 3,
+            kTrueColorRle = 10,
+            kGrayscaleRle = 11
+        };
+
+        uint16_t ReadU16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+
+        // One file pixel (1, 3 or 4 bytes, already B,G,R order) -> straight BGRA
+        template <std::size_t BytesPerPixel>
+        void ToBgra(const uint8_t* src, uint8_t* dst) {
+            if constexpr (BytesPerPixel == 1) {
+                dst[0] = dst[1] = dst[2] = src[0];
+                dst[3] = 0xFF;
+            } else if constexpr (BytesPerPixel == 3) {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = 0xFF;
+            } else {
+                std::memcpy(dst, src, 4);
+            }
+        }
+
+        // Walks the destination in file order, which is bottom-up unless the descriptor says otherwise
+        class RowCursor {
+            public:
+                RowCursor(Image& image, bool topDown) :
+                    pixels(image.pixels.data()), width(image.width), height(image.height), topDown(topDown) {
+                    row = RowStart();
+                }
+
+                bool Done() const { return y == height; }
+                uint8_t* Next() {
+                    uint8_t* dst = row + x * 4;
+                    if (++x == width) {
+                        x = 0;
+                        if (++y < height) row = RowStart();
+                    }
+                    return dst;
+                }
+                uint8_t* Row() const { return row; }
+                void NextRow() {
+                    if (++y < height) row = RowStart();
+                }
+
+            private:
+                uint8_t* RowStart() const {
+                    const uint32_t dstY = topDown ? y : height - 1 - y;
+                    return pixels + static_cast<std::size_t>(dstY) * width * 4;
+                }
+
+                uint8_t* pixels;
+                uint32_t width;
+                uint32_t height;
+                bool topDown;
+                uint32_t x = 0;
+                uint32_t y = 0;
+                uint8_t* row = nullptr;
+        };
+
+        template <std::size_t BytesPerPixel>
+        bool DecodeRaw(const uint8_t* src, const uint8_t* end, RowCursor& cursor, uint32_t width) {
+            const std::size_t rowBytes = static_cast<std::size_t>(width) * BytesPerPixel;
+            while (!cursor.Done()) {
+                if (static_cast<std::size_t>(end - src) < rowBytes) return false;
+                uint8_t* dst = cursor.Row();
+                if constexpr (BytesPerPixel == 4) {
+                    std::memcpy(dst, src, rowBytes);
+                } else {
+                    for (uint32_t x = 0; x < width; x++) {
+                        ToBgra<BytesPerPixel>(src + x * BytesPerPixel, dst + x * 4);
+                    }
+                }
+                src += rowBytes;
+                cursor.NextRow();
+            }
+            return true;
+        }
+
+        // Packets may run across row ends; plenty of writers emit them that way
+        template <std::size_t BytesPerPixel>
+        bool DecodeRle(const uint8_t* src, const uint8_t* end, RowCursor& cursor) {
+            while (!cursor.Done()) {
+                if (src >= end) return false;
+                const uint8_t packet = *src++;
+                uint32_t count = (packet & 0x7F) + 1u;
+
+                if (packet & 0x80) {
+                    if (static_cast<std::size_t>(end - src) < BytesPerPixel) return false;
+                    uint8_t pixel[4];
+                    ToBgra<BytesPerPixel>(src, pixel);
+                    src += BytesPerPixel;
+                    while (count-- && !cursor.Done()) {
+                        std::memcpy(cursor.Next(), pixel, 4);
+                    }
+                } else {
+                    if (static_cast<std::size_t>(end - src) < count * BytesPerPixel) return false;
+                    while (count-- && !cursor.Done()) {
+                        ToBgra<BytesPerPixel>(src, cursor.Next());
+                        src += BytesPerPixel;
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
+    bool DecodeTga(const uint8_t* data, std::size_t size, Image& image) {
+        if (!data || size < kTgaHeaderSize) return false;
+
+        const uint8_t idLength = data[0];
+        const uint8_t colorMapType = data[1];
+        const uint8_t type = data[2];
+        const uint16_t colorMapLength = ReadU16(data + 5);
+        const uint8_t colorMapEntryBits = data[7];
+        const uint32_t width = ReadU16(data + 12);
+        const uint32_t height = ReadU16(data + 14);
+        const uint8_t depth = data[16];
+        const uint8_t descriptor = data[17];
+
+        const bool rle = type == kTrueColorRle || type == kGrayscaleRle;
+        const bool gray = type == kGrayscale || type == kGrayscaleRle;
+        if (type != kTrueColor && type != kTrueColorRle && !gray) return false;
+        if (gray ? depth != 8 : (depth != 24 && depth != 32)) return false;
+        if (colorMapType > 1) return false;
+        if (width == 0 || height == 0 || width > kMaxDimension || height > kMaxDimension) return false;
+
+        // Truecolor files may still carry a (unused) colour map; skip it along with the ID field
+        const std::size_t colorMapBytes = colorMapType ? colorMapLength * ((colorMapEntryBits + 7u) / 8u) : 0;
+        const std::size_t offset = kTgaHeaderSize + idLength + colorMapBytes;
+        if (offset > size) return false;
+
+        image.width = width;
+        image.height = height;
+        image.pixels.resize(static_cast<std::size_t>(width) * height * 4);
+
+        const uint8_t* src = data + offset;
+        const uint8_t* end = data + size;
+        RowCursor cursor(image, (descriptor & 0x20) != 0);
+
+        bool ok = false;
+        switch (depth) {
+            case 8:  ok = rle ? DecodeRle<1>(src, end, cursor) : DecodeRaw<1>(src, end, cursor, width); break;
+            case 24: ok = rle ? DecodeRle<3>(src, end, cursor) : DecodeRaw<3>(src, end, cursor, width); break;
+            case 32: ok = rle ? DecodeRle<4>(src, end, cursor) : DecodeRaw<4>(src, end, cursor, width); break;
+        }
+        if (!ok) return false;
+
+        // Right-to-left rows are rare enough to fix up afterwards
+        if (descriptor & 0x10) {
+            auto* pixels = reinterpret_cast<uint32_t*>(image.pixels.data());
+            for (uint32_t y = 0; y < height; y++) {
+                std::reverse(pixels + static_cast<std::size_t>(y) * width, pixels + static_cast<std::size_t>(y + 1) * width);
+            }
+        }
+        if (depth == 32) {
+            PremultiplyAlpha(image.pixels.data(), static_cast<std::size_t>(width) * height);
+        }
+        return true;
+    }
+
+    bool LoadTga(const std::filesystem::path& path, Image& image) {
+        std::FILE* file = std::fopen(path.string().c_str(), "rb");
+        if (!file) return false;
+
+        Memory::Vector<uint8_t, Memory::Tag::kTextures> data;
+        bool ok = std::fseek(file, 0, SEEK_END) == 0;
+        const long size = ok ? std::ftell(file) : -1;
+        ok = size > 0 && std::fseek(file, 0, SEEK_SET) == 0;
+        if (ok) {
+            data.resize(static_cast<std::size_t>(size));
+            ok = std::fread(data.data(), 1, data.size(), file) == data.size();
+        }
+        std::fclose(file);
+        return ok && DecodeTga(data.data(), data.size(), image);
+    }
+
+    void PremultiplyAlpha(uint8_t* bgra, std::size_t pixelCount) {
+        // Blue and red are scaled together in one 32-bit multiply (two 16-bit lanes), green on its
+        // own; (t + (t >> 8)) >> 8 is round(c * a / 255) exactly for 8-bit c and a, with no divide
+        for (std::size_t i = 0; i < pixelCount; i++, bgra += 4) {
+            uint32_t pixel;
+            std::memcpy(&pixel, bgra, 4);
+            const uint32_t alpha = pixel >> 24;
+            uint32_t blueRed = (pixel & 0x00FF00FF) * alpha + 0x00800080;
+            blueRed = ((blueRed + ((blueRed >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+            uint32_t green = ((pixel >> 8) & 0xFF) * alpha + 0x80;
+            green = ((green + (green >> 8)) >> 8) & 0xFF;
+            pixel = (alpha << 24) | (green << 8) | blueRed;
+            std::memcpy(bgra, &pixel, 4);
+        }
+    }
+}
@@ -0,0 +1,307 @@
+#include "InfoCardUI.h"
+#include "FormTableCache.h"
+#include "GameWorldView.h"
+#include "HookManager.h"
+#include "JobBridge.h"
+#include "Metrics.h"
+#include "Settings.h"
+#include "StartupProfiler.h"
+#include "Trace.h"
+#include "UIRenderer.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+namespace logger = SKSE::log;
+
+namespace {
+    using StaticEntries = Memory::Vector<InfoCards::StaticInfo, Memory::Tag::kUI>;
+
+    constexpr float kCardGap = 12.0f;       // Between the crosshair and the card
+    constexpr float kCardPadding = 6.0f;
+    constexpr float kCardRounding = 4.0f;
+    constexpr ImU32 kCardBackground = IM_COL32(0, 0, 0, 160);
+    constexpr ImU32 kCardText = IM_COL32(255, 255, 255, 230);
+
+    constexpr const char* kTableCachePath = "Data/SKSE/Plugins/DynamicCrosshairFramework/InfoCardTable.cache";
+    // Bump whenever BuildStaticEntries changes what it gathers, so old caches are rebuilt
+    constexpr uint32_t kTableRulesVersion = 1;
+
+    template <class T>
+    void AddForms(RE::TESDataHandler* dataHandler, StaticEntries& entries) {
+        for (auto* form : dataHandler->GetFormArray<T>()) {
+            if (!form) continue;
+
+            InfoCards::StaticInfo info;
+            info.formID = form->GetFormID();
+            info.value = form->GetGoldValue();
+            info.weight = form->GetWeight();
+            if (const auto* enchantable = form->template As<RE::TESEnchantableForm>(); enchantable && enchantable->formEnchanting) {
+                info.flags |= InfoCards::kEnchanted;
+            }
+            entries.push_back(info);
+        }
+    }
+
+    // Everything a player can pick up and carry
+    StaticEntries BuildStaticEntries(RE::TESDataHandler* dataHandler) {
+        StaticEntries entries;
+        AddForms<RE::TESObjectWEAP>(dataHandler, entries);
+        AddForms<RE::TESObjectARMO>(dataHandler, entries);
+        AddForms<RE::TESObjectBOOK>(dataHandler, entries);
+        AddForms<RE::TESObjectMISC>(dataHandler, entries);
+        AddForms<RE::TESAmmo>(dataHandler, entries);
+        AddForms<RE::TESKey>(dataHandler, entries);
+        AddForms<RE::TESSoulGem>(dataHandler, entries);
+        AddForms<RE::IngredientItem>(dataHandler, entries);
+        AddForms<RE::AlchemyItem>(dataHandler, entries);
+        AddForms<RE::ScrollItem>(dataHandler, entries);
+        return entries;
+    }
+
+    // Active plugins in load order, full then light
+    uint64_t GetLoadOrderKey(RE::TESDataHandler* dataHandler) {
+        FormTableCache::KeyBuilder key(kTableRulesVersion);
+        const auto addFiles = [&key](const RE::BSTArray<RE::TESFile*>& files) {
+            for (const auto* file : files) {
+                if (!file) continue;
+                const std::string_view name = file->GetFilename();
+                std::error_code error;
+                const std::filesystem::path path = std::filesystem::path("Data") / name;
+                const auto size = std::filesystem::file_size(path, error);
+                const auto writeTime = std::filesystem::last_write_time(path, error);
+                key.AddPlugin(name, error ? 0 : size, error ? 0 : writeTime.time_since_epoch().count());
+            }
+        };
+        addFiles(dataHandler->compiledFileCollection.files);
+        addFiles(dataHandler->compiledFileCollection.smallFiles);
+        return key.GetKey();
+    }
+
+    InfoCards::DynamicInfo GatherDynamicInfo(RE::TESObjectREFR* ref) {
+        InfoCards::DynamicInfo info;
+        info.refID = ref->GetFormID();
+        info.count = static_cast<uint32_t>(std::max<int32_t>(ref->extraList.GetCount(), 1));
+
+        const LockInfo lock = GameWorldView{}.GetLockInfo(ref);
+        info.locked = lock.locked;
+        info.lockLevel = lock.level;
+
+        if (const auto* owner = ref->GetOwner()) {
+            const char* name = owner->GetName();
+            if (name && *name) {
+                std::snprintf(info.ownerName.data(), info.ownerName.size(), "%s", name);
+            }
+        }
+        return info;
+    }
+}
+
+bool InfoCardUI::Init() {
+    if (initialized) return true;
+
+    auto* dataHandler = RE::TESDataHandler::GetSingleton();
+    if (!dataHandler) {
+        logger::error("Cannot build info cards: no data handler.");
+        return false;
+    }
+
+    // A cache from an earlier launch with the same load order is mapped as is. Otherwise the table
+    // is built on the job pool while the main menu comes up, and cached for next time; form data
+    // no longer changes after kDataLoaded. Until it lands, cards show without value and weight.
+    const int64_t start = Metrics::NowNs();
+    const uint64_t key = GetLoadOrderKey(dataHandler);
+    const auto cached = FormTableCache::Load(kTableCachePath, key, staticTable);
+    if (cached == FormTableCache::LoadResult::kLoaded) {
+        staticForms.store(static_cast<uint32_t>(staticTable.GetSize()), std::memory_order_relaxed);
+        // Already part of the blocking InfoCardUI phase
+        logger::info("Mapped info card table for {} base forms from cache in {:.2f} ms", staticTable.GetSize(), (Metrics::NowNs() - start) / 1e6);
+    } else {
+        logger::info("Info card table cache {}; rebuilding in the background", FormTableCache::LoadResultName(cached));
+        auto* table = Memory::New<InfoCards::StaticTable>(Memory::Tag::kUI);
+        JobBridge::Run(
+            [table, dataHandler, key] {
+                TRACE_SCOPE("InfoCardUI::BuildStaticTable");
+                table->Build(BuildStaticEntries(dataHandler));
+                if (!FormTableCache::Save(kTableCachePath, key, table->GetEntries())) {
+                    logger::warn("Could not write the info card table cache");
+                }
+            },
+            JobBridge::Target::kGame,
+            [table, start] {
+                auto* infoCard = InfoCardUI::GetSingleton();
+                infoCard->staticTable = std::move(*table);
+                Memory::Delete(table);
+                infoCard->layoutKey = {};   // The card on screen may have been built without it
+                infoCard->staticForms.store(static_cast<uint32_t>(infoCard->staticTable.GetSize()), std::memory_order_relaxed);
+                StartupProfiler::Record("InfoCardTable", StartupProfiler::Kind::kDeferred, start, Metrics::NowNs() - start);
+                logger::info("Built info card table for {} base forms", infoCard->staticTable.GetSize());
+            },
+            {}, JobBridge::Priority::kBackground);
+    }
+
+    if (auto* events = RE::ScriptEventSourceHolder::GetSingleton()) {
+        events->AddEventSink<RE::TESLockChangedEvent>(this);
+        events->AddEventSink<RE::TESContainerChangedEvent>(this);
+        events->AddEventSink<RE::TESCellAttachDetachEvent>(this);
+    } else {
+        logger::warn("No script event source; info cards may show stale lock or owner data");
+    }
+
+    UIRenderer::GetSingleton()->RegisterLayer({
+        "InfoCard",
+        [] {
+            auto* card = InfoCardUI::GetSingleton();
+            return card->visible && Settings::Get().infoCardsEnabled && HookManager::IsFeatureEnabled(HookManager::Feature::kOverlay);
+        },
+        [] { InfoCardUI::GetSingleton()->Draw(); }
+    });
+
+    initialized = true;
+    return true;
+}
+
+void InfoCardUI::OnTargetChanged(RE::TESObjectREFR* ref) {
+    if (!initialized) return;
+    TRACE_SCOPE("InfoCardUI::OnTargetChanged");
+    const int64_t start = Metrics::NowNs();
+
+    currentTarget = ref ? ref->GetHandle() : RE::ObjectRefHandle{};
+    auto* base = ref ? ref->GetBaseObject() : nullptr;
+    if (!base || !Settings::Get().infoCardsEnabled) {
+        if (layoutKey.refID != 0) {
+            layoutKey = {};
+            Publish(nullptr);
+        }
+        return;
+    }
+
+    const InfoCards::StaticInfo* staticInfo = staticTable.Find(base->GetFormID());
+    const InfoCards::DynamicInfo* dynamicInfo = dynamicCache.Find(ref->GetFormID());
+    if (!dynamicInfo) {
+        dynamicInfo = &dynamicCache.Insert(GatherDynamicInfo(ref));
+    }
+
+    // Carryable items, and containers or anything else that is locked
+    const bool shown = staticInfo || dynamicInfo->locked || base->Is(RE::FormType::Container);
+    const LayoutKey key{ shown ? ref->GetFormID() : 0u, shown ? dynamicCache.GetGeneration() : UINT32_MAX };
+    if (key != layoutKey) {
+        layoutKey = key;
+        if (shown) {
+            InfoCards::FormatLayout(ref->GetName(), staticInfo, *dynamicInfo, layout);
+            layoutsBuilt.fetch_add(1, std::memory_order_relaxed);
+            Publish(&layout);
+        } else {
+            Publish(nullptr);
+        }
+    }
+
+    const auto& cacheStats = dynamicCache.GetStats();
+    cacheHits.store(cacheStats.hits, std::memory_order_relaxed);
+    cacheMisses.store(cacheStats.misses, std::memory_order_relaxed);
+    invalidations.store(cacheStats.invalidations, std::memory_order_relaxed);
+    lastUpdateNs.store(Metrics::NowNs() - start, std::memory_order_relaxed);
+}
+
+void InfoCardUI::OnGameLoaded() {
+    dynamicCache.Clear();
+    layoutKey = {};
+    currentTarget.reset();
+    Publish(nullptr);
+}
+
+void InfoCardUI::Invalidate(uint32_t refID) {
+    if (!dynamicCache.Invalidate(refID)) return;
+
+    // The card on screen may be the one that just went stale
+    if (const auto target = currentTarget.get(); target && target->GetFormID() == refID) {
+        OnTargetChanged(target.get());
+    }
+}
+
+void InfoCardUI::Publish(const InfoCards::Layout* card) {
+    std::lock_guard lock(publishMutex);
+    publishedVisible = card != nullptr;
+    if (card) {
+        published = *card;
+    }
+    publishedVersion.fetch_add(1, std::memory_order_release);
+}
+
+void InfoCardUI::SyncWithGame() {
+    const uint32_t version = publishedVersion.load(std::memory_order_acquire);
+    if (version == drawnVersion) return;
+
+    {
+        std::lock_guard lock(publishMutex);
+        drawnVersion = publishedVersion.load(std::memory_order_relaxed);
+        visible = publishedVisible;
+        drawn = published;
+    }
+    measured = false;
+    UIRenderer::GetSingleton()->Invalidate();
+}
+
+void InfoCardUI::Draw() {
+    // Text is measured once per layout, inside a frame where the font is bound
+    if (!measured) {
+        cardSize = ImVec2(0.0f, 0.0f);
+        for (uint32_t i = 0; i < drawn.lineCount; i++) {
+            lineSizes[i] = ImGui::CalcTextSize(drawn.lines[i].data());
+            cardSize.x = std::max(cardSize.x, lineSizes[i].x);
+            cardSize.y += lineSizes[i].y;
+        }
+        cardSize.x += kCardPadding * 2.0f;
+        cardSize.y += kCardPadding * 2.0f;
+        measured = true;
+    }
+
+    const ImVec2 displaySize = ImGui::GetIO().DisplaySize;
+    const float top = displaySize.y * 0.5f + Settings::Get().crosshairSize * 0.5f + kCardGap;
+    const float left = (displaySize.x - cardSize.x) * 0.5f;
+
+    auto* drawList = ImGui::GetBackgroundDrawList();
+    drawList->AddRectFilled(ImVec2(left, top), ImVec2(left + cardSize.x, top + cardSize.y), kCardBackground, kCardRounding);
+    float y = top + kCardPadding;
+    for (uint32_t i = 0; i < drawn.lineCount; i++) {
+        // Lines are centred under the crosshair
+        drawList->AddText(ImVec2((displaySize.x - lineSizes[i].x) * 0.5f, y), kCardText, drawn.lines[i].data());
+        y += lineSizes[i].y;
+    }
+}
+
+InfoCardUI::Stats InfoCardUI::GetStats() const {
+    Stats stats;
+    stats.staticForms = staticForms.load(std::memory_order_relaxed);
+    stats.cacheHits = cacheHits.load(std::memory_order_relaxed);
+    stats.cacheMisses = cacheMisses.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations.load(std::memory_order_relaxed);
+    stats.layoutsBuilt = layoutsBuilt.load(std::memory_order_relaxed);
+    stats.lastUpdateNs = lastUpdateNs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+RE::BSEventNotifyControl InfoCardUI::ProcessEvent(const RE::TESLockChangedEvent* a_event, RE::BSTEventSource<RE::TESLockChangedEvent>*) {
+    if (a_event && a_event->lockedObject) {
+        Invalidate(a_event->lockedObject->GetFormID());
+    }
+    return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl InfoCardUI::ProcessEvent(const RE::TESContainerChangedEvent* a_event, RE::BSTEventSource<RE::TESContainerChangedEvent>*) {
+    // A world item that was picked up, dropped or had its stack split
+    if (a_event && a_event->reference) {
+        if (const auto ref = a_event->reference.get()) {
+            Invalidate(ref->GetFormID());
+        }
+    }
+    return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl InfoCardUI::ProcessEvent(const RE::TESCellAttachDetachEvent* a_event, RE::BSTEventSource<RE::TESCellAttachDetachEvent>*) {
+    // Created references get their IDs recycled once unloaded
+    if (a_event && !a_event->attached && a_event->reference) {
+        Invalidate(a_event->reference->GetFormID());
+    }
+    return RE::BSEventNotifyControl::kContinue;
+}
@@ -0,0 +1,117 @@
+#include "InfoCards.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace InfoCards {
+    void StaticTable::Build(Memory::Vector<StaticInfo, Memory::Tag::kUI>&& built) {
+        entries = std::move(built);
+        std::sort(entries.begin(), entries.end(), [](const StaticInfo& a, const StaticInfo& b) { return a.formID < b.formID; });
+        entries.shrink_to_fit();
+        mapping.Close();
+        view = entries;
+    }
+
+    void StaticTable::Adopt(MappedFile&& file, std::span<const StaticInfo> sorted) {
+        entries = {};
+        mapping = std::move(file);
+        view = sorted;
+    }
+
+    const StaticInfo* StaticTable::Find(uint32_t formID) const {
+        const auto it = std::lower_bound(view.begin(), view.end(), formID,
+            [](const StaticInfo& entry, uint32_t id) { return entry.formID < id; });
+        return it != view.end() && it->formID == formID ? &*it : nullptr;
+    }
+
+    const DynamicInfo* DynamicCache::Find(uint32_t refID) {
+        for (uint32_t i = 0; i < kCapacity; i++) {
+            if (keys[i] == refID && refID != 0) {
+                lastUse[i] = ++useClock;
+                stats.hits++;
+                return &infos[i];
+            }
+        }
+        stats.misses++;
+        return nullptr;
+    }
+
+    const DynamicInfo& DynamicCache::Insert(const DynamicInfo& info) {
+        // Same ref, then a free slot, then the least recently used one
+        uint32_t slot = kCapacity;
+        for (uint32_t i = 0; i < kCapacity && slot == kCapacity; i++) {
+            if (keys[i] == info.refID) slot = i;
+        }
+        if (slot == kCapacity) {
+            slot = static_cast<uint32_t>(std::min_element(lastUse.begin(), lastUse.end()) - lastUse.begin());
+            if (keys[slot] != 0) {
+                stats.evictions++;
+            }
+        }
+
+        keys[slot] = info.refID;
+        lastUse[slot] = ++useClock;
+        infos[slot] = info;
+        generation++;
+        return infos[slot];
+    }
+
+    bool DynamicCache::Invalidate(uint32_t refID) {
+        for (uint32_t i = 0; i < kCapacity; i++) {
+            if (keys[i] == refID && refID != 0) {
+                keys[i] = 0;
+                lastUse[i] = 0;   // Free slots are reused first
+                generation++;
+                stats.invalidations++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void DynamicCache::Clear() {
+        keys.fill(0);
+        lastUse.fill(0);
+        generation++;
+    }
+
+    const char* LockLevelName(LockLevel level) {
+        switch (level) {
+            case LockLevel::kVeryEasy:    return "Novice";
+            case LockLevel::kEasy:        return "Apprentice";
+            case LockLevel::kAverage:     return "Adept";
+            case LockLevel::kHard:        return "Expert";
+            case LockLevel::kVeryHard:    return "Master";
+            case LockLevel::kRequiresKey: return "Requires key";
+            default:                      return "Unlocked";
+        }
+    }
+
+    void FormatLayout(const char* name, const StaticInfo* staticInfo, const DynamicInfo& dynamicInfo, Layout& layout) {
+        layout.lineCount = 0;
+        const auto line = [&layout]() -> char* {
+            return layout.lines[layout.lineCount++].data();
+        };
+        constexpr std::size_t kLength = Layout::kLineLength;
+
+        std::snprintf(line(), kLength, "%s", name && *name ? name : "Unknown");
+
+        if (staticInfo) {
+            char* text = line();
+            if (dynamicInfo.count > 1) {
+                std::snprintf(text, kLength, "Value %d  Weight %.1f  x%u", staticInfo->value, staticInfo->weight, dynamicInfo.count);
+            } else {
+                std::snprintf(text, kLength, "Value %d  Weight %.1f", staticInfo->value, staticInfo->weight);
+            }
+            if (staticInfo->flags & kEnchanted) {
+                std::snprintf(line(), kLength, "Enchanted");
+            }
+        }
+
+        if (dynamicInfo.locked && layout.lineCount < Layout::kMaxLines) {
+            std::snprintf(line(), kLength, "Lock: %s", LockLevelName(dynamicInfo.lockLevel));
+        }
+        if (dynamicInfo.ownerName[0] && layout.lineCount < Layout::kMaxLines) {
+            std::snprintf(line(), kLength, "Owner: %s", dynamicInfo.ownerName.data());
+        }
+    }
+}
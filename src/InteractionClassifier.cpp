@@ -0,0 +1,107 @@
+#include "InteractionClassifier.h"
+
+const char* InteractionTypeName(InteractionType type) {
+    switch (type) {
+        case InteractionType::kNone:         return "None";
+        case InteractionType::kTalk:         return "Talk";
+        case InteractionType::kOpen:         return "Open";
+        case InteractionType::kActivate:     return "Activate";
+        case InteractionType::kTake:         return "Take";
+        case InteractionType::kHarvest:      return "Harvest";
+        case InteractionType::kSearch:       return "Search";
+        case InteractionType::kSit:          return "Sit";
+        case InteractionType::kSleep:        return "Sleep";
+        case InteractionType::kPickpocket:   return "Pickpocket";
+        case InteractionType::kLockpick:     return "Lockpick";
+        case InteractionType::kLockpickNone: return "LockpickNone";
+        case InteractionType::kRequiresKey:  return "RequiresKey";
+        case InteractionType::kUseKey:       return "UseKey";
+        case InteractionType::kRead:         return "Read";
+        case InteractionType::kDoor:         return "Door";
+        case InteractionType::kSteal:        return "Steal";
+        default:                             return "Unknown";
+    }
+}
+
+uint32_t GetActivationFlags(const TargetFacts& facts) {
+    if (!facts.hasRef || !facts.hasBase) return 0;
+
+    uint32_t flags = 0;
+    if (facts.Is(BaseType::kNPC)) {
+        flags |= 0x01;  // Talk flag
+    }
+    if (facts.Is(BaseType::kContainer)) {
+        flags |= 0x02;  // Container flag
+    }
+    if (facts.Is(BaseType::kDoor)) {
+        flags |= 0x02;  // Use door flag (same as container)
+        if (facts.locked) {
+            flags |= 0x08;  // Unlock flag
+        }
+    }
+    if (facts.Is(BaseType::kBook)) {
+        flags |= 0x04;  // Read flag
+    }
+    if (facts.Is(BaseType::kFurniture)) {
+        flags |= 0x10;  // Use object (furniture) flag
+    }
+    if (facts.Is(BaseType::kFlora) || facts.Is(BaseType::kTree) || facts.Is(BaseType::kActivator)) {
+        flags |= 0x20;  // Harvest/Activate flag
+    }
+    return flags;
+}
+
+InteractionType ClassifyInteraction(const TargetFacts& facts) {
+    if (!facts.hasRef) return InteractionType::kNone;
+
+    const uint32_t flags = GetActivationFlags(facts);
+    if (flags == 0) return InteractionType::kNone;
+
+    // Talk flag (0x01)
+    if (flags & 0x01) {
+        // Sneaking turns talking into pickpocketing
+        return facts.playerSneaking ? InteractionType::kPickpocket : InteractionType::kTalk;
+    }
+
+    // Container/Door flag (0x02)
+    if (flags & 0x02) {
+        // Dead body
+        if (facts.Is(BaseType::kActorCharacter) && facts.dead) {
+            return InteractionType::kSearch;
+        }
+        if (facts.Is(BaseType::kDoor) && facts.locked) {
+            if (facts.lockLevel == LockLevel::kRequiresKey) {
+                // Check if player has key - for now just return open
+                return InteractionType::kOpen;
+            }
+            if (facts.lockLevel >= LockLevel::kVeryEasy && facts.lockLevel <= LockLevel::kVeryHard) {
+                return facts.lockpickCount > 0 ? InteractionType::kLockpick : InteractionType::kLockpickNone;
+            }
+        }
+        // Unlocked doors and containers
+        return InteractionType::kOpen;
+    }
+
+    // Take/Read flag (0x04)
+    if (flags & 0x04) {
+        return InteractionType::kTake;
+    }
+
+    // Unlock flag (0x08)
+    if (flags & 0x08) {
+        return InteractionType::kLockpick;
+    }
+
+    // Furniture flag (0x10)
+    if (flags & 0x10) {
+        return InteractionType::kSit;
+    }
+
+    // Harvest/Activate flag (0x20)
+    if ((flags & 0x20) && facts.Is(BaseType::kFlora)) {
+        return InteractionType::kHarvest;
+    }
+
+    // Default generic activation
+    return InteractionType::kActivate;
+}
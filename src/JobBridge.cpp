@@ -0,0 +1,87 @@
+#include "JobBridge.h"
+#include "Settings.h"
+#include "Trace.h"
+#include "SKSE/API.h"
+#include <atomic>
+#include <chrono>
+
+namespace logger = SKSE::log;
+
+namespace JobBridge {
+    namespace {
+        FrameScheduler gameScheduler{ "Game" };
+        FrameScheduler renderScheduler{ "Render" };
+
+        // Set while a pump task sits in SKSE's queue, so at most one is ever queued
+        std::atomic<bool> gamePumpQueued = false;
+
+        void QueueGamePump();
+
+        void PumpGame() {
+            TRACE_SCOPE("JobBridge::PumpGame");
+            gameScheduler.RunFrame();
+            // Cleared before the recheck: a post racing with this either sees the flag down
+            // and queues the pump itself, or its task is counted below
+            gamePumpQueued.store(false);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (gameScheduler.GetPendingCount() > 0) {
+                QueueGamePump();
+            }
+        }
+
+        void QueueGamePump() {
+            if (gamePumpQueued.exchange(true)) return;
+
+            auto* tasks = SKSE::GetTaskInterface();
+            if (!tasks) {
+                gamePumpQueued.store(false);
+                logger::error("SKSE task interface unavailable; game-thread callbacks will not run");
+                return;
+            }
+            tasks->AddTask(PumpGame);
+        }
+    }
+
+    FrameScheduler& GetScheduler(Target target) {
+        return target == Target::kRender ? renderScheduler : gameScheduler;
+    }
+
+    bool Post(Target target, Callback callback, Priority priority) {
+        if (!GetScheduler(target).Post(priority, std::move(callback))) {
+            logger::warn("{} scheduler queue full; dropping callback", GetScheduler(target).GetName());
+            return false;
+        }
+        if (target == Target::kGame) {
+            QueueGamePump();
+        }
+        return true;
+    }
+
+    Jobs::JobHandle Run(Jobs::Function work, Target target, Callback completion, Jobs::CancellationToken token, Priority priority) {
+        const Jobs::JobHandle workHandle = Jobs::Schedule(std::move(work), token);
+        return Jobs::Then(workHandle, [target, priority, completion = std::move(completion)]() mutable {
+            Post(target, std::move(completion), priority);
+        }, std::move(token));
+    }
+
+    void RunRenderFrame() {
+        // Present paces the game, so its interval is the frame time for both schedulers
+        static std::chrono::steady_clock::time_point lastPresent{};
+        const auto now = std::chrono::steady_clock::now();
+        if (lastPresent != std::chrono::steady_clock::time_point{}) {
+            const float frameMs = std::chrono::duration<float, std::milli>(now - lastPresent).count();
+            renderScheduler.RecordFrameTime(frameMs);
+            gameScheduler.RecordFrameTime(frameMs);
+        }
+        lastPresent = now;
+
+        const uint32_t budgetUs = Settings::Get().frameBudgetUs;
+        renderScheduler.SetBudgetUs(budgetUs);
+        gameScheduler.SetBudgetUs(budgetUs);
+
+        if (renderScheduler.GetPendingCount() == 0) return;
+
+        TRACE_SCOPE("JobBridge::RunRenderFrame");
+        renderScheduler.RunFrame();
+    }
+}
@@ -0,0 +1,367 @@
+#include "JobSystem.h"
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Jobs {
+    namespace {
+        // Jobs in flight at once; also the capacity of every queue, so pushes never fail
+        constexpr uint32_t kMaxJobs = 2048;
+        constexpr uint32_t kMaxWorkers = 16;
+
+        class SpinLock {
+            public:
+                void lock() {
+                    while (flag.test_and_set(std::memory_order_acquire)) {
+                        while (flag.test(std::memory_order_relaxed)) {}
+                    }
+                }
+                void unlock() { flag.clear(std::memory_order_release); }
+
+            private:
+                std::atomic_flag flag;
+        };
+
+        // Dependency edge: run `job` once the job holding this node finishes
+        struct Continuation {
+            Job* job;
+            Continuation* next;
+        };
+    }
+
+    struct Job {
+        Function fn;
+        CancellationToken token;
+        std::atomic<int32_t> pendingDependencies{ 0 };
+        // Bumped when the job finishes; a handle whose generation differs is finished
+        std::atomic<uint32_t> generation{ 0 };
+        SpinLock lock;                          // Guards continuations against completion
+        Continuation* continuations = nullptr;
+        Job* nextFree = nullptr;
+    };
+
+    namespace {
+        // Bounded ring of jobs. The owner pushes and pops at the back, thieves take the front.
+        class WorkQueue {
+            public:
+                void PushBack(Job* job) {
+                    std::lock_guard guard(lock);
+                    ring[(head + size++) % kMaxJobs] = job;
+                }
+                Job* PopBack() {
+                    std::lock_guard guard(lock);
+                    if (size == 0) return nullptr;
+                    return ring[(head + --size) % kMaxJobs];
+                }
+                Job* PopFront() {
+                    std::lock_guard guard(lock);
+                    if (size == 0) return nullptr;
+                    Job* job = ring[head];
+                    head = (head + 1) % kMaxJobs;
+                    size--;
+                    return job;
+                }
+
+            private:
+                SpinLock lock;
+                uint32_t head = 0;
+                uint32_t size = 0;
+                std::array<Job*, kMaxJobs> ring{};
+        };
+
+        struct Worker {
+            WorkQueue queue;
+            std::thread thread;
+        };
+
+        struct State {
+            Job* jobs = nullptr;
+            SpinLock freeLock;
+            Job* freeList = nullptr;
+
+            Worker* workers = nullptr;
+            uint32_t workerCount = 0;
+            WorkQueue injected;     // Jobs scheduled from outside the pool
+
+            std::atomic<bool> running = false;
+            std::atomic<uint32_t> queued = 0;
+            std::atomic<uint32_t> sleepers = 0;
+            std::mutex sleepMutex;
+            std::condition_variable sleepCondition;
+
+            std::atomic<uint32_t> waiters = 0;
+            std::mutex waitMutex;
+            std::condition_variable waitCondition;
+
+            std::atomic<uint32_t> inFlight = 0;
+            std::atomic<uint64_t> executed = 0;
+            std::atomic<uint64_t> stolen = 0;
+            std::atomic<uint64_t> cancelled = 0;
+            std::atomic<uint64_t> ranInline = 0;
+        };
+        // Never destroyed: workers may still be parked on its condition variables at process exit
+        State& state = *new State;
+
+        thread_local int32_t currentWorker = -1;
+
+        Job* AllocateJob() {
+            std::lock_guard guard(state.freeLock);
+            Job* job = state.freeList;
+            if (job) {
+                state.freeList = job->nextFree;
+                state.inFlight.fetch_add(1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        void FreeJob(Job* job) {
+            std::lock_guard guard(state.freeLock);
+            job->nextFree = state.freeList;
+            state.freeList = job;
+            state.inFlight.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void Enqueue(Job* job) {
+            // Counted first so FindJob's decrement can never run ahead of it
+            state.queued.fetch_add(1);
+            if (currentWorker >= 0) {
+                state.workers[currentWorker].queue.PushBack(job);
+            } else {
+                state.injected.PushBack(job);
+            }
+            // A sleeper checks `queued` under sleepMutex after announcing itself, so either it
+            // sees this job or we see it and the notify cannot be lost
+            if (state.sleepers.load() > 0) {
+                std::lock_guard guard(state.sleepMutex);
+                state.sleepCondition.notify_one();
+            }
+        }
+
+        Job* FindJob(int32_t self) {
+            Job* job = self >= 0 ? state.workers[self].queue.PopBack() : nullptr;
+            if (!job) {
+                job = state.injected.PopFront();
+            }
+            for (uint32_t i = 1; !job && i <= state.workerCount; i++) {
+                const uint32_t victim = (static_cast<uint32_t>(self + 1) + i - 1) % state.workerCount;
+                if (static_cast<int32_t>(victim) == self) continue;
+                job = state.workers[victim].queue.PopFront();
+                if (job) {
+                    state.stolen.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            if (job) {
+                state.queued.fetch_sub(1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        // Adds `job` as a dependent of `handle`; false if that job has already finished
+        bool AddContinuation(JobHandle handle, Job* job) {
+            if (!handle.job) return false;
+
+            auto* node = Memory::New<Continuation>(Memory::Tag::kJobs, Continuation{ job, nullptr });
+            {
+                std::lock_guard guard(handle.job->lock);
+                if (handle.job->generation.load(std::memory_order_relaxed) == handle.generation) {
+                    node->next = handle.job->continuations;
+                    handle.job->continuations = node;
+                    return true;
+                }
+            }
+            Memory::Delete(node);
+            return false;
+        }
+
+        void Execute(Job* job) {
+            if (job->token.IsCancelled()) {
+                state.cancelled.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                job->fn();
+            }
+            // Drop captures now rather than when the slot is reused
+            job->fn = nullptr;
+            job->token = {};
+
+            Continuation* continuations;
+            {
+                std::lock_guard guard(job->lock);
+                continuations = job->continuations;
+                job->continuations = nullptr;
+                job->generation.fetch_add(1);
+            }
+            FreeJob(job);
+            state.executed.fetch_add(1, std::memory_order_relaxed);
+
+            while (continuations) {
+                Continuation* next = continuations->next;
+                if (continuations->job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    Enqueue(continuations->job);
+                }
+                Memory::Delete(continuations);
+                continuations = next;
+            }
+
+            if (state.waiters.load() > 0) {
+                std::lock_guard guard(state.waitMutex);
+                state.waitCondition.notify_all();
+            }
+        }
+
+        void WorkerMain(uint32_t index, void (*onThreadStart)(uint32_t)) {
+            currentWorker = static_cast<int32_t>(index);
+            if (onThreadStart) {
+                onThreadStart(index);
+            }
+
+            while (state.running.load(std::memory_order_relaxed)) {
+                if (Job* job = FindJob(currentWorker)) {
+                    Execute(job);
+                    continue;
+                }
+
+                std::unique_lock lock(state.sleepMutex);
+                state.sleepers.fetch_add(1);
+                state.sleepCondition.wait(lock, [] {
+                    return state.queued.load() > 0 || !state.running.load(std::memory_order_relaxed);
+                });
+                state.sleepers.fetch_sub(1);
+            }
+        }
+
+        void RunInline(Function& fn, std::span<const JobHandle> dependencies, const CancellationToken& token) {
+            for (const auto& dependency : dependencies) {
+                Wait(dependency);
+            }
+            if (token.IsCancelled()) {
+                state.cancelled.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                fn();
+            }
+            state.ranInline.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool Init(uint32_t workerCount, void (*onThreadStart)(uint32_t index)) {
+        if (state.running.load() || workerCount == 0 || workerCount > kMaxWorkers) return false;
+
+        state.jobs = static_cast<Job*>(Memory::Allocate(sizeof(Job) * kMaxJobs, Memory::Tag::kJobs));
+        state.workers = static_cast<Worker*>(Memory::Allocate(sizeof(Worker) * workerCount, Memory::Tag::kJobs));
+        if (!state.jobs || !state.workers) {
+            Memory::Free(state.jobs);
+            Memory::Free(state.workers);
+            state.jobs = nullptr;
+            state.workers = nullptr;
+            return false;
+        }
+
+        state.freeList = nullptr;
+        for (uint32_t i = kMaxJobs; i-- > 0;) {
+            Job* job = new (&state.jobs[i]) Job();
+            job->nextFree = state.freeList;
+            state.freeList = job;
+        }
+
+        state.workerCount = workerCount;
+        state.running.store(true);
+        for (uint32_t i = 0; i < workerCount; i++) {
+            new (&state.workers[i]) Worker();
+        }
+        for (uint32_t i = 0; i < workerCount; i++) {
+            state.workers[i].thread = std::thread(WorkerMain, i, onThreadStart);
+        }
+        return true;
+    }
+
+    void Shutdown() {
+        if (!state.running.load()) return;
+
+        while (state.inFlight.load() > 0) {
+            std::this_thread::yield();
+        }
+        {
+            std::lock_guard guard(state.sleepMutex);
+            state.running.store(false);
+        }
+        state.sleepCondition.notify_all();
+
+        for (uint32_t i = 0; i < state.workerCount; i++) {
+            state.workers[i].thread.join();
+            state.workers[i].~Worker();
+        }
+        for (uint32_t i = 0; i < kMaxJobs; i++) {
+            state.jobs[i].~Job();
+        }
+        Memory::Free(state.workers);
+        Memory::Free(state.jobs);
+        state.workers = nullptr;
+        state.jobs = nullptr;
+        state.freeList = nullptr;
+        state.workerCount = 0;
+    }
+
+    bool IsRunning() { return state.running.load(std::memory_order_relaxed); }
+    uint32_t GetWorkerCount() { return state.workerCount; }
+    int32_t GetCurrentWorkerIndex() { return currentWorker; }
+
+    JobHandle Schedule(Function fn, std::span<const JobHandle> dependencies, CancellationToken token) {
+        Job* job = state.running.load(std::memory_order_relaxed) ? AllocateJob() : nullptr;
+        if (!job) {
+            RunInline(fn, dependencies, token);
+            return {};
+        }
+
+        job->fn = std::move(fn);
+        job->token = std::move(token);
+        // One extra count holds the job back until every edge is in place
+        job->pendingDependencies.store(static_cast<int32_t>(dependencies.size()) + 1, std::memory_order_relaxed);
+        const JobHandle handle{ job, job->generation.load(std::memory_order_relaxed) };
+
+        for (const auto& dependency : dependencies) {
+            if (!AddContinuation(dependency, job)) {
+                job->pendingDependencies.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+        if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Enqueue(job);
+        }
+        return handle;
+    }
+
+    bool IsFinished(JobHandle handle) {
+        // Sequentially consistent: pairs with the waiter count in Execute so wakeups are not lost
+        return !handle.job || handle.job->generation.load() != handle.generation;
+    }
+
+    void Wait(JobHandle handle) {
+        if (IsFinished(handle)) return;
+
+        // Helping: a worker blocking here could starve the very job it waits on
+        if (currentWorker >= 0) {
+            while (!IsFinished(handle)) {
+                if (Job* job = FindJob(currentWorker)) {
+                    Execute(job);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            return;
+        }
+
+        std::unique_lock lock(state.waitMutex);
+        state.waiters.fetch_add(1);
+        state.waitCondition.wait(lock, [handle] { return IsFinished(handle); });
+        state.waiters.fetch_sub(1);
+    }
+
+    Stats GetStats() {
+        Stats stats;
+        stats.executed = state.executed.load(std::memory_order_relaxed);
+        stats.stolen = state.stolen.load(std::memory_order_relaxed);
+        stats.cancelled = state.cancelled.load(std::memory_order_relaxed);
+        stats.ranInline = state.ranInline.load(std::memory_order_relaxed);
+        stats.inFlight = state.inFlight.load(std::memory_order_relaxed);
+        return stats;
+    }
+}
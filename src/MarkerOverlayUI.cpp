@@ -0,0 +1,208 @@
+#include "MarkerOverlayUI.h"
+#include "GameWorldView.h"
+#include "HookManager.h"
+#include "JobBridge.h"
+#include "Metrics.h"
+#include "Settings.h"
+#include "Trace.h"
+#include "UIRenderer.h"
+#include "imgui.h"
+#include <algorithm>
+#include <array>
+
+namespace logger = SKSE::log;
+
+namespace {
+    // Corpses and containers do not wander off; a few gathers a second keep up with the player
+    constexpr int64_t kGatherIntervalNs = 250'000'000;
+    constexpr float kMarkerLift = 32.0f;        // Game units above the reference's origin
+    constexpr float kNearSize = 9.0f;           // Half the diamond's width in pixels, up close
+    constexpr float kFarSize = 4.0f;            // And at the edge of the radius
+
+    constexpr std::array<ImU32, Markers::kKindCount> kKindColors = {
+        IM_COL32(220, 220, 220, 255),   // Corpse
+        IM_COL32(120, 220, 120, 255),   // Harvest
+        IM_COL32(235, 190, 80, 255)     // Locked
+    };
+
+    // Same markers in the same places, so the cached overlay frame is still right
+    bool SameOutput(const Markers::ScreenMarkers& a, const Markers::ScreenMarkers& b) {
+        const auto count = static_cast<std::ptrdiff_t>(a.count);
+        return a.count == b.count &&
+               std::equal(a.x.begin(), a.x.begin() + count, b.x.begin()) &&
+               std::equal(a.y.begin(), a.y.begin() + count, b.y.begin()) &&
+               std::equal(a.distance.begin(), a.distance.begin() + count, b.distance.begin()) &&
+               std::equal(a.source.begin(), a.source.begin() + count, b.source.begin());
+    }
+
+    bool IsHarvested(const RE::TESObjectREFR& ref) {
+        return (ref.formFlags & RE::TESObjectREFR::RecordFlags::kHarvested) != 0;
+    }
+
+    // Plenty of flora and most trees are scenery with nothing to pick
+    bool HasProduce(const RE::TESObjectREFR& ref) {
+        const auto* base = ref.GetBaseObject();
+        const auto* produce = base ? base->As<RE::TESProduceForm>() : nullptr;
+        return produce && produce->produceItem;
+    }
+}
+
+bool MarkerOverlayUI::Init() {
+    if (initialized) return true;
+
+    UIRenderer::GetSingleton()->RegisterLayer({
+        "Markers",
+        [] {
+            auto* overlay = MarkerOverlayUI::GetSingleton();
+            return overlay->GetScreen().count > 0 && Settings::Get().markersEnabled && HookManager::IsFeatureEnabled(HookManager::Feature::kOverlay);
+        },
+        [] { MarkerOverlayUI::GetSingleton()->Draw(); }
+    });
+
+    initialized = true;
+    return true;
+}
+
+void MarkerOverlayUI::Gather() {
+    TRACE_SCOPE("MarkerOverlayUI::Gather");
+    const int64_t start = Metrics::NowNs();
+
+    gathering.Clear();
+    auto* player = RE::PlayerCharacter::GetSingleton();
+    auto* tes = RE::TES::GetSingleton();
+    if (player && tes && player->Is3DLoaded()) {
+        // One pass over the loaded cells; classification reads only what each base type needs
+        const GameWorldView world;
+        tes->ForEachReferenceInRange(player, Settings::Get().markerRadius, [&](RE::TESObjectREFR& ref) {
+            if (&ref == player || ref.IsDisabled() || ref.IsDeleted() || !ref.Is3DLoaded()) {
+                return RE::BSContainer::ForEachResult::kContinue;
+            }
+
+            TargetFacts facts = GatherFacts(world, &ref);
+            if (facts.Is(BaseType::kContainer)) {
+                const LockInfo lock = world.GetLockInfo(&ref);
+                facts.locked = lock.locked;
+                facts.lockLevel = lock.level;
+            } else if (facts.Is(BaseType::kNPC)) {
+                facts.dead = world.IsDead(&ref);
+            }
+            const auto kind = Markers::Classify(facts);
+            if (!kind || (*kind == Markers::Kind::kHarvest && (IsHarvested(ref) || !HasProduce(ref)))) {
+                return RE::BSContainer::ForEachResult::kContinue;
+            }
+
+            const RE::NiPoint3 position = ref.GetPosition();
+            return gathering.Add(facts.formID, *kind, position.x, position.y, position.z + kMarkerLift) ?
+                RE::BSContainer::ForEachResult::kContinue : RE::BSContainer::ForEachResult::kStop;
+        });
+    }
+
+    {
+        std::lock_guard lock(publishMutex);
+        published = gathering;
+        publishedVersion.fetch_add(1, std::memory_order_release);
+    }
+    gatherPending.store(false, std::memory_order_release);
+
+    gathered.store(gathering.count, std::memory_order_relaxed);
+    gathers.fetch_add(1, std::memory_order_relaxed);
+    lastGatherNs.store(Metrics::NowNs() - start, std::memory_order_relaxed);
+}
+
+void MarkerOverlayUI::SyncWithGame() {
+    TRACE_SCOPE("MarkerOverlayUI::SyncWithGame");
+    const int64_t now = Metrics::NowNs();
+
+    if (now - lastGatherRequestNs >= kGatherIntervalNs && !gatherPending.exchange(true, std::memory_order_acq_rel)) {
+        lastGatherRequestNs = now;
+        if (!JobBridge::Post(JobBridge::Target::kGame, [] { MarkerOverlayUI::GetSingleton()->Gather(); })) {
+            gatherPending.store(false, std::memory_order_release);
+        }
+    }
+
+    // Regathers of an unchanged scene come back identical; only a change of kinds recolours markers
+    bool kindsChanged = false;
+    const uint32_t version = publishedVersion.load(std::memory_order_acquire);
+    if (version != markersVersion) {
+        std::lock_guard lock(publishMutex);
+        markersVersion = publishedVersion.load(std::memory_order_relaxed);
+        kindsChanged = published.count != markers.count ||
+                       !std::equal(published.kind.begin(), published.kind.begin() + published.count, markers.kind.begin());
+        markers = published;
+    }
+
+    // The camera has moved since last frame as often as not, so this runs every frame, into the
+    // buffer not on screen
+    const auto& previous = screens[screenIndex];
+    auto& screen = screens[screenIndex ^ 1];
+    auto* ui = RE::UI::GetSingleton();
+    auto* camera = RE::Main::WorldRootCamera();
+    auto* backend = UIRenderer::GetSingleton()->GetBackend();
+    if (!camera || !backend || !ui || ui->GameIsPaused()) {
+        screen.count = 0;
+    } else {
+        Markers::Camera view;
+        const auto& worldToCam = camera->GetRuntimeData().worldToCam;
+        for (std::size_t row = 0; row < 4; row++) {
+            for (std::size_t column = 0; column < 4; column++) {
+                view.worldToClip[row * 4 + column] = worldToCam[row][column];
+            }
+        }
+        view.positionX = camera->world.translate.x;
+        view.positionY = camera->world.translate.y;
+        view.positionZ = camera->world.translate.z;
+        const ImVec2 displaySize = backend->GetDisplaySize();
+        view.screenWidth = displaySize.x;
+        view.screenHeight = displaySize.y;
+        Markers::Project(markers, view, Settings::Get().markerRadius, screen);
+    }
+
+    // A still camera over a still scene keeps replaying the cached frame
+    if ((kindsChanged && (screen.count > 0 || previous.count > 0)) || !SameOutput(screen, previous)) {
+        UIRenderer::GetSingleton()->Invalidate();
+    }
+    screenIndex ^= 1;
+    visible.store(screen.count, std::memory_order_relaxed);
+    lastProjectNs.store(Metrics::NowNs() - now, std::memory_order_relaxed);
+}
+
+void MarkerOverlayUI::Draw() {
+    // Untextured diamonds off the font atlas's white pixel: one reservation, one draw command
+    const auto& screen = GetScreen();
+    auto* drawList = ImGui::GetBackgroundDrawList();
+    const ImVec2 uv = ImGui::GetFontTexUvWhitePixel();
+    drawList->PrimReserve(static_cast<int>(screen.count * 6), static_cast<int>(screen.count * 4));
+
+    for (uint32_t i = 0; i < screen.count; i++) {
+        const float distance = std::clamp(screen.distance[i], 0.0f, 1.0f);
+        const float size = kNearSize + (kFarSize - kNearSize) * distance;
+        const auto kind = static_cast<std::size_t>(markers.kind[screen.source[i]]);
+        // Fades towards the edge of the radius rather than popping out
+        const auto alpha = static_cast<ImU32>(230.0f - 130.0f * distance);
+        const ImU32 color = (kKindColors[kind] & ~IM_COL32_A_MASK) | alpha << IM_COL32_A_SHIFT;
+
+        const float x = screen.x[i];
+        const float y = screen.y[i];
+        const auto first = static_cast<ImDrawIdx>(drawList->_VtxCurrentIdx);
+        drawList->PrimWriteIdx(first);
+        drawList->PrimWriteIdx(static_cast<ImDrawIdx>(first + 1));
+        drawList->PrimWriteIdx(static_cast<ImDrawIdx>(first + 2));
+        drawList->PrimWriteIdx(first);
+        drawList->PrimWriteIdx(static_cast<ImDrawIdx>(first + 2));
+        drawList->PrimWriteIdx(static_cast<ImDrawIdx>(first + 3));
+        drawList->PrimWriteVtx(ImVec2(x, y - size), uv, color);
+        drawList->PrimWriteVtx(ImVec2(x + size, y), uv, color);
+        drawList->PrimWriteVtx(ImVec2(x, y + size), uv, color);
+        drawList->PrimWriteVtx(ImVec2(x - size, y), uv, color);
+    }
+}
+
+MarkerOverlayUI::Stats MarkerOverlayUI::GetStats() const {
+    Stats stats;
+    stats.gathered = gathered.load(std::memory_order_relaxed);
+    stats.visible = visible.load(std::memory_order_relaxed);
+    stats.gathers = gathers.load(std::memory_order_relaxed);
+    stats.lastGatherNs = lastGatherNs.load(std::memory_order_relaxed);
+    stats.lastProjectNs = lastProjectNs.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,157 @@
+#include "MarkerProjection.h"
+#include <bit>
+#include <cmath>
+
+#if !defined(DCF_MARKERS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#	include <emmintrin.h>
+#	define DCF_MARKERS_SSE2 1
+#endif
+
+namespace Markers {
+    namespace {
+        // Anything this close to the camera plane is treated as behind it, as the game does
+        constexpr float kMinClipW = 1e-5f;
+
+        void Emit(ScreenMarkers& out, uint32_t index, float screenX, float screenY, float distance) {
+            const uint32_t slot = out.count++;
+            out.x[slot] = screenX;
+            out.y[slot] = screenY;
+            out.distance[slot] = distance;
+            out.source[slot] = static_cast<uint16_t>(index);
+        }
+    }
+
+    const char* KindName(Kind kind) {
+        switch (kind) {
+            case Kind::kCorpse:  return "Corpse";
+            case Kind::kHarvest: return "Harvest";
+            case Kind::kLocked:  return "Locked";
+            default:             return "Unknown";
+        }
+    }
+
+    std::optional<Kind> Classify(const TargetFacts& facts) {
+        if (!facts.hasRef || !facts.hasBase) return std::nullopt;
+
+        if (facts.Is(BaseType::kNPC) && facts.dead) return Kind::kCorpse;
+        if (facts.Is(BaseType::kFlora) || facts.Is(BaseType::kTree)) return Kind::kHarvest;
+        if ((facts.Is(BaseType::kContainer) || facts.Is(BaseType::kDoor)) && facts.locked) return Kind::kLocked;
+        return std::nullopt;
+    }
+
+    bool MarkerSet::Add(uint32_t id, Kind markerKind, float worldX, float worldY, float worldZ) {
+        if (count >= kMaxMarkers) return false;
+
+        x[count] = worldX;
+        y[count] = worldY;
+        z[count] = worldZ;
+        formID[count] = id;
+        kind[count] = markerKind;
+        count++;
+        return true;
+    }
+
+    uint32_t ProjectScalar(const MarkerSet& markers, const Camera& camera, float radius, ScreenMarkers& out) {
+        const auto& m = camera.worldToClip;
+        const float radiusSquared = radius * radius;
+        const float invRadius = 1.0f / radius;
+
+        out.count = 0;
+        for (uint32_t i = 0; i < markers.count; i++) {
+            const float px = markers.x[i];
+            const float py = markers.y[i];
+            const float pz = markers.z[i];
+
+            const float dx = px - camera.positionX;
+            const float dy = py - camera.positionY;
+            const float dz = pz - camera.positionZ;
+            const float distanceSquared = dx * dx + dy * dy + dz * dz;
+
+            const float clipX = m[0] * px + m[1] * py + m[2] * pz + m[3];
+            const float clipY = m[4] * px + m[5] * py + m[6] * pz + m[7];
+            const float clipW = m[12] * px + m[13] * py + m[14] * pz + m[15];
+
+            const bool visible = clipW > kMinClipW && clipX <= clipW && -clipX <= clipW && clipY <= clipW && -clipY <= clipW &&
+                                 distanceSquared <= radiusSquared;
+            if (!visible) continue;
+
+            const float invW = 1.0f / clipW;
+            const float screenX = (clipX * invW * 0.5f + 0.5f) * camera.screenWidth;
+            const float screenY = (0.5f - clipY * invW * 0.5f) * camera.screenHeight;
+            Emit(out, i, screenX, screenY, std::sqrt(distanceSquared) * invRadius);
+        }
+        return out.count;
+    }
+
+    uint32_t Project(const MarkerSet& markers, const Camera& camera, float radius, ScreenMarkers& out) {
+#if defined(DCF_MARKERS_SSE2)
+        const auto& m = camera.worldToClip;
+        const __m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]), m02 = _mm_set1_ps(m[2]), m03 = _mm_set1_ps(m[3]);
+        const __m128 m10 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[6]), m13 = _mm_set1_ps(m[7]);
+        const __m128 m30 = _mm_set1_ps(m[12]), m31 = _mm_set1_ps(m[13]), m32 = _mm_set1_ps(m[14]), m33 = _mm_set1_ps(m[15]);
+        const __m128 cameraX = _mm_set1_ps(camera.positionX);
+        const __m128 cameraY = _mm_set1_ps(camera.positionY);
+        const __m128 cameraZ = _mm_set1_ps(camera.positionZ);
+        const __m128 width = _mm_set1_ps(camera.screenWidth);
+        const __m128 height = _mm_set1_ps(camera.screenHeight);
+        const __m128 radiusSquared = _mm_set1_ps(radius * radius);
+        const __m128 invRadius = _mm_set1_ps(1.0f / radius);
+        const __m128 minW = _mm_set1_ps(kMinClipW);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+
+        uint32_t emitted = 0;
+        for (uint32_t i = 0; i < markers.count; i += 4) {
+            const __m128 px = _mm_load_ps(&markers.x[i]);
+            const __m128 py = _mm_load_ps(&markers.y[i]);
+            const __m128 pz = _mm_load_ps(&markers.z[i]);
+
+            const __m128 dx = _mm_sub_ps(px, cameraX);
+            const __m128 dy = _mm_sub_ps(py, cameraY);
+            const __m128 dz = _mm_sub_ps(pz, cameraZ);
+            const __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+            const __m128 clipX = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, px), _mm_mul_ps(m01, py)), _mm_mul_ps(m02, pz)), m03);
+            const __m128 clipY = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, px), _mm_mul_ps(m11, py)), _mm_mul_ps(m12, pz)), m13);
+            const __m128 clipW = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m30, px), _mm_mul_ps(m31, py)), _mm_mul_ps(m32, pz)), m33);
+
+            // |x| <= w and |y| <= w, with the sign bit cleared for the absolute value
+            __m128 visible = _mm_cmpgt_ps(clipW, minW);
+            visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_andnot_ps(signBit, clipX), clipW));
+            visible = _mm_and_ps(visible, _mm_cmple_ps(_mm_andnot_ps(signBit, clipY), clipW));
+            visible = _mm_and_ps(visible, _mm_cmple_ps(distanceSquared, radiusSquared));
+
+            // Lanes past the end hold stale positions
+            const uint32_t remaining = markers.count - i;
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(visible));
+            if (remaining < 4) mask &= (1u << remaining) - 1;
+            // Most groups of four are wholly off screen or out of range; skip the divide for them
+            if (!mask) continue;
+
+            const __m128 invW = _mm_div_ps(one, clipW);
+            const __m128 screenX = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(clipX, invW), half), half), width);
+            const __m128 screenY = _mm_mul_ps(_mm_sub_ps(half, _mm_mul_ps(_mm_mul_ps(clipY, invW), half)), height);
+            const __m128 distance = _mm_mul_ps(_mm_sqrt_ps(distanceSquared), invRadius);
+
+            // Every lane is written and only visible ones advance the count, so there is no branch
+            // per lane; the slot never passes i + lane, which is in range
+            alignas(16) float lanesX[4], lanesY[4], lanesDistance[4];
+            _mm_store_ps(lanesX, screenX);
+            _mm_store_ps(lanesY, screenY);
+            _mm_store_ps(lanesDistance, distance);
+            for (uint32_t lane = 0; lane < 4; lane++) {
+                out.x[emitted] = lanesX[lane];
+                out.y[emitted] = lanesY[lane];
+                out.distance[emitted] = lanesDistance[lane];
+                out.source[emitted] = static_cast<uint16_t>(i + lane);
+                emitted += mask >> lane & 1;
+            }
+        }
+        out.count = emitted;
+        return emitted;
+#else
+        return ProjectScalar(markers, camera, radius, out);
+#endif
+    }
+}
@@ -1,91 +1,105 @@
 #include "Menu.h"
+#include "UIRenderer.h"
+#include "Trace.h"
+#include "Metrics.h"
+#include "CrosshairTrace.h"
+#include "JobBridge.h"
+#include "HookManager.h"
+#include "SettingsFile.h"
+#include "PapyrusBridge.h"
+#include "CrosshairUI.h"
+#include "InfoCardUI.h"
+#include "MarkerOverlayUI.h"
 #include <Windows.h>
 
 namespace logger = SKSE::log;
 
-Menu::~Menu() {
-    ImGui_ImplDX11_Shutdown();
-    ImGui_ImplWin32_Shutdown();
-    ImGui::DestroyContext();
-}
+Menu::~Menu() = default;
 
 bool Menu::Init() {
     if (initialized) return true;
 
-    auto* renderer = RE::BSGraphics::Renderer::GetSingleton();
-    if (!renderer) {
-        logger::error("Failed to get BSGraphics::Renderer singleton for menu.");
+    auto* uiRenderer = UIRenderer::GetSingleton();
+    if (!uiRenderer->Init()) {
+        logger::error("Failed to initialize UI renderer for menu.");
         return false;
     }
-    
-    REX::W32::ID3D11Device* device = RE::BSGraphics::Renderer::GetDevice();
-    auto* rendererData = RE::BSGraphics::Renderer::GetRendererDataSingleton();
-    if (!device || !rendererData || !rendererData->context) {
-        logger::error("Failed to get device, renderer data, or context for menu.");
-        return false;
-    }
-
-    device->AddRef();
-    rendererData->context->AddRef();
-    d3d_device = reinterpret_cast<ID3D11Device*>(device);
-    d3d_context = reinterpret_cast<ID3D11DeviceContext*>(rendererData->context);
 
-    auto* currentWindow = RE::BSGraphics::Renderer::GetCurrentRenderWindow();
-    if (!currentWindow) {
-        logger::error("Failed to get current render window for menu.");
-        return false;
-    }
-
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
-    ImGuiIO& io = ImGui::GetIO(); 
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
-    
-    io.MouseDrawCursor = true;
-    io.WantCaptureMouse = true;
-    io.WantCaptureKeyboard = true;
-    
-    ImGui::StyleColorsDark();
-    
-    if (!ImGui_ImplWin32_Init(currentWindow->hWnd)) {
-        logger::error("Failed to initialize ImGui_ImplWin32 for menu.");
-        return false;
-    }
+    // Only built into the shared frame while the menu is open
+    uiRenderer->RegisterLayer({
+        "Menu",
+        [] { return Menu::GetSingleton()->menuToggle.load(std::memory_order_relaxed); },
+        [] { Menu::GetSingleton()->DrawMenu(); },
+        true,
+        Memory::Tag::kMenu
+    });
 
-    if (!ImGui_ImplDX11_Init(d3d_device, d3d_context)) {
-        logger::error("Failed to initialize ImGui_ImplDX11 for menu.");
-        return false;
-    }
+    // Latency readout that stays up with the menu closed; redrawn only when a new sample lands
+    uiRenderer->RegisterLayer({
+        "LatencyOverlay",
+        [] { return Menu::GetSingleton()->showLatencyOverlay && HookManager::IsFeatureEnabled(HookManager::Feature::kOverlay); },
+        [] { Menu::GetSingleton()->DrawLatencyOverlay(); }
+    });
 
     initialized = true;
-    logger::info("Successfully initialized ImGui for menu.");
+    logger::info("Successfully initialized menu.");
     return true;
 }
 
 void Menu::DrawMenu() {
-    if (!this->menuToggle) {
-        ImGui::GetIO().MouseDrawCursor = false;
-        return;
-    }
-    
-    ImGui::GetIO().MouseDrawCursor = true;
-    
     ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Appearing);
     ImGui::SetNextWindowSize(ImVec2(300, 200), ImGuiCond_Appearing);
-    ImGui::Begin("Crosshair Configuration Menu", &this->menuToggle);
+    bool open = true;
+    ImGui::Begin("Crosshair Configuration Menu", &open);
     
+    // A copy: the Update calls below retire the snapshot Get returned
+    const Settings::Snapshot settings = Settings::Get();
+
     // Dropdown for crosshair source
     const char* sourceItems[] = { "Images", "Icon Font", "Web Icon Pack" };
+    static_assert(IM_ARRAYSIZE(sourceItems) == Settings::kCrosshairSourceCount);
+    const CrosshairSource currentSource = settings.crosshairSource;
     int currentSourceIndex = static_cast<int>(currentSource);
     
     if (ImGui::Combo("Crosshair Source", &currentSourceIndex, sourceItems, IM_ARRAYSIZE(sourceItems))) {
-        // Update the current source when selection changes
-        currentSource = static_cast<CrosshairSource>(currentSourceIndex);
+        // Published and saved; the file watcher writes it out off the frame
+        const auto source = static_cast<CrosshairSource>(currentSourceIndex);
+        Settings::Update([source](Settings::Snapshot& s) { s.crosshairSource = source; });
+        SettingsFile::RequestSave();
         
         // Log the change
-        const char* sourceNames[] = { "Images", "Icon Font", "Web Icon Pack" };
-        logger::info("Crosshair source changed to: {}", sourceNames[currentSourceIndex]);
+        logger::info("Crosshair source changed to: {}", sourceItems[currentSourceIndex]);
+    }
+
+    float crosshairSize = settings.crosshairSize;
+    if (ImGui::SliderFloat("Crosshair Size", &crosshairSize, 8.0f, 128.0f, "%.0f px")) {
+        Settings::Update([crosshairSize](Settings::Snapshot& s) { s.crosshairSize = crosshairSize; });
+        SettingsFile::RequestSave();
+    }
+
+    int transitionMs = static_cast<int>(settings.transitionMs);
+    if (ImGui::SliderInt("Transition", &transitionMs, 0, 500, transitionMs ? "%d ms" : "Instant")) {
+        Settings::Update([transitionMs](Settings::Snapshot& s) { s.transitionMs = static_cast<uint32_t>(transitionMs); });
+        SettingsFile::RequestSave();
+    }
+
+    bool infoCards = settings.infoCardsEnabled;
+    if (ImGui::Checkbox("Info cards", &infoCards)) {
+        Settings::Update([infoCards](Settings::Snapshot& s) { s.infoCardsEnabled = infoCards; });
+        SettingsFile::RequestSave();
+    }
+
+    bool markers = settings.markersEnabled;
+    if (ImGui::Checkbox("Markers", &markers)) {
+        Settings::Update([markers](Settings::Snapshot& s) { s.markersEnabled = markers; });
+        SettingsFile::RequestSave();
+    }
+    if (markers) {
+        float markerRadius = settings.markerRadius;
+        if (ImGui::SliderFloat("Marker Radius", &markerRadius, 256.0f, 16384.0f, "%.0f units")) {
+            Settings::Update([markerRadius](Settings::Snapshot& s) { s.markerRadius = markerRadius; });
+            SettingsFile::RequestSave();
+        }
     }
     
     // Additional UI based on selected source
@@ -107,76 +121,417 @@ void Menu::DrawMenu() {
             // Add web icon pack-specific settings here
             break;
     }
+
+    if (ImGui::CollapsingHeader("Memory")) {
+        DrawMemoryStats();
+    }
+
+    if (ImGui::CollapsingHeader("Latency")) {
+        DrawLatency();
+    }
+
+    if (ImGui::CollapsingHeader("Scheduler")) {
+        DrawScheduler();
+    }
+
+    if (ImGui::CollapsingHeader("Hooks")) {
+        DrawHooks();
+    }
+
+    if (HookManager::IsFeatureEnabled(HookManager::Feature::kTracing) && ImGui::CollapsingHeader("Tracing")) {
+        DrawTracing();
+    }
     
     ImGui::End();
+
+    // Closed through the window's close button
+    if (!open) {
+        this->menuToggle = false;
+        ImGui::GetIO().MouseDrawCursor = false;
+    }
+}
+
+void Menu::DrawMemoryStats() {
+    const auto& frameStats = UIRenderer::GetSingleton()->GetFrameStats();
+    const auto& arena = Memory::GetFrameArena();
+    ImGui::Text("Heap calls last frame: %llu", static_cast<unsigned long long>(frameStats.heapCallsLastFrame));
+    ImGui::Text("Frame arena: %zu / %zu bytes (peak %zu)", arena.GetUsed(), arena.GetCapacity(), arena.GetHighWater());
+    ImGui::Text("Pool chunks reserved: %lld bytes", static_cast<long long>(Memory::GetPoolReservedBytes()));
+
+    if (ImGui::Button("Reset peaks")) {
+        Memory::ResetPeaks();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Dump")) {
+        std::filesystem::path path;
+        if (Metrics::DumpCsv(path)) {
+            logger::info("Wrote metrics to {}", path.string());
+        } else {
+            logger::warn("Could not write metrics CSV");
+        }
+    }
+
+    if (ImGui::BeginTable("MemoryTags", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Subsystem");
+        ImGui::TableSetupColumn("Bytes");
+        ImGui::TableSetupColumn("Peak");
+        ImGui::TableSetupColumn("Allocs");
+        ImGui::TableSetupColumn("Frees");
+        ImGui::TableHeadersRow();
+
+        for (uint8_t i = 0; i < static_cast<uint8_t>(Memory::Tag::kCount); i++) {
+            const auto tag = static_cast<Memory::Tag>(i);
+            const auto& stats = Memory::GetStats(tag);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(Memory::TagName(tag));
+            ImGui::TableNextColumn();
+            ImGui::Text("%lld", static_cast<long long>(stats.bytes.load(std::memory_order_relaxed)));
+            ImGui::TableNextColumn();
+            ImGui::Text("%lld", static_cast<long long>(stats.peakBytes.load(std::memory_order_relaxed)));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(stats.allocations.load(std::memory_order_relaxed)));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(stats.frees.load(std::memory_order_relaxed)));
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TextDisabled("Menu counts what ImGui allocates while drawing this menu; the rest of ImGui's memory is under ImGui.");
+
+    // Only subsystems that have ever owned a GPU resource
+    if (ImGui::BeginTable("GpuTags", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Subsystem");
+        ImGui::TableSetupColumn("VRAM");
+        ImGui::TableSetupColumn("Peak");
+        ImGui::TableSetupColumn("Resources");
+        ImGui::TableHeadersRow();
+
+        for (uint8_t i = 0; i < static_cast<uint8_t>(Memory::Tag::kCount); i++) {
+            const auto tag = static_cast<Memory::Tag>(i);
+            const auto& stats = Memory::GetGpuStats(tag);
+            const int64_t peak = stats.peakBytes.load(std::memory_order_relaxed);
+            const int64_t bytes = stats.bytes.load(std::memory_order_relaxed);
+            if (!peak && !bytes) continue;
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(Memory::TagName(tag));
+            ImGui::TableNextColumn();
+            ImGui::Text("%lld", static_cast<long long>(bytes));
+            ImGui::TableNextColumn();
+            ImGui::Text("%lld", static_cast<long long>(peak));
+            ImGui::TableNextColumn();
+            ImGui::Text("%lld", static_cast<long long>(stats.resources.load(std::memory_order_relaxed)));
+        }
+        ImGui::EndTable();
+    }
+}
+
+void Menu::DrawLatency() {
+    const auto& latency = Metrics::GetPresentLatency();
+    ImGui::Text("Target to pixel: p50 %.2f ms, p99 %.2f ms, max %.2f ms",
+        latency.GetPercentile(50.0) / 1e6, latency.GetPercentile(99.0) / 1e6, latency.GetMax() / 1e6);
+    ImGui::Text("Samples: %llu, mean %.2f ms", static_cast<unsigned long long>(latency.GetCount()), latency.GetMean() / 1e6);
+
+    const auto& frameStats = UIRenderer::GetSingleton()->GetFrameStats();
+    const uint64_t frames = frameStats.replayedFrames + frameStats.rebuiltFrames;
+    ImGui::Text("Draw cache hit rate: %.1f%%", frames ? 100.0 * frameStats.replayedFrames / frames : 0.0);
+
+    const auto& animation = CrosshairUI::GetSingleton()->GetAnimationStats();
+    ImGui::Text("Animation: %u layer(s), %u step(s), last %.2f us, mean %.2f us, max %.2f us, %llu dropped",
+        animation.activeLayers, animation.lastSteps, animation.lastAdvanceNs / 1000.0, animation.avgAdvanceNs / 1000.0,
+        animation.maxAdvanceNs / 1000.0, static_cast<unsigned long long>(animation.dropped));
+
+    const auto cards = InfoCardUI::GetSingleton()->GetStats();
+    ImGui::Text("Info cards: %u base forms, cache %llu hits / %llu misses, %llu invalidated, %llu layouts, last %.2f us",
+        cards.staticForms, static_cast<unsigned long long>(cards.cacheHits), static_cast<unsigned long long>(cards.cacheMisses),
+        static_cast<unsigned long long>(cards.invalidations), static_cast<unsigned long long>(cards.layoutsBuilt), cards.lastUpdateNs / 1000.0);
+
+    const auto markerStats = MarkerOverlayUI::GetSingleton()->GetStats();
+    ImGui::Text("Markers: %u visible of %u, project %.2f us, gather %.2f us (%llu gathers)",
+        markerStats.visible, markerStats.gathered, markerStats.lastProjectNs / 1000.0, markerStats.lastGatherNs / 1000.0,
+        static_cast<unsigned long long>(markerStats.gathers));
+
+    if (ImGui::Checkbox("Show overlay", &showLatencyOverlay)) {
+        UIRenderer::GetSingleton()->Invalidate();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+        Metrics::ResetPresentLatency();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Dump CSV")) {
+        std::filesystem::path path;
+        if (Metrics::DumpCsv(path)) {
+            logger::info("Wrote metrics to {}", path.string());
+        } else {
+            logger::warn("Could not write metrics CSV");
+        }
+    }
+
+    if (ImGui::BeginTable("InteractionChanges", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Interaction");
+        ImGui::TableSetupColumn("Changes");
+        ImGui::TableHeadersRow();
+
+        for (std::size_t i = 0; i < kInteractionTypeCount; i++) {
+            const auto type = static_cast<CrosshairMonitor::InteractionType>(i);
+            const uint64_t count = Metrics::GetInteractionChangeCount(type);
+            if (count == 0) continue;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(CrosshairMonitor::GetInteractionTypeName(type));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(count));
+        }
+        ImGui::EndTable();
+    }
+}
+
+void Menu::DrawLatencyOverlay() {
+    const auto& latency = Metrics::GetPresentLatency();
+    const ImVec2 displaySize = ImGui::GetIO().DisplaySize;
+    ImGui::SetNextWindowPos(ImVec2(displaySize.x - 10.0f, 10.0f), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(0.5f);
+    ImGui::Begin("##LatencyOverlay", nullptr,
+        ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav);
+    ImGui::Text("Target->pixel p50 %.2f  p99 %.2f  max %.2f ms (n=%llu)",
+        latency.GetPercentile(50.0) / 1e6, latency.GetPercentile(99.0) / 1e6, latency.GetMax() / 1e6,
+        static_cast<unsigned long long>(latency.GetCount()));
+    ImGui::End();
 }
 
-const ImGuiKey Menu::VirtualKeyToImGuiKey(WPARAM vkKey) {
-    switch (vkKey) {
-        case VK_F10:
-            return ImGuiKey_F10;
-        case VK_ESCAPE:
-            return ImGuiKey_Escape;
-        default:
-            return ImGuiKey_Enter;
+void Menu::DrawScheduler() {
+    auto& gameScheduler = JobBridge::GetScheduler(JobBridge::Target::kGame);
+    auto& renderScheduler = JobBridge::GetScheduler(JobBridge::Target::kRender);
+
+    // One base budget for both threads, applied by JobBridge each frame
+    int budgetUs = static_cast<int>(Settings::Get().frameBudgetUs);
+    if (ImGui::SliderInt("Budget (us/frame)", &budgetUs, 100, 4000)) {
+        Settings::Update([budgetUs](Settings::Snapshot& s) { s.frameBudgetUs = static_cast<uint32_t>(budgetUs); });
+        SettingsFile::RequestSave();
     }
+
+    if (ImGui::BeginTable("Schedulers", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Thread");
+        ImGui::TableSetupColumn("Critical");
+        ImGui::TableSetupColumn("Normal");
+        ImGui::TableSetupColumn("Background");
+        ImGui::TableSetupColumn("Budget us");
+        ImGui::TableSetupColumn("Spent us");
+        ImGui::TableSetupColumn("Deferred frames");
+        ImGui::TableSetupColumn("Dropped");
+        ImGui::TableHeadersRow();
+
+        for (const FrameScheduler* scheduler : { &gameScheduler, &renderScheduler }) {
+            const auto stats = scheduler->GetStats();
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(scheduler->GetName());
+            for (const uint32_t pending : stats.pending) {
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", pending);
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", stats.budgetUs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", stats.lastSpentUs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(stats.deferredFrames));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(stats.dropped));
+        }
+        ImGui::EndTable();
+    }
+    ImGui::Text("Frame time: %.2f ms", renderScheduler.GetStats().avgFrameMs);
 }
 
-inline const uint32_t Menu::DIKToVK(uint32_t DIK) {
-    switch (DIK) {
-        case DIK_DELETE:
-            return VK_DELETE;
-        default:
-            return DIK;
+void Menu::DrawHooks() {
+    // Takes effect on each hook's next call, when it rebuilds its dispatch table
+    const Settings::Snapshot settings = Settings::Get();   // Copied; the toggles below publish
+    bool overlay = settings.overlayEnabled;
+    bool tracing = settings.tracingEnabled;
+    if (ImGui::Checkbox("Crosshair overlay", &overlay)) {
+        Settings::Update([overlay](Settings::Snapshot& s) { s.overlayEnabled = overlay; });
+        SettingsFile::RequestSave();
+    }
+    ImGui::SameLine();
+    if (ImGui::Checkbox("Tracing", &tracing)) {
+        Settings::Update([tracing](Settings::Snapshot& s) { s.tracingEnabled = tracing; });
+        SettingsFile::RequestSave();
+    }
+    ImGui::TextDisabled("The menu itself is disabled with [Features] Menu = false in the settings file.");
+
+    auto* hooks = HookManager::GetSingleton();
+    if (ImGui::BeginTable("Hooks", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Hook");
+        ImGui::TableSetupColumn("Installed");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("Mean us");
+        ImGui::TableSetupColumn("Max us");
+        ImGui::TableHeadersRow();
+
+        for (std::size_t i = 0; i < HookManager::kHookCount; i++) {
+            const auto hook = static_cast<HookManager::Hook>(i);
+            const auto stats = hooks->GetStats(hook);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(HookManager::GetHookName(hook));
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(hooks->IsInstalled(hook) ? "yes" : "no");
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(stats.calls));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", stats.calls ? stats.totalNs / 1000.0 / stats.calls : 0.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", stats.maxNs / 1000.0);
+        }
+        ImGui::EndTable();
+    }
+    if (ImGui::Button("Reset hook stats")) {
+        hooks->ResetStats();
+    }
+
+    // Script events are coalesced per frame, so changes outnumber batches while the target flickers
+    const auto papyrus = PapyrusBridge::GetStats();
+    ImGui::Text("Papyrus: %u registered, %llu changes -> %llu batches (%llu cancelled), %llu events",
+        papyrus.registrations, static_cast<unsigned long long>(papyrus.changes), static_cast<unsigned long long>(papyrus.batches),
+        static_cast<unsigned long long>(papyrus.cancelled), static_cast<unsigned long long>(papyrus.events));
+}
+
+void Menu::DrawTracing() {
+    const auto state = Trace::GetState();
+    ImGui::SliderInt("Seconds", &traceSeconds, 1, 30);
+
+    ImGui::BeginDisabled(state != Trace::State::kIdle);
+    if (ImGui::Button("Capture trace")) {
+        if (!Trace::StartCapture(static_cast<float>(traceSeconds))) {
+            logger::warn("Could not start trace capture");
+        }
+    }
+    ImGui::EndDisabled();
+
+    // Crosshair event recording for tools/crosshairreplay
+    auto* recorder = CrosshairTrace::Recorder::GetSingleton();
+    if (!recorder->IsRecording()) {
+        if (ImGui::Button("Record crosshair events")) {
+            const auto logsFolder = SKSE::log::log_directory();
+            if (!logsFolder || !recorder->Start(*logsFolder / "DynamicCrosshairFramework.xrec")) {
+                logger::warn("Could not start crosshair event recording");
+            }
+        }
+    } else if (ImGui::Button("Stop recording")) {
+        const int64_t written = recorder->Stop();
+        if (written < 0) {
+            logger::warn("Could not write crosshair event recording");
+        } else {
+            logger::info("Recorded {} crosshair events", written);
+        }
+    }
+
+    if (state == Trace::State::kCapturing) {
+        ImGui::TextUnformatted("Capturing...");
+    } else if (state == Trace::State::kWriting) {
+        ImGui::TextUnformatted("Writing trace...");
+    } else if (const auto path = Trace::GetLastCapturePath(); !path.empty()) {
+        ImGui::TextWrapped("Last trace: %s", path.c_str());
+    }
+}
+
+bool Menu::IsToggleKeyEvent(const KeyEvent& e) const {
+    return e.device == RE::INPUT_DEVICE::kKeyboard &&
+           e.eventType == RE::INPUT_EVENT_TYPE::kButton &&
+           e.virtualKey == Settings::Get().toggleKey;
+}
+
+void Menu::AddKeyboardEvent(ImGuiIO& io, const KeyEvent& event) {
+    const uint8_t key = event.virtualKey;
+    const bool pressed = event.IsPressed();
+
+    if (!pressed) {
+        if (key == Settings::Get().toggleKey) {
+            this->menuToggle = !this->menuToggle;
+        }
+        if (key == VK_ESCAPE && this->menuToggle) {
+            this->menuToggle = false;
+        }
+        io.MouseDrawCursor = this->menuToggle;
+    }
+
+    keysDown[key] = pressed;
+    if (const ImGuiKey mod = KeyTables::kVKToImGuiMod[key]; mod != ImGuiKey_None) {
+        // Either side of a modifier holds it down
+        io.AddKeyEvent(mod, pressed || keysDown[KeyTables::kModifierSibling[key]]);
+    }
+
+    if (const ImGuiKey imguiKey = KeyTables::kVKToImGuiKey[key]; imguiKey != ImGuiKey_None) {
+        io.AddKeyEvent(imguiKey, pressed);
+        io.SetKeyEventNativeData(imguiKey, key, static_cast<int>(event.keyCode));
+    }
+}
+
+void Menu::AddMouseEvent(ImGuiIO& io, const KeyEvent& event) {
+    if (event.keyCode == KeyTables::kMouseWheelUp || event.keyCode == KeyTables::kMouseWheelDown) {
+        if (event.IsPressed()) {
+            io.AddMouseWheelEvent(0.0f, event.keyCode == KeyTables::kMouseWheelUp ? 1.0f : -1.0f);
+        }
+        return;
+    }
+
+    if (event.keyCode < KeyTables::kMouseButtonToImGui.size()) {
+        if (const int button = KeyTables::kMouseButtonToImGui[event.keyCode]; button >= 0) {
+            io.AddMouseButtonEvent(button, event.IsPressed());
+        }
     }
 }
     
 void Menu::ProcessInputEventQueue() {
+    TRACE_SCOPE("Menu::ProcessInputEventQueue");
     ImGuiIO& io = ImGui::GetIO();
-    for (auto& event : _keyEventQueue) {
+    _keyEventQueue.Drain([&](const KeyEvent& event) {
         if (event.eventType == RE::INPUT_EVENT_TYPE::kChar) {
             io.AddInputCharacter(event.keyCode);
-            continue;
+            return;
         }
 
         if (event.device == RE::INPUT_DEVICE::kMouse) {
-            if (event.keyCode > 5) {
-                event.keyCode = 5;
-            }
-            io.AddMouseButtonEvent(event.keyCode, event.IsPressed());
+            AddMouseEvent(io, event);
+        } else if (event.device == RE::INPUT_DEVICE::kKeyboard) {
+            AddKeyboardEvent(io, event);
         }
-
-        if (event.device == RE::INPUT_DEVICE::kKeyboard) {
-            uint32_t key = DIKToVK(event.keyCode);
-            if (key == event.keyCode) {
-                key = MapVirtualKeyEx(event.keyCode, MAPVK_VSC_TO_VK_EX, GetKeyboardLayout(0));
-            }
-            if (!event.IsPressed()) {
-                if (key == toggleKey) {
-                    this->menuToggle = !this->menuToggle;
-                }
-                if (key == VK_ESCAPE && this->menuToggle) {
-                    this->menuToggle = false;
-                }
-            }
-            io.AddKeyEvent(VirtualKeyToImGuiKey(key), event.IsPressed());
-        }
-    }
-
-    _keyEventQueue.clear();
+    });
 }
 
-void Menu::addToEventQueue(KeyEvent e) {
-    _keyEventQueue.emplace_back(e);
+void Menu::addToEventQueue(const KeyEvent& e) {
+    // Overflow is counted by the queue; the event is dropped rather than blocking the input thread
+    _keyEventQueue.TryPush(e);
 }
 
 void Menu::ProcessInputEvents(RE::InputEvent* const* a_event) {
+    const bool menuOpen = this->menuToggle.load(std::memory_order_relaxed);
+
+    // The layout belongs to the thread that owns the game window, which is this one
+    const HKL layout = GetKeyboardLayout(0);
+    keyTranslator.RefreshLayout(reinterpret_cast<uintptr_t>(layout), [layout](uint32_t scanCode) {
+        return static_cast<uint32_t>(MapVirtualKeyEx(scanCode, MAPVK_VSC_TO_VK_EX, layout));
+    });
+
     for (auto it = *a_event; it; it = it->next) {
         if (it->GetEventType() != RE::INPUT_EVENT_TYPE::kButton && it->GetEventType() != RE::INPUT_EVENT_TYPE::kChar) {
             continue;
         }
 
         auto event = it->GetEventType() == RE::INPUT_EVENT_TYPE::kButton ? KeyEvent(static_cast<RE::ButtonEvent*>(it)) : KeyEvent(static_cast<CharEvent*>(it));
+        if (event.device == RE::INPUT_DEVICE::kKeyboard) {
+            event.virtualKey = keyTranslator.ToVirtualKey(event.keyCode);
+        }
+
+        // While the menu is closed only the toggle key matters
+        if (!menuOpen && !IsToggleKeyEvent(event)) {
+            _filteredEvents.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
         addToEventQueue(event);            
     }
 }
@@ -0,0 +1,127 @@
+#include "Metrics.h"
+#include "Allocator.h"
+#include "BinaryLog.h"
+#include "Menu.h"
+#include "UIRenderer.h"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+
+namespace Metrics {
+    namespace {
+        std::array<std::atomic<uint64_t>, kInteractionTypeCount> interactionChanges;
+
+        // Render thread only
+        LatencyHistogram presentLatency;
+        int64_t pendingEventTimeNs = 0;
+
+        std::filesystem::path outputDirectory;
+    }
+
+    int64_t NowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void CountInteractionChange(CrosshairMonitor::InteractionType type) {
+        const auto index = static_cast<std::size_t>(type);
+        if (index < interactionChanges.size()) {
+            interactionChanges[index].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void BeginPresentLatency(int64_t eventTimeNs) {
+        // A change superseded before it was shown keeps the older start: that is when the crosshair went stale
+        if (pendingEventTimeNs == 0) {
+            pendingEventTimeNs = eventTimeNs;
+        }
+    }
+
+    bool EndPresentLatency() {
+        if (pendingEventTimeNs == 0) return false;
+
+        const int64_t latency = NowNs() - pendingEventTimeNs;
+        pendingEventTimeNs = 0;
+        presentLatency.Record(latency > 0 ? static_cast<uint64_t>(latency) : 0);
+        return true;
+    }
+
+    const LatencyHistogram& GetPresentLatency() {
+        return presentLatency;
+    }
+
+    void ResetPresentLatency() {
+        presentLatency.Reset();
+    }
+
+    uint64_t GetInteractionChangeCount(CrosshairMonitor::InteractionType type) {
+        const auto index = static_cast<std::size_t>(type);
+        return index < interactionChanges.size() ? interactionChanges[index].load(std::memory_order_relaxed) : 0;
+    }
+
+    void SetOutputDirectory(const std::filesystem::path& directory) {
+        outputDirectory = directory;
+    }
+
+    bool DumpCsv(std::filesystem::path& writtenPath) {
+        if (outputDirectory.empty()) return false;
+
+        char fileName[64];
+        const std::time_t now = std::time(nullptr);
+        std::tm local{};
+        localtime_s(&local, &now);
+        std::strftime(fileName, sizeof(fileName), "DynamicCrosshairFramework-metrics-%Y%m%d-%H%M%S.csv", &local);
+        const auto path = outputDirectory / fileName;
+
+        std::FILE* file = std::fopen(path.string().c_str(), "w");
+        if (!file) return false;
+
+        const auto& latency = presentLatency;
+        const auto& frameStats = UIRenderer::GetSingleton()->GetFrameStats();
+        const uint64_t frames = frameStats.replayedFrames + frameStats.rebuiltFrames;
+
+        std::fprintf(file, "metric,value\n");
+        std::fprintf(file, "plugin_version,%s\n", PLUGIN_VERSION);
+        std::fprintf(file, "present_latency_count,%llu\n", static_cast<unsigned long long>(latency.GetCount()));
+        std::fprintf(file, "present_latency_mean_us,%.3f\n", latency.GetMean() / 1000.0);
+        std::fprintf(file, "present_latency_p50_us,%.3f\n", latency.GetPercentile(50.0) / 1000.0);
+        std::fprintf(file, "present_latency_p90_us,%.3f\n", latency.GetPercentile(90.0) / 1000.0);
+        std::fprintf(file, "present_latency_p99_us,%.3f\n", latency.GetPercentile(99.0) / 1000.0);
+        std::fprintf(file, "present_latency_max_us,%.3f\n", latency.GetMax() / 1000.0);
+
+        for (std::size_t i = 0; i < kInteractionTypeCount; i++) {
+            const auto type = static_cast<CrosshairMonitor::InteractionType>(i);
+            std::fprintf(file, "changes_%s,%llu\n", CrosshairMonitor::GetInteractionTypeName(type),
+                static_cast<unsigned long long>(GetInteractionChangeCount(type)));
+        }
+
+        std::fprintf(file, "ui_frames,%llu\n", static_cast<unsigned long long>(frames));
+        std::fprintf(file, "ui_replayed_frames,%llu\n", static_cast<unsigned long long>(frameStats.replayedFrames));
+        std::fprintf(file, "ui_replay_hit_rate,%.4f\n", frames ? static_cast<double>(frameStats.replayedFrames) / static_cast<double>(frames) : 0.0);
+        std::fprintf(file, "ui_avg_frame_ms,%.4f\n", frameStats.avgFrameMs);
+        std::fprintf(file, "input_events_dropped,%llu\n", static_cast<unsigned long long>(Menu::GetSingleton()->GetDroppedInputEvents()));
+        std::fprintf(file, "blog_records_dropped,%llu\n", static_cast<unsigned long long>(BinaryLog::GetDroppedRecords()));
+        std::fprintf(file, "blog_records_suppressed,%llu\n", static_cast<unsigned long long>(BinaryLog::GetSuppressedRecords()));
+
+        for (uint8_t i = 0; i < static_cast<uint8_t>(Memory::Tag::kCount); i++) {
+            const auto tag = static_cast<Memory::Tag>(i);
+            const char* name = Memory::TagName(tag);
+            const auto& stats = Memory::GetStats(tag);
+            const auto& gpu = Memory::GetGpuStats(tag);
+            std::fprintf(file, "mem_%s_bytes,%lld\n", name, static_cast<long long>(stats.bytes.load(std::memory_order_relaxed)));
+            std::fprintf(file, "mem_%s_peak_bytes,%lld\n", name, static_cast<long long>(stats.peakBytes.load(std::memory_order_relaxed)));
+            std::fprintf(file, "mem_%s_allocs,%llu\n", name, static_cast<unsigned long long>(stats.allocations.load(std::memory_order_relaxed)));
+            std::fprintf(file, "gpu_%s_bytes,%lld\n", name, static_cast<long long>(gpu.bytes.load(std::memory_order_relaxed)));
+            std::fprintf(file, "gpu_%s_peak_bytes,%lld\n", name, static_cast<long long>(gpu.peakBytes.load(std::memory_order_relaxed)));
+            std::fprintf(file, "gpu_%s_resources,%lld\n", name, static_cast<long long>(gpu.resources.load(std::memory_order_relaxed)));
+        }
+        std::fprintf(file, "mem_pool_reserved_bytes,%lld\n", static_cast<long long>(Memory::GetPoolReservedBytes()));
+
+        const bool ok = std::ferror(file) == 0;
+        std::fclose(file);
+        if (ok) {
+            writtenPath = path;
+        }
+        return ok;
+    }
+}
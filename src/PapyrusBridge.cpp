@@ -0,0 +1,246 @@
+#include "PapyrusBridge.h"
+#include "CrosshairStateBlock.h"
+#include "JobBridge.h"
+#include "Metrics.h"
+#include "RE/Skyrim.h"
+#include "SKSE/SKSE.h"
+#include <vector>
+
+namespace logger = SKSE::log;
+
+namespace {
+    constexpr std::string_view kScriptName = "DCF_Crosshair";
+
+    // Co-save record holding the registered handles
+    constexpr uint32_t kSerializationID = 'DCFW';
+    constexpr uint32_t kRegistrationsRecord = 'ICRG';
+    constexpr uint32_t kRegistrationsVersion = 1;
+
+    InteractionEventBatcher batcher;
+
+    class PapyrusVM final : public ScriptVM {
+        public:
+            void SendInteractionChanged(const Handle* handles, std::size_t count, const InteractionEvent& event) override {
+                auto* vm = RE::BSScript::Internal::VirtualMachine::GetSingleton();
+                if (!vm) return;
+
+                // Interned on first use; nothing can register before the game's string cache exists
+                static const RE::BSFixedString eventName("OnCrosshairInteractionChanged");
+                auto* target = event.formID ? RE::TESForm::LookupByID<RE::TESObjectREFR>(event.formID) : nullptr;
+                const auto type = static_cast<int32_t>(event.type);
+                const auto previousType = static_cast<int32_t>(event.previousType);
+                for (std::size_t i = 0; i < count; i++) {
+                    // The VM owns each argument pack once the event is queued
+                    vm->SendEvent(handles[i], eventName, RE::MakeFunctionArguments(static_cast<RE::TESObjectREFR*>(target), int32_t{ type }, int32_t{ previousType }));
+                }
+            }
+    };
+
+    PapyrusVM papyrusVM;
+
+    void FlushEvents() {
+        batcher.Flush(papyrusVM);
+    }
+
+    // Natives. All read the published state block, so they are safe on any VM thread and are
+    // registered as callable from tasklets: no wait for the main thread's next sync point.
+    DCF_CrosshairState ReadState() {
+        return DCF_ReadCrosshairState(&CrosshairStateBlock::GetState());
+    }
+
+    int32_t GetInteractionType(RE::StaticFunctionTag*) {
+        return static_cast<int32_t>(ReadState().interactionType);
+    }
+
+    int32_t GetActivationFlags(RE::StaticFunctionTag*) {
+        return static_cast<int32_t>(ReadState().activationFlags);
+    }
+
+    int32_t GetStateFlags(RE::StaticFunctionTag*) {
+        return static_cast<int32_t>(ReadState().stateFlags);
+    }
+
+    RE::TESObjectREFR* GetTarget(RE::StaticFunctionTag*) {
+        const uint32_t formID = ReadState().formID;
+        return formID ? RE::TESForm::LookupByID<RE::TESObjectREFR>(formID) : nullptr;
+    }
+
+    RE::BSFixedString GetInteractionTypeName(RE::StaticFunctionTag*, int32_t type) {
+        if (type < 0 || static_cast<std::size_t>(type) >= kInteractionTypeCount) return "";
+        return InteractionTypeName(static_cast<InteractionType>(type));
+    }
+
+    bool RegisterObject(const void* object, RE::VMTypeID typeID) {
+        auto* vm = RE::BSScript::Internal::VirtualMachine::GetSingleton();
+        if (!object || !vm) return false;
+
+        auto* policy = vm->GetObjectHandlePolicy();
+        const RE::VMHandle handle = policy->GetHandleForObject(typeID, object);
+        if (handle == policy->EmptyHandle() || !batcher.Register(handle)) return false;
+        // Keeps the handle valid for as long as the object is registered
+        policy->PersistHandle(handle);
+        return true;
+    }
+
+    bool UnregisterObject(const void* object, RE::VMTypeID typeID) {
+        auto* vm = RE::BSScript::Internal::VirtualMachine::GetSingleton();
+        if (!object || !vm) return false;
+
+        auto* policy = vm->GetObjectHandlePolicy();
+        const RE::VMHandle handle = policy->GetHandleForObject(typeID, object);
+        if (handle == policy->EmptyHandle() || !batcher.Unregister(handle)) return false;
+        policy->ReleaseHandle(handle);
+        return true;
+    }
+
+    bool RegisterForm(RE::StaticFunctionTag*, RE::TESForm* form) {
+        return form && RegisterObject(form, static_cast<RE::VMTypeID>(form->GetFormType()));
+    }
+
+    bool UnregisterForm(RE::StaticFunctionTag*, RE::TESForm* form) {
+        return form && UnregisterObject(form, static_cast<RE::VMTypeID>(form->GetFormType()));
+    }
+
+    bool RegisterAlias(RE::StaticFunctionTag*, RE::BGSBaseAlias* alias) {
+        return alias && RegisterObject(alias, alias->GetVMTypeID());
+    }
+
+    bool UnregisterAlias(RE::StaticFunctionTag*, RE::BGSBaseAlias* alias) {
+        return alias && UnregisterObject(alias, alias->GetVMTypeID());
+    }
+
+    bool RegisterEffect(RE::StaticFunctionTag*, RE::ActiveEffect* effect) {
+        return effect && RegisterObject(effect, RE::ActiveEffect::VMTYPEID);
+    }
+
+    bool UnregisterEffect(RE::StaticFunctionTag*, RE::ActiveEffect* effect) {
+        return effect && UnregisterObject(effect, RE::ActiveEffect::VMTYPEID);
+    }
+
+    // The CSV reads render-thread state, so it is written on the next Present
+    bool DumpMetrics(RE::StaticFunctionTag*) {
+        return JobBridge::Post(JobBridge::Target::kRender, [] {
+            std::filesystem::path path;
+            if (Metrics::DumpCsv(path)) {
+                logger::info("Wrote metrics to {}", path.string());
+            } else {
+                logger::warn("Could not write metrics CSV");
+            }
+        });
+    }
+
+    bool RegisterFunctions(RE::BSScript::IVirtualMachine* vm) {
+        vm->RegisterFunction("GetInteractionType"sv, kScriptName, GetInteractionType, true);
+        vm->RegisterFunction("GetActivationFlags"sv, kScriptName, GetActivationFlags, true);
+        vm->RegisterFunction("GetStateFlags"sv, kScriptName, GetStateFlags, true);
+        vm->RegisterFunction("GetTarget"sv, kScriptName, GetTarget, true);
+        vm->RegisterFunction("GetInteractionTypeName"sv, kScriptName, GetInteractionTypeName, true);
+
+        vm->RegisterFunction("RegisterForInteractionChanged"sv, kScriptName, RegisterForm, true);
+        vm->RegisterFunction("UnregisterForInteractionChanged"sv, kScriptName, UnregisterForm, true);
+        vm->RegisterFunction("RegisterAliasForInteractionChanged"sv, kScriptName, RegisterAlias, true);
+        vm->RegisterFunction("UnregisterAliasForInteractionChanged"sv, kScriptName, UnregisterAlias, true);
+        vm->RegisterFunction("RegisterEffectForInteractionChanged"sv, kScriptName, RegisterEffect, true);
+        vm->RegisterFunction("UnregisterEffectForInteractionChanged"sv, kScriptName, UnregisterEffect, true);
+
+        vm->RegisterFunction("DumpMetrics"sv, kScriptName, DumpMetrics, true);
+        return true;
+    }
+
+    // Registrations outlive a session like SKSE's own RegisterFor* events
+    void SaveRegistrations(SKSE::SerializationInterface* serialization) {
+        std::vector<ScriptVM::Handle> handles;
+        batcher.ForEachRegistration([&handles](ScriptVM::Handle handle) { handles.push_back(handle); });
+
+        if (!serialization->OpenRecord(kRegistrationsRecord, kRegistrationsVersion)) {
+            logger::error("Could not open co-save record for Papyrus registrations");
+            return;
+        }
+        const auto count = static_cast<uint32_t>(handles.size());
+        serialization->WriteRecordData(count);
+        for (const auto handle : handles) {
+            serialization->WriteRecordData(handle);
+        }
+    }
+
+    void LoadRegistrations(SKSE::SerializationInterface* serialization) {
+        auto* vm = RE::BSScript::Internal::VirtualMachine::GetSingleton();
+        if (!vm) {
+            logger::error("No Papyrus VM; Papyrus registrations were not loaded");
+            return;
+        }
+        auto* policy = vm->GetObjectHandlePolicy();
+
+        uint32_t type = 0;
+        uint32_t version = 0;
+        uint32_t length = 0;
+        while (serialization->GetNextRecordInfo(type, version, length)) {
+            if (type != kRegistrationsRecord) continue;
+            if (version != kRegistrationsVersion) {
+                logger::warn("Skipping Papyrus registrations saved with record version {}", version);
+                continue;
+            }
+
+            uint32_t count = 0;
+            serialization->ReadRecordData(count);
+            for (uint32_t i = 0; i < count; i++) {
+                RE::VMHandle saved = 0;
+                RE::VMHandle resolved = 0;
+                if (serialization->ReadRecordData(saved) != sizeof(saved)) {
+                    logger::error("Papyrus registration record is truncated");
+                    break;
+                }
+                // Objects that no longer exist resolve to nothing and are dropped. The rest are
+                // persisted again, as RegisterObject does; Revert and Unregister release them.
+                if (serialization->ResolveHandle(saved, resolved) && batcher.Register(resolved)) {
+                    policy->PersistHandle(resolved);
+                }
+            }
+        }
+    }
+
+    void RevertRegistrations(SKSE::SerializationInterface*) {
+        if (auto* vm = RE::BSScript::Internal::VirtualMachine::GetSingleton()) {
+            auto* policy = vm->GetObjectHandlePolicy();
+            batcher.ForEachRegistration([policy](ScriptVM::Handle handle) { policy->ReleaseHandle(handle); });
+        }
+        batcher.Clear();
+    }
+}
+
+namespace PapyrusBridge {
+    bool Init() {
+        auto* papyrus = SKSE::GetPapyrusInterface();
+        if (!papyrus || !papyrus->Register(RegisterFunctions)) {
+            logger::error("Could not register Papyrus natives for {}", kScriptName);
+            return false;
+        }
+
+        auto* serialization = SKSE::GetSerializationInterface();
+        if (!serialization) {
+            logger::error("No serialization interface; Papyrus registrations will not be saved");
+            return false;
+        }
+        serialization->SetUniqueID(kSerializationID);
+        serialization->SetSaveCallback(SaveRegistrations);
+        serialization->SetLoadCallback(LoadRegistrations);
+        serialization->SetRevertCallback(RevertRegistrations);
+        return true;
+    }
+
+    bool OnInteractionChanged(uint32_t formID, InteractionType type) {
+        return batcher.OnChange(formID, type);
+    }
+
+    void ScheduleFlush() {
+        // Later in this frame's game-thread slice, so the frame's other changes fold into one event.
+        // With the queue full, send now rather than leave the batch waiting for a flush that never comes.
+        if (!JobBridge::Post(JobBridge::Target::kGame, [] { FlushEvents(); })) {
+            FlushEvents();
+        }
+    }
+
+    InteractionEventBatcher::Stats GetStats() {
+        return batcher.GetStats();
+    }
+}
@@ -0,0 +1,81 @@
+#include "ScriptEvents.h"
+#include <algorithm>
+
+bool InteractionEventBatcher::Register(ScriptVM::Handle handle) {
+    std::lock_guard lock(mutex);
+    const auto it = std::lower_bound(handles.begin(), handles.end(), handle);
+    if (it != handles.end() && *it == handle) return false;
+    handles.insert(it, handle);
+    registrationCount.store(static_cast<uint32_t>(handles.size()), std::memory_order_relaxed);
+    return true;
+}
+
+bool InteractionEventBatcher::Unregister(ScriptVM::Handle handle) {
+    std::lock_guard lock(mutex);
+    const auto it = std::lower_bound(handles.begin(), handles.end(), handle);
+    if (it == handles.end() || *it != handle) return false;
+    handles.erase(it);
+    registrationCount.store(static_cast<uint32_t>(handles.size()), std::memory_order_relaxed);
+    return true;
+}
+
+void InteractionEventBatcher::Clear() {
+    std::lock_guard lock(mutex);
+    handles.clear();
+    registrationCount.store(0, std::memory_order_relaxed);
+}
+
+bool InteractionEventBatcher::OnChange(uint32_t formID, InteractionType type) {
+    // Tracked even with nobody listening, so a later registration starts from the real state
+    const uint32_t previousFormID = lastFormID;
+    const InteractionType previousType = lastType;
+    lastFormID = formID;
+    lastType = type;
+
+    if (registrationCount.load(std::memory_order_relaxed) == 0) return false;
+
+    changes.fetch_add(1, std::memory_order_relaxed);
+    if (!batchOpen) {
+        batchOpen = true;
+        batchStartFormID = previousFormID;
+        pending.previousType = previousType;
+        pending.changes = 0;
+    }
+    pending.formID = formID;
+    pending.type = type;
+    pending.changes++;
+
+    if (flushQueued) return false;
+    flushQueued = true;
+    return true;
+}
+
+uint32_t InteractionEventBatcher::Flush(ScriptVM& vm) {
+    flushQueued = false;
+    if (!batchOpen) return 0;
+    batchOpen = false;
+
+    if (pending.formID == batchStartFormID && pending.type == pending.previousType) {
+        cancelled.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    std::lock_guard lock(mutex);
+    if (handles.empty()) return 0;
+    vm.SendInteractionChanged(handles.data(), handles.size(), pending);
+
+    const auto count = static_cast<uint32_t>(handles.size());
+    batches.fetch_add(1, std::memory_order_relaxed);
+    events.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+InteractionEventBatcher::Stats InteractionEventBatcher::GetStats() const {
+    Stats stats;
+    stats.registrations = registrationCount.load(std::memory_order_relaxed);
+    stats.changes = changes.load(std::memory_order_relaxed);
+    stats.batches = batches.load(std::memory_order_relaxed);
+    stats.events = events.load(std::memory_order_relaxed);
+    stats.cancelled = cancelled.load(std::memory_order_relaxed);
+    return stats;
+}
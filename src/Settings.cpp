@@ -0,0 +1,268 @@
+#include "Settings.h"
+#include "Allocator.h"
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <mutex>
+
+namespace Settings {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        // One row per key; Parse and Serialize both walk this table
+        struct Field {
+            const char* section;
+            const char* key;
+            bool (*read)(std::string_view value, Snapshot& snapshot);
+            void (*write)(const Snapshot& snapshot, std::string& out);
+        };
+
+        std::string_view Trim(std::string_view text) {
+            const auto first = text.find_first_not_of(" \t\r");
+            if (first == std::string_view::npos) return {};
+            const auto last = text.find_last_not_of(" \t\r");
+            return text.substr(first, last - first + 1);
+        }
+
+        bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+            if (a.size() != b.size()) return false;
+            for (std::size_t i = 0; i < a.size(); i++) {
+                const auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; };
+                if (lower(a[i]) != lower(b[i])) return false;
+            }
+            return true;
+        }
+
+        // Decimal, or hexadecimal with a 0x prefix (the usual way to write virtual-key codes)
+        bool ReadUInt(std::string_view value, uint32_t& out) {
+            int base = 10;
+            if (value.size() > 2 && value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
+                value.remove_prefix(2);
+                base = 16;
+            }
+            const auto result = std::from_chars(value.data(), value.data() + value.size(), out, base);
+            return result.ec == std::errc{} && result.ptr == value.data() + value.size();
+        }
+
+        bool ReadFloat(std::string_view value, float& out) {
+            const auto result = std::from_chars(value.data(), value.data() + value.size(), out);
+            return result.ec == std::errc{} && result.ptr == value.data() + value.size();
+        }
+
+        bool ReadBool(std::string_view value, bool& out) {
+            if (EqualsIgnoreCase(value, "true") || value == "1") {
+                out = true;
+                return true;
+            }
+            if (EqualsIgnoreCase(value, "false") || value == "0") {
+                out = false;
+                return true;
+            }
+            return false;
+        }
+
+        void WriteUInt(uint32_t value, std::string& out, bool hex = false) {
+            char buffer[16];
+            char* begin = buffer;
+            if (hex) {
+                *begin++ = '0';
+                *begin++ = 'x';
+            }
+            const auto result = std::to_chars(begin, std::end(buffer), value, hex ? 16 : 10);
+            out.append(buffer, result.ptr);
+        }
+
+        void WriteFloat(float value, std::string& out) {
+            char buffer[32];
+            const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+            out.append(buffer, result.ptr);
+        }
+
+        constexpr std::array<Field, 11> kFields = {{
+            { "General", "ToggleKey",
+                [](std::string_view value, Snapshot& s) { return ReadUInt(value, s.toggleKey) && s.toggleKey > 0 && s.toggleKey < 256; },
+                [](const Snapshot& s, std::string& out) { WriteUInt(s.toggleKey, out, true); } },
+            { "Crosshair", "Size",
+                [](std::string_view value, Snapshot& s) { return ReadFloat(value, s.crosshairSize) && s.crosshairSize >= 1.0f && s.crosshairSize <= 512.0f; },
+                [](const Snapshot& s, std::string& out) { WriteFloat(s.crosshairSize, out); } },
+            { "Crosshair", "Source",
+                [](std::string_view value, Snapshot& s) {
+                    for (std::size_t i = 0; i < kCrosshairSourceCount; i++) {
+                        const auto source = static_cast<CrosshairSource>(i);
+                        if (EqualsIgnoreCase(value, CrosshairSourceName(source))) {
+                            s.crosshairSource = source;
+                            return true;
+                        }
+                    }
+                    return false;
+                },
+                [](const Snapshot& s, std::string& out) { out += CrosshairSourceName(s.crosshairSource); } },
+            { "Crosshair", "TransitionMs",
+                [](std::string_view value, Snapshot& s) { return ReadUInt(value, s.transitionMs) && s.transitionMs <= 2000; },
+                [](const Snapshot& s, std::string& out) { WriteUInt(s.transitionMs, out); } },
+            { "Crosshair", "InfoCards",
+                [](std::string_view value, Snapshot& s) { return ReadBool(value, s.infoCardsEnabled); },
+                [](const Snapshot& s, std::string& out) { out += s.infoCardsEnabled ? "true" : "false"; } },
+            { "Markers", "Enabled",
+                [](std::string_view value, Snapshot& s) { return ReadBool(value, s.markersEnabled); },
+                [](const Snapshot& s, std::string& out) { out += s.markersEnabled ? "true" : "false"; } },
+            { "Markers", "Radius",
+                [](std::string_view value, Snapshot& s) { return ReadFloat(value, s.markerRadius) && s.markerRadius >= 256.0f && s.markerRadius <= 16384.0f; },
+                [](const Snapshot& s, std::string& out) { WriteFloat(s.markerRadius, out); } },
+            { "Performance", "FrameBudgetUs",
+                [](std::string_view value, Snapshot& s) { return ReadUInt(value, s.frameBudgetUs) && s.frameBudgetUs <= 100000; },
+                [](const Snapshot& s, std::string& out) { WriteUInt(s.frameBudgetUs, out); } },
+            { "Features", "Overlay",
+                [](std::string_view value, Snapshot& s) { return ReadBool(value, s.overlayEnabled); },
+                [](const Snapshot& s, std::string& out) { out += s.overlayEnabled ? "true" : "false"; } },
+            { "Features", "Menu",
+                [](std::string_view value, Snapshot& s) { return ReadBool(value, s.menuEnabled); },
+                [](const Snapshot& s, std::string& out) { out += s.menuEnabled ? "true" : "false"; } },
+            { "Features", "Tracing",
+                [](std::string_view value, Snapshot& s) { return ReadBool(value, s.tracingEnabled); },
+                [](const Snapshot& s, std::string& out) { out += s.tracingEnabled ? "true" : "false"; } },
+        }};
+
+        // The default snapshot is static so Get never sees null
+        const Snapshot defaults;
+        std::atomic<const Snapshot*> current = &defaults;
+
+        // Writer side: replaced snapshots wait out the grace period before they are freed
+        struct Retired {
+            const Snapshot* snapshot;
+            Clock::time_point since;
+        };
+        std::mutex writeMutex;
+        Memory::Vector<Retired, Memory::Tag::kSettings> retired;
+        uint32_t nextGeneration = 1;
+
+        void ReclaimLocked(Clock::time_point now) {
+            // Oldest first, so stop at the first one still in its grace period
+            std::size_t freed = 0;
+            while (freed < retired.size() && now - retired[freed].since >= std::chrono::milliseconds(kGracePeriodMs)) {
+                Memory::Delete(const_cast<Snapshot*>(retired[freed].snapshot));
+                freed++;
+            }
+            retired.erase(retired.begin(), retired.begin() + static_cast<std::ptrdiff_t>(freed));
+        }
+
+        void PublishLocked(const Snapshot& snapshot) {
+            auto* next = Memory::New<Snapshot>(Memory::Tag::kSettings, snapshot);
+            next->generation = nextGeneration++;
+
+            const Snapshot* previous = current.exchange(next, std::memory_order_acq_rel);
+            const auto now = Clock::now();
+            if (previous != &defaults) {
+                retired.push_back({ previous, now });
+            }
+            ReclaimLocked(now);
+        }
+    }
+
+    const char* CrosshairSourceName(CrosshairSource source) {
+        switch (source) {
+            case CrosshairSource::Images:      return "Images";
+            case CrosshairSource::IconFont:    return "IconFont";
+            case CrosshairSource::WebIconPack: return "WebIconPack";
+            default:                           return "Images";
+        }
+    }
+
+    Snapshot Parse(std::string_view text, std::vector<std::string>& warnings) {
+        Snapshot snapshot;
+        std::string_view section;
+        uint32_t lineNumber = 0;
+
+        while (!text.empty()) {
+            const auto end = text.find('\n');
+            std::string_view line = Trim(text.substr(0, end));
+            text = end == std::string_view::npos ? std::string_view{} : text.substr(end + 1);
+            lineNumber++;
+
+            if (line.empty() || line[0] == ';' || line[0] == '#') continue;
+
+            if (line.front() == '[') {
+                if (line.back() != ']') {
+                    warnings.push_back("line " + std::to_string(lineNumber) + ": unterminated section header");
+                    continue;
+                }
+                section = Trim(line.substr(1, line.size() - 2));
+                continue;
+            }
+
+            const auto equals = line.find('=');
+            if (equals == std::string_view::npos) {
+                warnings.push_back("line " + std::to_string(lineNumber) + ": expected key = value");
+                continue;
+            }
+            const std::string_view key = Trim(line.substr(0, equals));
+            std::string_view value = Trim(line.substr(equals + 1));
+            // Trailing comments
+            if (const auto comment = value.find_first_of(";#"); comment != std::string_view::npos) {
+                value = Trim(value.substr(0, comment));
+            }
+
+            const Field* field = nullptr;
+            for (const auto& candidate : kFields) {
+                if (EqualsIgnoreCase(section, candidate.section) && EqualsIgnoreCase(key, candidate.key)) {
+                    field = &candidate;
+                    break;
+                }
+            }
+            if (!field) {
+                warnings.push_back("line " + std::to_string(lineNumber) + ": unknown key [" + std::string(section) + "] " + std::string(key));
+                continue;
+            }
+
+            // A bad value leaves the default in place
+            Snapshot parsed = snapshot;
+            if (field->read(value, parsed)) {
+                snapshot = parsed;
+            } else {
+                warnings.push_back("line " + std::to_string(lineNumber) + ": invalid value '" + std::string(value) + "' for " + std::string(key));
+            }
+        }
+        return snapshot;
+    }
+
+    std::string Serialize(const Snapshot& snapshot) {
+        std::string out = "; DynamicCrosshairFramework settings. Reloaded automatically when saved.\n";
+        const char* section = nullptr;
+        for (const auto& field : kFields) {
+            if (!section || std::string_view(section) != field.section) {
+                out += "\n[";
+                section = field.section;
+                out += section;
+                out += "]\n";
+            }
+            out += field.key;
+            out += " = ";
+            field.write(snapshot, out);
+            out += '\n';
+        }
+        return out;
+    }
+
+    const Snapshot& Get() {
+        return *current.load(std::memory_order_acquire);
+    }
+
+    void Publish(const Snapshot& snapshot) {
+        std::lock_guard lock(writeMutex);
+        PublishLocked(snapshot);
+    }
+
+    void Update(const InplaceFunction<void(Snapshot&), 32>& edit) {
+        std::lock_guard lock(writeMutex);
+        Snapshot next = *current.load(std::memory_order_relaxed);
+        edit(next);
+        PublishLocked(next);
+    }
+
+    std::size_t Reclaim() {
+        std::lock_guard lock(writeMutex);
+        ReclaimLocked(Clock::now());
+        return retired.size();
+    }
+}
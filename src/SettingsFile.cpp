@@ -0,0 +1,167 @@
+#include "SettingsFile.h"
+#include "Trace.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace logger = SKSE::log;
+
+namespace SettingsFile {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr auto kPollInterval = std::chrono::milliseconds(250);
+        // A save waits until the menu has been quiet this long
+        constexpr auto kSaveDelay = std::chrono::milliseconds(500);
+
+        std::filesystem::path filePath;
+        // Never destroyed: nothing joins the watch thread at exit, and a joinable ~thread calls std::terminate
+        std::thread& watchThread = *new std::thread;
+        std::mutex watchMutex;
+        std::condition_variable watchWake;
+        bool stopRequested = false;
+        bool savePending = false;
+        Clock::time_point saveRequestedAt;
+
+        // Watch thread only (and Init, before it starts)
+        std::filesystem::file_time_type lastWriteTime{};
+
+        std::filesystem::file_time_type GetWriteTime() {
+            std::error_code error;
+            const auto time = std::filesystem::last_write_time(filePath, error);
+            return error ? std::filesystem::file_time_type{} : time;
+        }
+
+        bool Load() {
+            std::FILE* file = std::fopen(filePath.string().c_str(), "rb");
+            if (!file) return false;
+
+            std::string text;
+            char buffer[4096];
+            std::size_t read;
+            while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+                text.append(buffer, read);
+            }
+            std::fclose(file);
+
+            std::vector<std::string> warnings;
+            const Settings::Snapshot snapshot = Settings::Parse(text, warnings);
+            for (const auto& warning : warnings) {
+                logger::warn("{}: {}", filePath.filename().string(), warning);
+            }
+            Settings::Publish(snapshot);
+            return true;
+        }
+
+        // Written beside the file and renamed over it, so the game never reads half a file
+        bool Save() {
+            const std::string text = Settings::Serialize(Settings::Get());
+            auto tempPath = filePath;
+            tempPath += ".tmp";
+
+            std::FILE* file = std::fopen(tempPath.string().c_str(), "wb");
+            if (!file) {
+                logger::error("Could not write {}", tempPath.string());
+                return false;
+            }
+            const bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+            const bool closed = std::fclose(file) == 0;
+
+            std::error_code error;
+            if (!written || !closed) {
+                std::filesystem::remove(tempPath, error);
+                logger::error("Could not write {}", tempPath.string());
+                return false;
+            }
+            std::filesystem::rename(tempPath, filePath, error);
+            if (error) {
+                logger::error("Could not replace {}: {}", filePath.string(), error.message());
+                return false;
+            }
+            // Our own write is not an external edit
+            lastWriteTime = GetWriteTime();
+            return true;
+        }
+
+        void WatchLoop() {
+            Trace::SetThreadName("Settings");
+            std::unique_lock lock(watchMutex);
+            while (!stopRequested) {
+                watchWake.wait_for(lock, kPollInterval);
+
+                const bool saveDue = savePending && Clock::now() - saveRequestedAt >= kSaveDelay;
+                if (saveDue) {
+                    savePending = false;
+                }
+                lock.unlock();
+
+                // Snapshots replaced by the last edits are otherwise only freed by the next one
+                Settings::Reclaim();
+
+                if (saveDue) {
+                    TRACE_SCOPE("SettingsFile::Save");
+                    Save();
+                } else if (const auto writeTime = GetWriteTime(); writeTime != lastWriteTime) {
+                    // Unsaved menu edits lose to an edit made in the file
+                    TRACE_SCOPE("SettingsFile::Reload");
+                    lastWriteTime = writeTime;
+                    if (Load()) {
+                        logger::info("Reloaded {}", filePath.filename().string());
+                    }
+                }
+
+                lock.lock();
+            }
+
+            // Flush an edit made just before shutdown
+            if (savePending) {
+                savePending = false;
+                lock.unlock();
+                Save();
+            }
+        }
+    }
+
+    bool Init(const std::filesystem::path& path) {
+        if (watchThread.joinable()) return true;
+
+        filePath = path;
+        if (Load()) {
+            logger::info("Loaded settings from {}", filePath.string());
+        } else {
+            logger::info("No settings file; writing defaults to {}", filePath.string());
+            std::error_code error;
+            std::filesystem::create_directories(filePath.parent_path(), error);
+            if (!Save()) {
+                return false;
+            }
+        }
+        lastWriteTime = GetWriteTime();
+
+        stopRequested = false;
+        watchThread = std::thread(WatchLoop);
+        return true;
+    }
+
+    void Shutdown() {
+        if (!watchThread.joinable()) return;
+
+        {
+            std::lock_guard lock(watchMutex);
+            stopRequested = true;
+        }
+        watchWake.notify_one();
+        watchThread.join();
+    }
+
+    void RequestSave() {
+        std::lock_guard lock(watchMutex);
+        savePending = true;
+        saveRequestedAt = Clock::now();
+    }
+}
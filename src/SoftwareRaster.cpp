@@ -0,0 +1,297 @@
+#include "SoftwareRaster.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#if !defined(DCF_SOFTWARE_RASTER_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#	include <emmintrin.h>
+#	define DCF_SOFTWARE_RASTER_SSE2 1
+#endif
+
+namespace Raster {
+    namespace {
+        struct Point {
+            float x, y;
+        };
+
+        // E(x, y) = a * x + b * y + c, positive on the inside of a counter-clockwise (in y-down space) edge
+        struct Edge {
+            float a, b, c;
+            bool topLeft; // Pixels exactly on a top or left edge belong to this triangle, others to its neighbour
+
+            Edge(const Point& p0, const Point& p1) {
+                a = -(p1.y - p0.y);
+                b = p1.x - p0.x;
+                c = -(a * p0.x + b * p0.y);
+                topLeft = (p1.y < p0.y) || (p1.y == p0.y && p1.x > p0.x);
+            }
+
+            float Eval(float x, float y) const { return a * x + b * y + c; }
+            bool Inside(float w) const { return topLeft ? w >= 0.0f : w > 0.0f; }
+        };
+
+        struct Color {
+            float r, g, b, a; // Premultiplied, 0..1
+        };
+
+        Color UnpackVertexColor(uint32_t col) {
+            const float a = static_cast<float>((col >> 24) & 0xFF) / 255.0f;
+            return {
+                static_cast<float>(col & 0xFF) / 255.0f * a,
+                static_cast<float>((col >> 8) & 0xFF) / 255.0f * a,
+                static_cast<float>((col >> 16) & 0xFF) / 255.0f * a,
+                a
+            };
+        }
+
+#if !defined(DCF_SOFTWARE_RASTER_SSE2)
+        // Premultiplied "over": out = src + dst * (1 - srcAlpha). Inputs and outputs in 0..255.
+        uint32_t BlendPixel(uint32_t dst, float sr, float sg, float sb, float sa) {
+            const float inv = 1.0f - sa / 255.0f;
+            const auto channel = [&](float s, int shift) {
+                const float d = static_cast<float>((dst >> shift) & 0xFF);
+                return static_cast<uint32_t>(std::nearbyint((std::min)(s + d * inv, 255.0f))) << shift;
+            };
+            return channel(sr, 0) | channel(sg, 8) | channel(sb, 16) | channel(sa, 24);
+        }
+#endif
+    }
+
+    uint32_t Premultiply(uint32_t r, uint32_t g, uint32_t b, uint32_t a) {
+        r = (r * a + 127) / 255;
+        g = (g * a + 127) / 255;
+        b = (b * a + 127) / 255;
+        return r | (g << 8) | (b << 16) | (a << 24);
+    }
+
+    void Framebuffer::Resize(uint32_t newWidth, uint32_t newHeight) {
+        width = newWidth;
+        height = newHeight;
+        stride = (width + 3) & ~3u;
+        pixels.assign(static_cast<size_t>(stride) * height, 0);
+    }
+
+    void Framebuffer::Clear(uint32_t rgba) {
+        std::fill(pixels.begin(), pixels.end(), rgba);
+    }
+
+    void Framebuffer::FillTriangles(const Vertex* vertices, const uint16_t* indices, std::size_t indexCount, const Texture& texture, const ClipRect& clip) {
+        for (std::size_t i = 0; i + 2 < indexCount; i += 3) {
+            FillTriangle(vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]], texture, clip);
+        }
+    }
+
+    void Framebuffer::FillTriangle(const Vertex& v0, const Vertex& in1, const Vertex& in2, const Texture& texture, const ClipRect& inClip) {
+        if (pixels.empty() || texture.pixels.empty()) return;
+        const ClipRect clip{
+            (std::max)(inClip.x0, 0), (std::max)(inClip.y0, 0),
+            (std::min)(inClip.x1, static_cast<int>(width)), (std::min)(inClip.y1, static_cast<int>(height))
+        };
+
+        // Triangle setup: orient counter-clockwise so all three edge functions are positive inside
+        float area = (in1.x - v0.x) * (in2.y - v0.y) - (in1.y - v0.y) * (in2.x - v0.x);
+        if (area == 0.0f || !std::isfinite(area)) return;
+
+        const bool flip = area < 0.0f;
+        const Vertex& v1 = flip ? in2 : in1;
+        const Vertex& v2 = flip ? in1 : in2;
+        area = std::fabs(area);
+
+        const int minX = (std::max)(clip.x0, static_cast<int>(std::floor((std::min)({ v0.x, v1.x, v2.x }))));
+        const int minY = (std::max)(clip.y0, static_cast<int>(std::floor((std::min)({ v0.y, v1.y, v2.y }))));
+        const int maxX = (std::min)(clip.x1, static_cast<int>(std::ceil((std::max)({ v0.x, v1.x, v2.x }))));
+        const int maxY = (std::min)(clip.y1, static_cast<int>(std::ceil((std::max)({ v0.y, v1.y, v2.y }))));
+        if (minX >= maxX || minY >= maxY) return;
+
+        // e0 weights v0, e1 weights v1, e2 weights v2
+        const Edge e0({ v1.x, v1.y }, { v2.x, v2.y });
+        const Edge e1({ v2.x, v2.y }, { v0.x, v0.y });
+        const Edge e2({ v0.x, v0.y }, { v1.x, v1.y });
+        const float invArea = 1.0f / area;
+
+        // Attributes as value at v0 plus deltas along the v1 and v2 weights
+        const Color c0 = UnpackVertexColor(v0.color);
+        const Color c1 = UnpackVertexColor(v1.color);
+        const Color c2 = UnpackVertexColor(v2.color);
+        const float texW = static_cast<float>(texture.width);
+        const float texH = static_cast<float>(texture.height);
+        const float maxU = texW - 1.0f;
+        const float maxV = texH - 1.0f;
+
+#if defined(DCF_SOFTWARE_RASTER_SSE2)
+        const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128i laneIndex = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 vInvArea = _mm_set1_ps(invArea);
+        const __m128i byteMask = _mm_set1_epi32(0xFF);
+        const __m128 v255 = _mm_set1_ps(255.0f);
+        const __m128 inv255 = _mm_set1_ps(1.0f / 255.0f);
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        const auto attrib = [](float a0, float a1, float a2, __m128& base, __m128& d1, __m128& d2) {
+            base = _mm_set1_ps(a0);
+            d1 = _mm_set1_ps(a1 - a0);
+            d2 = _mm_set1_ps(a2 - a0);
+        };
+        __m128 uBase, uD1, uD2, vBase, vD1, vD2, rBase, rD1, rD2, gBase, gD1, gD2, bBase, bD1, bD2, aBase, aD1, aD2;
+        attrib(v0.u * texW, v1.u * texW, v2.u * texW, uBase, uD1, uD2);
+        attrib(v0.v * texH, v1.v * texH, v2.v * texH, vBase, vD1, vD2);
+        attrib(c0.r, c1.r, c2.r, rBase, rD1, rD2);
+        attrib(c0.g, c1.g, c2.g, gBase, gD1, gD2);
+        attrib(c0.b, c1.b, c2.b, bBase, bD1, bD2);
+        attrib(c0.a, c1.a, c2.a, aBase, aD1, aD2);
+
+        const __m128 step0 = _mm_set1_ps(e0.a * 4.0f);
+        const __m128 step1 = _mm_set1_ps(e1.a * 4.0f);
+        const __m128 step2 = _mm_set1_ps(e2.a * 4.0f);
+        const __m128i minXv = _mm_set1_epi32(minX - 1);
+        const __m128i maxXv = _mm_set1_epi32(maxX);
+
+        // Selects >= for top-left edges and > for the rest
+        const auto inside = [&](const Edge& e, __m128 w) {
+            return e.topLeft ? _mm_cmpge_ps(w, zero) : _mm_cmpgt_ps(w, zero);
+        };
+
+        const int startX = minX & ~3;
+        for (int y = minY; y < maxY; y++) {
+            const float py = static_cast<float>(y) + 0.5f;
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(startX)), laneOffsets);
+            __m128 w0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e0.a), px), _mm_set1_ps(e0.b * py + e0.c));
+            __m128 w1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e1.a), px), _mm_set1_ps(e1.b * py + e1.c));
+            __m128 w2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e2.a), px), _mm_set1_ps(e2.b * py + e2.c));
+
+            uint32_t* row = pixels.data() + static_cast<size_t>(y) * stride;
+            for (int x = startX; x < maxX; x += 4, w0 = _mm_add_ps(w0, step0), w1 = _mm_add_ps(w1, step1), w2 = _mm_add_ps(w2, step2)) {
+                const __m128i xi = _mm_add_epi32(_mm_set1_epi32(x), laneIndex);
+                const __m128i inRange = _mm_and_si128(_mm_cmpgt_epi32(xi, minXv), _mm_cmplt_epi32(xi, maxXv));
+                const __m128 mask = _mm_and_ps(_mm_and_ps(inside(e0, w0), inside(e1, w1)),
+                                               _mm_and_ps(inside(e2, w2), _mm_castsi128_ps(inRange)));
+                if (_mm_movemask_ps(mask) == 0) continue;
+
+                const __m128 l1 = _mm_mul_ps(w1, vInvArea);
+                const __m128 l2 = _mm_mul_ps(w2, vInvArea);
+                const auto interp = [&](__m128 base, __m128 d1, __m128 d2) {
+                    return _mm_add_ps(base, _mm_add_ps(_mm_mul_ps(d1, l1), _mm_mul_ps(d2, l2)));
+                };
+
+                // Nearest texel, clamped to the edge
+                const __m128 u = _mm_min_ps(_mm_max_ps(interp(uBase, uD1, uD2), zero), _mm_set1_ps(maxU));
+                const __m128 v = _mm_min_ps(_mm_max_ps(interp(vBase, vD1, vD2), zero), _mm_set1_ps(maxV));
+                alignas(16) int32_t tx[4];
+                alignas(16) int32_t ty[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(tx), _mm_cvttps_epi32(u));
+                _mm_store_si128(reinterpret_cast<__m128i*>(ty), _mm_cvttps_epi32(v));
+                const uint32_t* texels = texture.pixels.data();
+                const __m128i texel = _mm_setr_epi32(
+                    static_cast<int>(texels[ty[0] * texture.width + tx[0]]),
+                    static_cast<int>(texels[ty[1] * texture.width + tx[1]]),
+                    static_cast<int>(texels[ty[2] * texture.width + tx[2]]),
+                    static_cast<int>(texels[ty[3] * texture.width + tx[3]]));
+
+                const auto unpack = [&](__m128i px4, int shift) {
+                    return _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(px4, shift), byteMask));
+                };
+
+                // Source = premultiplied texel * premultiplied vertex color, in 0..255
+                const __m128 sr = _mm_mul_ps(unpack(texel, 0), interp(rBase, rD1, rD2));
+                const __m128 sg = _mm_mul_ps(unpack(texel, 8), interp(gBase, gD1, gD2));
+                const __m128 sb = _mm_mul_ps(unpack(texel, 16), interp(bBase, bD1, bD2));
+                const __m128 sa = _mm_mul_ps(unpack(texel, 24), interp(aBase, aD1, aD2));
+                const __m128 inv = _mm_sub_ps(one, _mm_mul_ps(sa, inv255));
+
+                __m128i* dstPtr = reinterpret_cast<__m128i*>(row + x);
+                const __m128i dst = _mm_loadu_si128(dstPtr);
+                const auto blend = [&](__m128 s, int shift) {
+                    const __m128 out = _mm_min_ps(_mm_add_ps(s, _mm_mul_ps(unpack(dst, shift), inv)), v255);
+                    return _mm_slli_epi32(_mm_cvtps_epi32(out), shift);
+                };
+                const __m128i packed = _mm_or_si128(_mm_or_si128(blend(sr, 0), blend(sg, 8)), _mm_or_si128(blend(sb, 16), blend(sa, 24)));
+                const __m128i lanes = _mm_castps_si128(mask);
+                _mm_storeu_si128(dstPtr, _mm_or_si128(_mm_and_si128(lanes, packed), _mm_andnot_si128(lanes, dst)));
+            }
+        }
+#else
+        for (int y = minY; y < maxY; y++) {
+            const float py = static_cast<float>(y) + 0.5f;
+            uint32_t* row = pixels.data() + static_cast<size_t>(y) * stride;
+            for (int x = minX; x < maxX; x++) {
+                const float px = static_cast<float>(x) + 0.5f;
+                const float w0 = e0.Eval(px, py);
+                const float w1 = e1.Eval(px, py);
+                const float w2 = e2.Eval(px, py);
+                if (!e0.Inside(w0) || !e1.Inside(w1) || !e2.Inside(w2)) continue;
+
+                const float l1 = w1 * invArea;
+                const float l2 = w2 * invArea;
+                const auto interp = [&](float a0, float a1, float a2) { return a0 + (a1 - a0) * l1 + (a2 - a0) * l2; };
+
+                const float u = std::clamp(interp(v0.u * texW, v1.u * texW, v2.u * texW), 0.0f, maxU);
+                const float v = std::clamp(interp(v0.v * texH, v1.v * texH, v2.v * texH), 0.0f, maxV);
+                const uint32_t texel = texture.pixels[static_cast<size_t>(v) * texture.width + static_cast<size_t>(u)];
+
+                const auto channel = [&](int shift) { return static_cast<float>((texel >> shift) & 0xFF); };
+                row[x] = BlendPixel(row[x],
+                    channel(0) * interp(c0.r, c1.r, c2.r),
+                    channel(8) * interp(c0.g, c1.g, c2.g),
+                    channel(16) * interp(c0.b, c1.b, c2.b),
+                    channel(24) * interp(c0.a, c1.a, c2.a));
+            }
+        }
+#endif
+    }
+
+    bool Framebuffer::WriteTGA(const char* path) const {
+        std::FILE* file = std::fopen(path, "wb");
+        if (!file) return false;
+
+        // Uncompressed true-colour, 32 bpp, 8 alpha bits, top-left origin. Pixels are written
+        // as-is (premultiplied) so golden images compare bit-exactly.
+        uint8_t header[18] = {};
+        header[2] = 2;
+        header[12] = static_cast<uint8_t>(width & 0xFF);
+        header[13] = static_cast<uint8_t>(width >> 8);
+        header[14] = static_cast<uint8_t>(height & 0xFF);
+        header[15] = static_cast<uint8_t>(height >> 8);
+        header[16] = 32;
+        header[17] = 0x28;
+        bool ok = std::fwrite(header, sizeof(header), 1, file) == 1;
+
+        std::vector<uint8_t> row(static_cast<size_t>(width) * 4);
+        for (uint32_t y = 0; ok && y < height; y++) {
+            const uint32_t* src = pixels.data() + static_cast<size_t>(y) * stride;
+            for (uint32_t x = 0; x < width; x++) {
+                row[x * 4 + 0] = static_cast<uint8_t>(src[x] >> 16);
+                row[x * 4 + 1] = static_cast<uint8_t>(src[x] >> 8);
+                row[x * 4 + 2] = static_cast<uint8_t>(src[x]);
+                row[x * 4 + 3] = static_cast<uint8_t>(src[x] >> 24);
+            }
+            ok = std::fwrite(row.data(), row.size(), 1, file) == 1;
+        }
+
+        std::fclose(file);
+        return ok;
+    }
+
+    bool ReadTGA(const char* path, uint32_t& width, uint32_t& height, std::vector<uint32_t>& pixels) {
+        std::FILE* file = std::fopen(path, "rb");
+        if (!file) return false;
+
+        uint8_t header[18] = {};
+        bool ok = std::fread(header, sizeof(header), 1, file) == 1 && header[0] == 0 && header[1] == 0 && header[2] == 2 &&
+                  header[16] == 32 && (header[17] & 0x20) != 0;
+        if (ok) {
+            width = header[12] | (header[13] << 8);
+            height = header[14] | (header[15] << 8);
+            std::vector<uint8_t> bytes(static_cast<size_t>(width) * height * 4);
+            ok = bytes.empty() || std::fread(bytes.data(), bytes.size(), 1, file) == 1;
+            pixels.resize(static_cast<size_t>(width) * height);
+            for (size_t i = 0; ok && i < pixels.size(); i++) {
+                const uint8_t* p = bytes.data() + i * 4; // BGRA
+                pixels[i] = p[2] | (p[1] << 8) | (p[0] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+            }
+        }
+
+        std::fclose(file);
+        return ok;
+    }
+}
@@ -0,0 +1,146 @@
+#include "SoftwareRenderBackend.h"
+#include <cmath>
+
+// The rasterizer unpacks vertex colours with R in the low byte
+static_assert(IM_COL32_R_SHIFT == 0 && IM_COL32_G_SHIFT == 8 && IM_COL32_B_SHIFT == 16 && IM_COL32_A_SHIFT == 24,
+    "SoftwareRenderBackend needs the default IM_COL32 packing");
+
+SoftwareRenderBackend::SoftwareRenderBackend(uint32_t width, uint32_t height) :
+    framebuffer(width, height) {}
+
+bool SoftwareRenderBackend::Init() {
+    if (initialized) return true;
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererName = "dcf_software";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    unsigned char* pixels = nullptr;
+    int fontWidth = 0;
+    int fontHeight = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &fontWidth, &fontHeight);
+
+    Raster::Texture font;
+    font.width = static_cast<uint32_t>(fontWidth);
+    font.height = static_cast<uint32_t>(fontHeight);
+    font.pixels.resize(static_cast<size_t>(font.width) * font.height);
+    for (size_t i = 0; i < font.pixels.size(); i++) {
+        const unsigned char* p = pixels + i * 4;
+        font.pixels[i] = Raster::Premultiply(p[0], p[1], p[2], p[3]);
+    }
+    textures.push_back(std::move(font));
+    fontTexture = (ImTextureID)(uintptr_t)textures.size();
+    io.Fonts->SetTexID(fontTexture);
+
+    initialized = true;
+    return true;
+}
+
+void SoftwareRenderBackend::Shutdown() {
+    if (!initialized) return;
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.Fonts->SetTexID(ImTextureID{});
+    io.BackendRendererName = nullptr;
+    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+
+    textures.clear();
+    fontTexture = ImTextureID{};
+    initialized = false;
+}
+
+void SoftwareRenderBackend::NewFrame() {
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = GetDisplaySize();
+    io.DeltaTime = 1.0f / 60.0f; // Fixed, so rendered frames are reproducible
+}
+
+ImVec2 SoftwareRenderBackend::GetDisplaySize() const {
+    return ImVec2(static_cast<float>(framebuffer.GetWidth()), static_cast<float>(framebuffer.GetHeight()));
+}
+
+void SoftwareRenderBackend::Resize(uint32_t width, uint32_t height) {
+    framebuffer.Resize(width, height);
+}
+
+void SoftwareRenderBackend::Clear(uint32_t rgba) {
+    framebuffer.Clear(rgba);
+}
+
+ImTextureID SoftwareRenderBackend::CreateTexture(uint32_t texWidth, uint32_t texHeight, const uint8_t* pixels) {
+    Raster::Texture texture;
+    texture.width = texWidth;
+    texture.height = texHeight;
+    texture.pixels.resize(static_cast<size_t>(texWidth) * texHeight);
+    for (size_t i = 0; i < texture.pixels.size(); i++) {
+        const uint8_t* p = pixels + i * 4; // BGRA
+        texture.pixels[i] = p[2] | (p[1] << 8) | (p[0] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    // Reuse a released slot so IDs stay small
+    for (size_t i = 0; i < textures.size(); i++) {
+        if (textures[i].pixels.empty()) {
+            textures[i] = std::move(texture);
+            return (ImTextureID)(uintptr_t)(i + 1);
+        }
+    }
+    textures.push_back(std::move(texture));
+    return (ImTextureID)(uintptr_t)textures.size();
+}
+
+void SoftwareRenderBackend::ReleaseTexture(ImTextureID texture) {
+    const auto index = (uintptr_t)texture;
+    if (index == 0 || index > textures.size() || texture == fontTexture) return;
+
+    textures[index - 1] = Raster::Texture{};
+}
+
+const Raster::Texture* SoftwareRenderBackend::LookupTexture(ImTextureID id) const {
+    const auto index = (uintptr_t)id;
+    if (index == 0 || index > textures.size() || textures[index - 1].pixels.empty()) {
+        return nullptr;
+    }
+    return &textures[index - 1];
+}
+
+void SoftwareRenderBackend::RenderDrawData(ImDrawData* drawData) {
+    if (!drawData || !drawData->Valid || !framebuffer.GetWidth() || !framebuffer.GetHeight()) return;
+
+    const ImVec2 clipOff = drawData->DisplayPos;
+    const ImVec2 clipScale = drawData->FramebufferScale;
+    const auto toFramebuffer = [&](const ImDrawVert& v) {
+        return Raster::Vertex{ (v.pos.x - clipOff.x) * clipScale.x, (v.pos.y - clipOff.y) * clipScale.y, v.uv.x, v.uv.y, v.col };
+    };
+
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList* drawList = drawData->CmdLists[n];
+        const ImDrawVert* vtxBuffer = drawList->VtxBuffer.Data;
+        const ImDrawIdx* idxBuffer = drawList->IdxBuffer.Data;
+
+        for (const ImDrawCmd& cmd : drawList->CmdBuffer) {
+            if (cmd.UserCallback) {
+                if (cmd.UserCallback != ImDrawCallback_ResetRenderState) {
+                    cmd.UserCallback(drawList, &cmd);
+                }
+                continue;
+            }
+
+            const Raster::ClipRect clip{
+                static_cast<int>(std::floor((cmd.ClipRect.x - clipOff.x) * clipScale.x)),
+                static_cast<int>(std::floor((cmd.ClipRect.y - clipOff.y) * clipScale.y)),
+                static_cast<int>(std::ceil((cmd.ClipRect.z - clipOff.x) * clipScale.x)),
+                static_cast<int>(std::ceil((cmd.ClipRect.w - clipOff.y) * clipScale.y))
+            };
+            if (clip.x1 <= clip.x0 || clip.y1 <= clip.y0) continue;
+
+            const Raster::Texture* texture = LookupTexture(cmd.GetTexID());
+            if (!texture) continue;
+
+            const ImDrawIdx* idx = idxBuffer + cmd.IdxOffset;
+            const ImDrawVert* vtx = vtxBuffer + cmd.VtxOffset;
+            for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3) {
+                framebuffer.FillTriangle(toFramebuffer(vtx[idx[i]]), toFramebuffer(vtx[idx[i + 1]]), toFramebuffer(vtx[idx[i + 2]]), *texture, clip);
+            }
+        }
+    }
+}
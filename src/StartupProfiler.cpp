@@ -0,0 +1,49 @@
+#include "StartupProfiler.h"
+#include "Metrics.h"
+#include <mutex>
+
+namespace logger = SKSE::log;
+
+namespace StartupProfiler {
+    namespace {
+        std::mutex mutex;
+        std::array<Phase, kMaxPhases> phases;
+        uint32_t phaseCount = 0;
+    }
+
+    void Record(const char* name, Kind kind, int64_t startNs, int64_t durationNs) {
+        {
+            std::lock_guard lock(mutex);
+            if (phaseCount < kMaxPhases) {
+                phases[phaseCount++] = { name, kind, startNs, durationNs };
+            }
+        }
+        logger::info("Startup phase '{}' took {:.2f} ms{}", name, durationNs / 1e6, kind == Kind::kDeferred ? " (deferred)" : "");
+    }
+
+    uint32_t GetPhases(std::array<Phase, kMaxPhases>& out) {
+        std::lock_guard lock(mutex);
+        out = phases;
+        return phaseCount;
+    }
+
+    int64_t GetTotalNs(Kind kind) {
+        std::lock_guard lock(mutex);
+        int64_t total = 0;
+        for (uint32_t i = 0; i < phaseCount; i++) {
+            if (phases[i].kind == kind) total += phases[i].durationNs;
+        }
+        return total;
+    }
+
+    void LogSummary() {
+        logger::info("Startup: {:.2f} ms during loading, {:.2f} ms deferred",
+            GetTotalNs(Kind::kBlocking) / 1e6, GetTotalNs(Kind::kDeferred) / 1e6);
+    }
+
+    Scope::Scope(const char* name, Kind kind) : name(name), kind(kind), startNs(Metrics::NowNs()) {}
+
+    Scope::~Scope() {
+        Record(name, kind, startNs, Metrics::NowNs() - startNs);
+    }
+}
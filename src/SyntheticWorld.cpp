@@ -0,0 +1,97 @@
+#include "SyntheticWorld.h"
+#include <array>
+
+namespace {
+    // splitmix64: tiny, and unlike <random> distributions gives the same sequence everywhere
+    uint64_t NextRandom(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    uint32_t NextBelow(uint64_t& state, uint32_t bound) {
+        return static_cast<uint32_t>(NextRandom(state) % bound);
+    }
+
+    struct MixEntry {
+        uint8_t baseType;
+        uint32_t weight;
+    };
+
+    // Roughly what the crosshair passes over in a furnished, populated interior
+    constexpr std::array<MixEntry, 10> kMix = { {
+        { static_cast<uint8_t>(BaseType::kActivator), 8 },
+        { static_cast<uint8_t>(BaseType::kBook), 5 },
+        { static_cast<uint8_t>(BaseType::kContainer), 14 },
+        { static_cast<uint8_t>(BaseType::kDoor), 12 },
+        { static_cast<uint8_t>(BaseType::kTree), 3 },
+        { static_cast<uint8_t>(BaseType::kFlora), 10 },
+        { static_cast<uint8_t>(BaseType::kFurniture), 16 },
+        { static_cast<uint8_t>(BaseType::kNPC), 20 },
+        { 32, 8 },  // Misc item: no activation flags
+        { 41, 4 },  // Weapon: no activation flags
+    } };
+
+    constexpr uint32_t TotalWeight() {
+        uint32_t total = 0;
+        for (const auto& entry : kMix) {
+            total += entry.weight;
+        }
+        return total;
+    }
+}
+
+SyntheticWorld::Object& SyntheticWorld::Add(uint8_t baseType) {
+    Object& object = objects.emplace_back();
+    object.formID = nextFormID++;
+    object.baseType = baseType;
+    return object;
+}
+
+void SyntheticWorld::Populate(std::size_t count, uint64_t seed) {
+    objects.reserve(objects.size() + count);
+    uint64_t state = seed;
+    for (std::size_t i = 0; i < count; i++) {
+        uint32_t pick = NextBelow(state, TotalWeight());
+        uint8_t baseType = kMix.back().baseType;
+        for (const auto& entry : kMix) {
+            if (pick < entry.weight) {
+                baseType = entry.baseType;
+                break;
+            }
+            pick -= entry.weight;
+        }
+
+        Object& object = Add(baseType);
+        // A sliver of references whose base form failed to resolve
+        if (NextBelow(state, 200) == 0) {
+            object.hasBase = false;
+            continue;
+        }
+        if (object.baseType == static_cast<uint8_t>(BaseType::kDoor) && NextBelow(state, 3) == 0) {
+            object.lock.locked = true;
+            // kVeryEasy..kRequiresKey
+            object.lock.level = static_cast<LockLevel>(NextBelow(state, 6));
+        }
+        // Actors' bases are NPCs; a quarter of them lie dead
+        if (object.baseType == static_cast<uint8_t>(BaseType::kNPC)) {
+            object.dead = NextBelow(state, 4) == 0;
+        }
+    }
+}
+
+void SyntheticWorld::Clear() {
+    objects.clear();
+    nextFormID = kFirstFormID;
+}
+
+void SyntheticWorld::SetPlayerItemCount(uint32_t itemFormID, int32_t count) {
+    for (auto& [formID, itemCount] : inventory) {
+        if (formID == itemFormID) {
+            itemCount = count;
+            return;
+        }
+    }
+    inventory.emplace_back(itemFormID, count);
+}
@@ -0,0 +1,222 @@
+#include "Trace.h"
+#include "Allocator.h"
+#include "SPSCQueue.h"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <thread>
+
+namespace Trace {
+    namespace {
+        constexpr std::size_t kMaxThreads = 32;
+        constexpr std::size_t kRingCapacity = 8192;     // 192 KB per traced thread, drained every 20 ms
+        constexpr float kMaxCaptureSeconds = 60.0f;
+        constexpr auto kDrainInterval = std::chrono::milliseconds(20);
+
+        struct Event {
+            const char* name;
+            uint64_t begin;
+            uint64_t end;
+        };
+
+        struct ThreadRing {
+            uint32_t threadIndex;
+            std::atomic<const char*> threadName{ nullptr };
+            SPSCQueue<Event, kRingCapacity> queue;
+        };
+
+        struct CollectedEvent {
+            uint32_t threadIndex;
+            Event event;
+        };
+
+        // Rings are created on a thread's first traced scope and reused by later captures
+        std::array<std::atomic<ThreadRing*>, kMaxThreads> rings;
+        std::atomic<uint32_t> ringCount{ 0 };   // Never above kMaxThreads, so readers can index by it
+        thread_local ThreadRing* threadRing = nullptr;
+        thread_local bool threadOutOfRings = false; // Every slot was taken at this thread's first scope
+        thread_local const char* pendingThreadName = nullptr;
+
+        std::atomic<State> state{ State::kIdle };
+        std::mutex pathMutex;
+        std::filesystem::path outputDirectory;
+        std::string lastCapturePath;
+
+        // Claims the next slot only while one is free; a bare increment would let DrainInto and
+        // WriteChromeTrace read past the array until the failed claim was rolled back
+        bool ReserveRingSlot(uint32_t& index) {
+            uint32_t count = ringCount.load(std::memory_order_relaxed);
+            do {
+                if (count >= kMaxThreads) return false;
+            } while (!ringCount.compare_exchange_weak(count, count + 1, std::memory_order_relaxed));
+            index = count;
+            return true;
+        }
+
+        ThreadRing* GetThreadRing() {
+            if (threadRing) return threadRing;
+
+            uint32_t index = 0;
+            if (threadOutOfRings || !ReserveRingSlot(index)) {
+                threadOutOfRings = true;
+                return nullptr;
+            }
+            threadRing = Memory::New<ThreadRing>(Memory::Tag::kLogging);
+            threadRing->threadIndex = index;
+            threadRing->threadName.store(pendingThreadName, std::memory_order_relaxed);
+            rings[index].store(threadRing, std::memory_order_release);
+            return threadRing;
+        }
+
+        void DrainInto(Memory::Vector<CollectedEvent, Memory::Tag::kLogging>& events) {
+            const uint32_t threads = ringCount.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < threads; i++) {
+                ThreadRing* ring = rings[i].load(std::memory_order_acquire);
+                if (!ring) continue;
+                ring->queue.Drain([&](const Event& event) {
+                    events.push_back({ ring->threadIndex, event });
+                });
+            }
+        }
+
+        void WriteEscaped(std::FILE* file, const char* text) {
+            for (; *text; text++) {
+                if (*text == '"' || *text == '\\') std::fputc('\\', file);
+                std::fputc(*text, file);
+            }
+        }
+
+        bool WriteChromeTrace(const std::filesystem::path& path, const Memory::Vector<CollectedEvent, Memory::Tag::kLogging>& events,
+            uint64_t startTicks, double ticksPerMicrosecond) {
+            std::FILE* file = std::fopen(path.string().c_str(), "wb");
+            if (!file) return false;
+
+            std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+            bool first = true;
+
+            const uint32_t threads = ringCount.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < threads; i++) {
+                ThreadRing* ring = rings[i].load(std::memory_order_acquire);
+                const char* threadName = ring ? ring->threadName.load(std::memory_order_relaxed) : nullptr;
+                if (!threadName) continue;
+                std::fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",\n", i);
+                WriteEscaped(file, threadName);
+                std::fputs("\"}}", file);
+                first = false;
+            }
+
+            for (const auto& [threadIndex, event] : events) {
+                // A scope left open across two captures began before this one
+                if (event.begin < startTicks) continue;
+                const double ts = static_cast<double>(event.begin - startTicks) / ticksPerMicrosecond;
+                const double dur = static_cast<double>(event.end - event.begin) / ticksPerMicrosecond;
+                std::fprintf(file, "%s{\"ph\":\"X\",\"name\":\"", first ? "" : ",\n");
+                WriteEscaped(file, event.name);
+                std::fprintf(file, "\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", threadIndex, ts, dur);
+                first = false;
+            }
+
+            std::fputs("\n]}\n", file);
+            const bool ok = std::ferror(file) == 0;
+            std::fclose(file);
+            return ok;
+        }
+
+        void RunCapture(float seconds, std::filesystem::path path) {
+            Memory::Vector<CollectedEvent, Memory::Tag::kLogging> events;
+            events.reserve(64 * 1024);
+
+            // Paired samples at both ends give the tick rate over exactly the captured interval
+            const auto wallStart = std::chrono::steady_clock::now();
+            const uint64_t startTicks = BinaryLog::Now();
+            detail::capturing.store(true, std::memory_order_relaxed);
+
+            const auto deadline = wallStart + std::chrono::duration<float>(seconds);
+            while (std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(kDrainInterval);
+                DrainInto(events);
+            }
+
+            detail::capturing.store(false, std::memory_order_relaxed);
+            const uint64_t endTicks = BinaryLog::Now();
+            const auto wallEnd = std::chrono::steady_clock::now();
+
+            // Let scopes that were open at the deadline close, then collect them too
+            state.store(State::kWriting, std::memory_order_release);
+            std::this_thread::sleep_for(kDrainInterval);
+            DrainInto(events);
+
+            const double wallUs = std::chrono::duration<double, std::micro>(wallEnd - wallStart).count();
+            const double ticksPerMicrosecond = wallUs > 0.0 ? static_cast<double>(endTicks - startTicks) / wallUs : 1000.0;
+
+            const bool ok = WriteChromeTrace(path, events, startTicks, ticksPerMicrosecond);
+            {
+                std::lock_guard lock(pathMutex);
+                lastCapturePath = ok ? path.string() : std::string();
+            }
+            BLOG_INFO("Trace capture of {:.1f} s: {} events -> {}", seconds, events.size(), ok ? path.string() : std::string("write failed"));
+            state.store(State::kIdle, std::memory_order_release);
+        }
+    }
+
+    void SetOutputDirectory(const std::filesystem::path& directory) {
+        std::lock_guard lock(pathMutex);
+        outputDirectory = directory;
+    }
+
+    bool StartCapture(float seconds) {
+        State expected = State::kIdle;
+        if (!state.compare_exchange_strong(expected, State::kCapturing, std::memory_order_acq_rel)) {
+            return false;
+        }
+
+        std::filesystem::path path;
+        {
+            std::lock_guard lock(pathMutex);
+            if (outputDirectory.empty()) {
+                state.store(State::kIdle, std::memory_order_release);
+                return false;
+            }
+            char fileName[64];
+            const std::time_t now = std::time(nullptr);
+            std::tm local{};
+#if defined(_WIN32)
+            localtime_s(&local, &now);
+#else
+            localtime_r(&now, &local);
+#endif
+            std::strftime(fileName, sizeof(fileName), "DynamicCrosshairFramework-trace-%Y%m%d-%H%M%S.json", &local);
+            path = outputDirectory / fileName;
+        }
+
+        // Detached: completion is reported through the state, and nothing may block on it at exit
+        seconds = (std::min)((std::max)(seconds, 0.1f), kMaxCaptureSeconds);
+        std::thread(RunCapture, seconds, std::move(path)).detach();
+        return true;
+    }
+
+    State GetState() {
+        return state.load(std::memory_order_acquire);
+    }
+
+    std::string GetLastCapturePath() {
+        std::lock_guard lock(pathMutex);
+        return lastCapturePath;
+    }
+
+    void SetThreadName(const char* name) {
+        pendingThreadName = name;
+        if (threadRing) {
+            threadRing->threadName.store(name, std::memory_order_relaxed);
+        }
+    }
+
+    namespace detail {
+        void Record(const char* name, uint64_t begin, uint64_t end) {
+            if (ThreadRing* ring = GetThreadRing()) {
+                ring->queue.TryPush({ name, begin, end });
+            }
+        }
+    }
+}
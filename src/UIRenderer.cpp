@@ -0,0 +1,231 @@
+#include "UIRenderer.h"
+#include "DX11RenderBackend.h"
+#include "BinaryLog.h"
+#include "Trace.h"
+#include "RE/Skyrim.h"
+#include "RE/R/Renderer.h"
+#include <cstring>
+
+namespace logger = SKSE::log;
+
+namespace {
+    // resize keeps the destination's capacity, where ImVector's operator= frees and reallocates
+    template <class T>
+    void CopyInto(ImVector<T>& destination, const ImVector<T>& source) {
+        destination.resize(source.Size);
+        if (source.Size > 0) {
+            std::memcpy(destination.Data, source.Data, source.size_in_bytes());
+        }
+    }
+}
+
+bool UIRenderer::Init() {
+    if (initialized) return true;
+
+    auto* renderer = RE::BSGraphics::Renderer::GetSingleton();
+    if (!renderer) {
+        logger::error("Failed to get BSGraphics::Renderer singleton for UI renderer.");
+        return false;
+    }
+
+    REX::W32::ID3D11Device* device = RE::BSGraphics::Renderer::GetDevice();
+    auto* rendererData = RE::BSGraphics::Renderer::GetRendererDataSingleton();
+    if (!device || !rendererData || !rendererData->context) {
+        logger::error("Failed to get device, renderer data, or context for UI renderer.");
+        return false;
+    }
+
+    auto* currentWindow = RE::BSGraphics::Renderer::GetCurrentRenderWindow();
+    if (!currentWindow) {
+        logger::error("Failed to get current render window for UI renderer.");
+        return false;
+    }
+
+    return Init(std::make_unique<DX11RenderBackend>(
+        reinterpret_cast<ID3D11Device*>(device),
+        reinterpret_cast<ID3D11DeviceContext*>(rendererData->context),
+        reinterpret_cast<HWND>(currentWindow->hWnd)));
+}
+
+bool UIRenderer::Init(std::unique_ptr<RenderBackend> renderBackend) {
+    if (initialized) return true;
+
+    IMGUI_CHECKVERSION();
+
+    // Everything ImGui allocates comes from the plugin's pools instead of the shared heap, counted
+    // under the tag of the layer drawing at the time
+    ImGui::SetAllocatorFunctions(
+        [](size_t size, void* tag) { return Memory::Allocate(size, *static_cast<const Memory::Tag*>(tag)); },
+        [](void* ptr, void*) { Memory::Free(ptr); },
+        &imguiAllocationTag);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
+    io.IniFilename = nullptr;
+
+    // The menu layer turns the cursor on while it is open
+    io.MouseDrawCursor = false;
+
+    ImGui::StyleColorsDark();
+
+    if (!renderBackend || !renderBackend->Init()) {
+        logger::error("Failed to initialize render backend for UI renderer.");
+        ImGui::DestroyContext();
+        return false;
+    }
+    backend = std::move(renderBackend);
+
+    initialized = true;
+    logger::info("Successfully initialized shared ImGui context.");
+    return true;
+}
+
+void UIRenderer::Shutdown() {
+    if (!initialized) return;
+
+    ClearCachedDrawData();
+
+    backend->Shutdown();
+    backend.reset();
+    ImGui::DestroyContext();
+
+    initialized = false;
+    logger::info("Successfully shutdown shared ImGui context.");
+}
+
+void UIRenderer::RegisterLayer(const Layer& layer) {
+    if (layers.size() >= 32) {
+        logger::error("Cannot register UI layer {}: layer limit reached.", layer.name);
+        return;
+    }
+    layers.push_back(layer);
+    dirty = true;
+    logger::info("Registered UI layer: {}", layer.name);
+}
+
+void UIRenderer::Render() {
+    if (!initialized) return;
+
+    const auto start = std::chrono::steady_clock::now();
+    heapCallsAtFrameStart = Memory::GetHeapCallCount();
+    Memory::GetFrameArena().Reset();
+
+    bool interactive = false;
+    const uint32_t activeLayers = GetActiveLayers(interactive);
+    const ImVec2 displaySize = backend->GetDisplaySize();
+
+    const bool replay = !dirty && !interactive && activeLayers == lastActiveLayers &&
+                        displaySize.x == lastDisplaySize.x && displaySize.y == lastDisplaySize.y;
+
+    if (replay) {
+        if (cachedDrawData.CmdListsCount > 0) {
+            backend->RenderDrawData(&cachedDrawData);
+        }
+    } else {
+        BuildFrame(activeLayers, interactive);
+        lastActiveLayers = activeLayers;
+        lastDisplaySize = displaySize;
+        // Interactive frames are not cached, so the frame after one always rebuilds
+        dirty = interactive;
+    }
+
+    RecordFrameTime(start, replay);
+}
+
+uint32_t UIRenderer::GetActiveLayers(bool& interactive) const {
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < layers.size(); i++) {
+        if (layers[i].isActive()) {
+            mask |= 1u << i;
+            interactive |= layers[i].interactive;
+        }
+    }
+    return mask;
+}
+
+void UIRenderer::BuildFrame(uint32_t activeLayers, bool interactive) {
+    TRACE_SCOPE("UIRenderer::BuildFrame");
+    backend->NewFrame();
+    ImGui::NewFrame();
+
+    for (uint32_t i = 0; i < layers.size(); i++) {
+        if (activeLayers & (1u << i)) {
+            imguiAllocationTag = layers[i].allocationTag;
+            layers[i].draw();
+        }
+    }
+    imguiAllocationTag = Memory::Tag::kImGui;
+
+    ImGui::Render();
+    ImDrawData* drawData = ImGui::GetDrawData();
+    backend->RenderDrawData(drawData);
+    // Menus rebuild every frame and would never be replayed
+    if (!interactive) {
+        CacheDrawData(drawData);
+    }
+}
+
+void UIRenderer::CacheDrawData(const ImDrawData* drawData) {
+    cachedDrawData.Clear();
+    if (!drawData || !drawData->Valid) {
+        return;
+    }
+
+    cachedDrawData.Valid = true;
+    cachedDrawData.DisplayPos = drawData->DisplayPos;
+    cachedDrawData.DisplaySize = drawData->DisplaySize;
+    cachedDrawData.FramebufferScale = drawData->FramebufferScale;
+    cachedDrawData.OwnerViewport = drawData->OwnerViewport;
+
+    // Copies the vertex, index and command buffers, so the cache stays valid after ImGui reuses
+    // its own lists on the next NewFrame. The copies are kept across frames and only grow, so
+    // caching stops allocating once they fit the overlay.
+    for (int i = 0; i < drawData->CmdListsCount; i++) {
+        const ImDrawList* source = drawData->CmdLists[i];
+        if (static_cast<std::size_t>(i) == cachedDrawLists.size()) {
+            cachedDrawLists.push_back(IM_NEW(ImDrawList)(source->_Data));
+        }
+        ImDrawList* copy = cachedDrawLists[i];
+        CopyInto(copy->CmdBuffer, source->CmdBuffer);
+        CopyInto(copy->IdxBuffer, source->IdxBuffer);
+        CopyInto(copy->VtxBuffer, source->VtxBuffer);
+        copy->Flags = source->Flags;
+        cachedDrawData.CmdLists.push_back(copy);
+    }
+    cachedDrawData.CmdListsCount = drawData->CmdListsCount;
+    cachedDrawData.TotalVtxCount = drawData->TotalVtxCount;
+    cachedDrawData.TotalIdxCount = drawData->TotalIdxCount;
+}
+
+void UIRenderer::ClearCachedDrawData() {
+    for (ImDrawList* drawList : cachedDrawLists) {
+        IM_DELETE(drawList);
+    }
+    cachedDrawLists.clear();
+    cachedDrawData.Clear();
+}
+
+void UIRenderer::RecordFrameTime(std::chrono::steady_clock::time_point start, bool replayed) {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const float ms = std::chrono::duration<float, std::milli>(elapsed).count();
+
+    frameStats.lastFrameMs = ms;
+    frameStats.avgFrameMs = frameStats.frameCount == 0 ? ms : frameStats.avgFrameMs + (ms - frameStats.avgFrameMs) * 0.05f;
+    frameStats.maxFrameMs = (std::max)(frameStats.maxFrameMs, ms);
+    frameStats.frameCount++;
+    frameStats.heapCallsLastFrame = Memory::GetHeapCallCount() - heapCallsAtFrameStart;
+    if (replayed) {
+        frameStats.replayedFrames++;
+    } else {
+        frameStats.rebuiltFrames++;
+    }
+
+    // Periodic summary so before/after numbers can be read from the log
+    if (frameStats.frameCount % 3600 == 0) {
+        BLOG_DEBUG("UI frame CPU time: avg {:.3f} ms, max {:.3f} ms over {} frames ({} replayed, {} rebuilt)",
+            frameStats.avgFrameMs, frameStats.maxFrameMs, frameStats.frameCount,
+            frameStats.replayedFrames, frameStats.rebuiltFrames);
+        frameStats.maxFrameMs = 0.0f;
+    }
+}
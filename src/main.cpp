@@ -6,7 +6,21 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include "CrosshairMonitor.h"
 #include "CrosshairUI.h"
+#include "InfoCardUI.h"
+#include "MarkerOverlayUI.h"
+#include "CrosshairStateBlock.h"
 #include "Menu.h"
+#include "HookManager.h"
+#include "BinaryLog.h"
+#include "Trace.h"
+#include "Metrics.h"
+#include "JobSystem.h"
+#include "SettingsFile.h"
+#include "PapyrusBridge.h"
+#include "StartupProfiler.h"
+#include <algorithm>
+#include <array>
+#include <thread>
 
 #define DLLEXPORT __declspec(dllexport)
 using namespace std;
@@ -17,32 +31,72 @@ namespace {
     constexpr std::uint16_t  G_PLUGIN_VERSION_MAJOR = 0;
     constexpr std::uint16_t  G_PLUGIN_VERSION_MINOR = 1;
     constexpr std::uint16_t  G_PLUGIN_VERSION_PATCH = 0;
+
+    // Leaves most cores to the game, which keeps several threads busy of its own
+    constexpr uint32_t kMaxJobWorkers = 4;
+    constexpr std::array<const char*, kMaxJobWorkers> kJobWorkerNames = { "Job 0", "Job 1", "Job 2", "Job 3" };
+
+    constexpr const char* kSettingsPath = "Data/SKSE/Plugins/DynamicCrosshairFramework.ini";
 }; // End anonymous namespace
 
 void MessageListener(SKSE::MessagingInterface::Message* msg) {
     switch (msg->type) {
-        case SKSE::MessagingInterface::kDataLoaded:
+        case SKSE::MessagingInterface::kDataLoaded: {
             logger::info("Game data loaded. Initializing UI components...");
 
-            // Initialize CrosshairUI
-            auto crosshairUI = CrosshairUI::GetSingleton();
-            if (!crosshairUI->Init()) {
-                logger::error("Failed to initialize CrosshairUI after data load");
-            } else {
-                logger::info("CrosshairUI initialized successfully after data load");
+            // The crosshair and its textures wait for the main menu; the settings menu for its
+            // first open (see HookManager). Neither is needed while the game is still loading.
+            CrosshairUI::GetSingleton()->InitAfterMainMenu();
+
+            // Info card table; built once the forms it describes exist
+            {
+                StartupProfiler::Scope phase("InfoCardUI");
+                if (!InfoCardUI::GetSingleton()->Init()) {
+                    logger::error("Failed to initialize info cards after data load");
+                }
             }
 
-            // Initialize Menu
-            auto menu = Menu::GetSingleton();
-            if (!menu->Init()) {
-                logger::error("Failed to initialize Menu after data load");
-            } else {
-                logger::info("Menu initialized successfully after data load");
+            {
+                StartupProfiler::Scope phase("MarkerOverlayUI");
+                if (!MarkerOverlayUI::GetSingleton()->Init()) {
+                    logger::error("Failed to initialize the marker overlay after data load");
+                }
             }
+
+            // Present and input hooks; everything they drive exists by now
+            {
+                StartupProfiler::Scope phase("Hooks");
+                if (!HookManager::GetSingleton()->Install()) {
+                    logger::error("Some hooks could not be installed; the overlay or menu may not work");
+                }
+            }
+            StartupProfiler::LogSummary();
+            break;
+        }
+
+        // Reference IDs from the previous session mean something else now
+        case SKSE::MessagingInterface::kPreLoadGame:
+        case SKSE::MessagingInterface::kNewGame:
+            InfoCardUI::GetSingleton()->OnGameLoaded();
+            // Main menu skipped (e.g. a load-on-start mod); a no-op once the crosshair is up
+            CrosshairUI::GetSingleton()->RequestInit();
             break;
     }
 }
 
+// Requests from other plugins; see CrosshairAPI.h
+void ExternalMessageListener(SKSE::MessagingInterface::Message* msg) {
+    if (msg->type != DCF_MESSAGE_REQUEST_API || !msg->data || msg->dataLen < sizeof(DCF_APIRequest)) {
+        return;
+    }
+    auto* request = static_cast<DCF_APIRequest*>(msg->data);
+    if (CrosshairStateBlock::HandleRequest(*request)) {
+        logger::info("Handed crosshair API v{} to {}", DCF_API_VERSION, msg->sender ? msg->sender : "unknown plugin");
+    } else {
+        logger::warn("{} requested crosshair API v{}; this build provides v{}",
+            msg->sender ? msg->sender : "unknown plugin", request->requestedVersion, DCF_API_VERSION);
+    }
+}
 
 void SetupLog() {
     auto logsFolder = SKSE::log::log_directory();
@@ -54,14 +108,46 @@ void SetupLog() {
     auto loggerPtr = std::make_shared<spdlog::logger>("log", std::move(fileLoggerPtr));
     spdlog::set_default_logger(std::move(loggerPtr));
     spdlog::set_level(spdlog::level::trace);
-    spdlog::flush_on(spdlog::level::trace);
+    // Flushing every line stalls whichever thread logged it; only warnings and errors need to survive a crash
+    spdlog::flush_on(spdlog::level::warn);
+
+    // Hot paths log through the binary logger; decode with tools/blogdecode
+    if (!BinaryLog::Init(*logsFolder / "DynamicCrosshairFramework.blog")) {
+        logger::warn("Could not open binary log, hot-path logging disabled");
+    }
+    Trace::SetOutputDirectory(*logsFolder);
+    Metrics::SetOutputDirectory(*logsFolder);
 }
 
 extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* skse) {
     SKSE::Init(skse);
+    // The logger is not up yet, so this phase is recorded once it is
+    const int64_t logStart = Metrics::NowNs();
     SetupLog();
+    StartupProfiler::Record("Log", StartupProfiler::Kind::kBlocking, logStart, Metrics::NowNs() - logStart);
+    // Only reached in DCF_COUNT_ALLOCATIONS builds; log rather than take the game down
+    Memory::SetAllocationViolationHandler([](const char* scope, uint64_t allocations) {
+        logger::error("{} allocation(s) inside no-allocation scope '{}'", allocations, scope);
+    });
     logger::info("{} v{}.{}.{} loaded", G_PLUGIN_NAME, G_PLUGIN_VERSION_MAJOR, G_PLUGIN_VERSION_MINOR, G_PLUGIN_VERSION_PATCH);
 
+    {
+        StartupProfiler::Scope phase("Settings");
+        if (!SettingsFile::Init(kSettingsPath)) {
+            logger::warn("Settings file unavailable; using defaults, changes will not be saved");
+        }
+    }
+
+    {
+        StartupProfiler::Scope phase("Jobs");
+        const uint32_t jobWorkers = std::clamp(std::thread::hardware_concurrency() / 4, 1u, kMaxJobWorkers);
+        if (!Jobs::Init(jobWorkers, [](uint32_t index) { Trace::SetThreadName(kJobWorkerNames[index]); })) {
+            logger::warn("Could not start the job system; background work will run inline");
+        } else {
+            logger::info("Started {} job worker(s)", jobWorkers);
+        }
+    }
+
     auto* messaging = SKSE::GetMessagingInterface();
     if (!messaging) {
         logger::critical("Failed to get messaging interface. UI components cannot be initialized.");
@@ -72,8 +158,24 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* sks
     messaging->RegisterListener(MessageListener);
     logger::info("Registered message listener for UI initialization.");
 
-    // Initialize CrosshairMonitor (can stay here if it doesn't need kDataLoaded)
-    CrosshairMonitor::Init();
+    // Any plugin may ask for the C ABI, so listen to every sender
+    if (!messaging->RegisterListener(nullptr, ExternalMessageListener)) {
+        logger::warn("Could not listen for crosshair API requests");
+    }
+
+    // Natives and the batched crosshair event for scripts; see scripts/DCF_Crosshair.psc
+    {
+        StartupProfiler::Scope phase("Papyrus");
+        if (!PapyrusBridge::Init()) {
+            logger::warn("Papyrus API unavailable; scripts cannot read the crosshair state");
+        }
+    }
+
+    // Only registers the crosshair event sink, which has to be in place before any save loads
+    {
+        StartupProfiler::Scope phase("CrosshairMonitor");
+        CrosshairMonitor::Init();
+    }
     logger::info("CrosshairMonitor initialized successfully");
 
     return true;
@@ -93,21 +195,4 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Query(const SKSE::QueryInterface*,
     pluginInfo->infoVersion = SKSE::PluginInfo::kVersion;
     pluginInfo->version = SKSEPlugin_Version.pluginVersion;
     return true;
-}
-
-void PresentCallback(IDXGISwapChain* /*a_swapChain*/, UINT /*a_syncInterval*/, UINT /*a_flags*/) {
-    auto menu = Menu::GetSingleton();
-    if (menu && menu->initialized) {
-        // THIS IS WHERE IT'S CALLED:
-        menu->ProcessInputEventQueue(); // Process queued inputs before drawing
-
-        ImGui_ImplDX11_NewFrame();
-        ImGui_ImplWin32_NewFrame();
-        ImGui::NewFrame();
-
-        menu->DrawMenu(); // Draw the actual menu
-
-        ImGui::Render();
-        ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
-    }
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+// DynamicCrosshairFramework_alloccheck: drives the crosshair change path (gather, classify, change
+// detection, subscriber fan-out, the C ABI publish and script event batching) over a synthetic
+// world inside a NoAllocationScope per event, as CrosshairMonitor does in-game. Built against the
+// core with DCF_COUNT_ALLOCATIONS, so every operator new counts; exits non-zero if any event
+// allocated.
+//
+// Usage: DynamicCrosshairFramework_alloccheck [--objects N] [--seed N]
+#include "Allocator.h"
+#include "ChangeDispatcher.h"
+#include "CrosshairStateBlock.h"
+#include "InteractionClassifier.h"
+#include "ScriptEvents.h"
+#include "SyntheticWorld.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if !defined(DCF_COUNT_ALLOCATIONS)
+#	error "the allocation check needs the core built with DCF_COUNT_ALLOCATIONS"
+#endif
+
+namespace {
+    uint64_t violations = 0;            // Scopes that allocated
+    uint64_t violatingAllocations = 0;
+
+    void CountViolation(const char*, uint64_t allocations) {
+        violations++;
+        violatingAllocations += allocations;
+    }
+
+    // Flushes run after the scope closes, as the plugin posts them
+    class CountingVM final : public ScriptVM {
+        public:
+            void SendInteractionChanged(const Handle*, std::size_t count, const InteractionEvent&) override { events += count; }
+            uint64_t events = 0;
+    };
+
+    // Takes the std::align_val_t forms of operator new and delete
+    struct alignas(64) CacheLine {
+        uint8_t bytes[64];
+    };
+
+    // Kept reachable so the compiler cannot drop the allocations
+    std::vector<int>* sink = nullptr;
+    CacheLine* alignedSink = nullptr;
+
+    // A scope that does allocate has to be caught, or a clean run below proves nothing
+    bool CountingWorks() {
+        {
+            Memory::NoAllocationScope scope("self check");
+            sink = new std::vector<int>(64);
+        }
+        delete sink;
+        sink = nullptr;
+        {
+            Memory::NoAllocationScope scope("aligned self check");
+            alignedSink = new CacheLine[4];
+        }
+        const bool aligned = reinterpret_cast<uintptr_t>(alignedSink) % alignof(CacheLine) == 0;
+        delete[] alignedSink;
+        alignedSink = nullptr;
+        const bool caught = violations == 2 && aligned;
+        violations = 0;
+        violatingAllocations = 0;
+        return caught;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t objectCount = 20000;
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--objects") == 0 && i + 1 < argc) {
+            objectCount = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            std::fprintf(stderr, "usage: %s [--objects N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (objectCount == 0) objectCount = 1;
+
+    Memory::SetAllocationViolationHandler(CountViolation);
+    if (!CountingWorks()) {
+        std::fprintf(stderr, "an allocation inside a NoAllocationScope went unreported\n");
+        return 1;
+    }
+
+    SyntheticWorld world;
+    world.Populate(objectCount, seed);
+    world.SetPlayerItemCount(kLockpickFormID, 2);
+
+    // Subscribers as the plugin registers them: small captures, stored inline
+    ChangeDispatcher<const TargetFacts> dispatcher;
+    uint64_t observed = 0;
+    for (int i = 0; i < 4; i++) {
+        dispatcher.Subscribe([&observed, i](const TargetFacts* facts) { observed += facts ? facts->formID + i : 0; });
+    }
+
+    InteractionEventBatcher batcher;
+    CountingVM vm;
+    batcher.Register(1);
+
+    // The crosshair wanders over random objects, with a gap (no target) every so often
+    std::vector<SyntheticWorld::Target> targets(objectCount * 4);
+    uint64_t state = seed;
+    for (auto& target : targets) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        const uint64_t pick = (state >> 33) % (world.GetObjectCount() + world.GetObjectCount() / 8);
+        target = pick < world.GetObjectCount() ? world.GetObject(pick) : nullptr;
+    }
+
+    uint64_t changes = 0;
+    for (std::size_t i = 0; i < targets.size(); i++) {
+        {
+            Memory::NoAllocationScope noAllocations("change path");
+            world.SetPlayerSneaking((i & 0x100) != 0);
+            const TargetFacts facts = GatherFacts(world, targets[i]);
+            const InteractionType type = ClassifyInteraction(facts);
+            if (dispatcher.Update(facts.formID, type)) {
+                changes++;
+                CrosshairStateBlock::Publish(facts, type, static_cast<int64_t>(i));
+                batcher.OnChange(facts.hasRef ? facts.formID : 0u, type);
+                dispatcher.Dispatch(facts.hasRef ? &facts : nullptr);
+            }
+        }
+        // Four events to a frame, each frame's changes folded into one flush
+        if ((i & 3) == 3) {
+            batcher.Flush(vm);
+        }
+    }
+
+    std::printf("%zu events, %llu changes, %llu script events, subscriber checksum %llu\n", targets.size(),
+        static_cast<unsigned long long>(changes), static_cast<unsigned long long>(vm.events), static_cast<unsigned long long>(observed));
+    if (violations > 0) {
+        std::fprintf(stderr, "%llu event(s) allocated, %llu allocation(s) in total\n",
+            static_cast<unsigned long long>(violations), static_cast<unsigned long long>(violatingAllocations));
+        return 1;
+    }
+    std::printf("no allocations on the change path\n");
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "Test.h"
+#include "Allocator.h"
+#include "SPSCQueue.h"
+#include <cstdint>
+
+namespace Test {
+    namespace {
+        template <std::size_t Alignment>
+        struct alignas(Alignment) Aligned {
+            uint8_t bytes[Alignment / 2] = {};
+        };
+
+        bool IsAligned(const void* ptr, std::size_t alignment) {
+            return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+        }
+
+        template <std::size_t Alignment>
+        void CheckNew(Memory::Tag tag) {
+            // Several at once, so they do not all land on the same recycled block
+            Aligned<Alignment>* objects[8];
+            bool aligned = true;
+            for (auto*& object : objects) {
+                object = Memory::New<Aligned<Alignment>>(tag);
+                aligned &= object && IsAligned(object, Alignment);
+            }
+            Check(aligned, "New honours alignof(T)");
+            for (auto* object : objects) {
+                Memory::Delete(object);
+            }
+        }
+    }
+
+    void RegisterAllocatorTests(Suite& suite) {
+        suite.Add("memory/over_aligned", [] {
+            const auto& stats = Memory::GetStats(Memory::Tag::kOther);
+            const int64_t bytesBefore = stats.bytes.load();
+
+            CheckNew<32>(Memory::Tag::kOther);
+            CheckNew<64>(Memory::Tag::kOther);
+            CheckNew<4096>(Memory::Tag::kOther);   // Past the largest pool class
+
+            // The per-thread rings that BinaryLog and Trace allocate hold one of these
+            auto* queue = Memory::New<SPSCQueue<uint64_t, 1024>>(Memory::Tag::kOther);
+            Check(IsAligned(queue, 64), "SPSCQueue lands on a cache line");
+            uint64_t value = 0;
+            Check(queue->TryPush(7) && queue->TryPop(value) && value == 7, "the queue works");
+            Memory::Delete(queue);
+
+            {
+                Memory::Vector<Aligned<64>, Memory::Tag::kOther> vector(5);
+                vector.resize(40);
+                Check(IsAligned(vector.data(), 64), "StlAllocator honours alignof(T)");
+            }
+
+            // Ordinary requests keep the pool alignment
+            void* plain = Memory::Allocate(24, Memory::Tag::kOther);
+            Check(IsAligned(plain, Memory::kPoolAlignment), "pool blocks are 16-byte aligned");
+            Memory::Free(plain);
+
+            Check(stats.bytes.load() == bytesBefore, "every aligned block was freed under its tag");
+        });
+    }
+}
@@ -0,0 +1,69 @@
+#include "Test.h"
+#include "BinaryLog.h"
+#include <cstring>
+#include <string>
+
+namespace Test {
+    namespace {
+        // The payload half of BinaryLog::Write, without the rate limit and the ring
+        template <class... Args>
+        BinaryLog::Record Encode(const Args&... args) {
+            BinaryLog::Record record{};
+            BinaryLog::detail::PayloadWriter writer(record, BinaryLog::detail::FixedPayloadSize<std::decay_t<Args>...>());
+            (writer.template Put<std::decay_t<const Args&>>(args), ...);
+            return record;
+        }
+
+        // Walks a payload as blogdecode does; offset moves past the value read
+        std::string_view ReadString(const BinaryLog::Record& record, std::size_t& offset) {
+            const std::size_t length = record.payload[offset++];
+            const std::string_view value(reinterpret_cast<const char*>(record.payload + offset), length);
+            offset += length;
+            return value;
+        }
+
+        int64_t ReadInt(const BinaryLog::Record& record, std::size_t& offset) {
+            int64_t value;
+            std::memcpy(&value, record.payload + offset, sizeof(value));
+            offset += sizeof(value);
+            return value;
+        }
+    }
+
+    void RegisterBinaryLogTests(Suite& suite) {
+        suite.Add("binarylog/short_string", [] {
+            const auto record = Encode("door", 640, 480);
+            std::size_t offset = 0;
+            Check(ReadString(record, offset) == "door", "a string that fits is kept whole");
+            Check(ReadInt(record, offset) == 640 && ReadInt(record, offset) == 480, "fixed arguments follow it");
+            Check(offset == record.size, "the size covers every argument");
+        });
+
+        // The header's own example with a path longer than the record
+        suite.Add("binarylog/long_string_then_fixed", [] {
+            const std::string path(200, 'p');
+            const auto record = Encode(path, 1920, -1080);
+            Check(record.size == BinaryLog::kMaxPayload, "the string fills the record and no more");
+            std::size_t offset = 0;
+            const std::string_view stored = ReadString(record, offset);
+            Check(stored.size() == BinaryLog::kMaxPayload - 1 - 16, "the string leaves room for both integers");
+            Check(stored == std::string_view(path).substr(0, stored.size()), "the kept part is the string's start");
+            Check(ReadInt(record, offset) == 1920, "the first integer is intact");
+            Check(ReadInt(record, offset) == -1080, "the second integer is intact");
+            Check(offset == record.size, "the size covers every argument");
+        });
+
+        // The first string takes what is left; the second still gets its length byte
+        suite.Add("binarylog/two_long_strings", [] {
+            const std::string first(150, 'a');
+            const std::string second(150, 'b');
+            const auto record = Encode(first, second, 7);
+            Check(record.size == BinaryLog::kMaxPayload, "both strings fit in the record");
+            std::size_t offset = 0;
+            Check(ReadString(record, offset).size() == BinaryLog::kMaxPayload - 2 - 8, "the first string leaves the later bytes");
+            Check(ReadString(record, offset).empty(), "the second string is cut to nothing");
+            Check(ReadInt(record, offset) == 7, "the trailing integer is intact");
+            Check(offset == record.size, "the size covers every argument");
+        });
+    }
+}
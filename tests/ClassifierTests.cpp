@@ -0,0 +1,143 @@
+#include "Test.h"
+#include "SyntheticWorld.h"
+#include <array>
+
+namespace Test {
+    namespace {
+        // CrosshairMonitor::GetInteractionTypeForRef as it was before classification moved behind
+        // WorldView, transcribed onto the view with every fact read eagerly. The split classifier
+        // must agree with it on every target, including the facts it now skips gathering.
+        InteractionType BaselineClassify(const SyntheticWorld& world, SyntheticWorld::Target ref) {
+            if (!ref) return InteractionType::kNone;
+
+            const auto baseType = world.GetBaseType(ref);
+            if (!baseType) return InteractionType::kNone;
+            const auto is = [&](BaseType type) { return *baseType == static_cast<uint8_t>(type); };
+            const LockInfo lock = world.GetLockInfo(ref);
+
+            uint32_t flags = 0;
+            if (is(BaseType::kNPC)) flags |= 0x01;
+            if (is(BaseType::kContainer)) flags |= 0x02;
+            if (is(BaseType::kDoor)) {
+                flags |= 0x02;
+                if (lock.locked) flags |= 0x08;
+            }
+            if (is(BaseType::kBook)) flags |= 0x04;
+            if (is(BaseType::kFurniture)) flags |= 0x10;
+            if (is(BaseType::kFlora) || is(BaseType::kTree) || is(BaseType::kActivator)) flags |= 0x20;
+            if (flags == 0) return InteractionType::kNone;
+
+            if ((flags & 0x01) && is(BaseType::kNPC)) {
+                return world.IsPlayerSneaking() ? InteractionType::kPickpocket : InteractionType::kTalk;
+            }
+            if (flags & 0x02) {
+                if (is(BaseType::kActorCharacter) && world.IsDead(ref)) {
+                    return InteractionType::kSearch;
+                } else if (is(BaseType::kDoor)) {
+                    if (lock.locked) {
+                        if (lock.level == LockLevel::kRequiresKey) {
+                            return InteractionType::kOpen;
+                        } else if (lock.level >= LockLevel::kVeryEasy && lock.level <= LockLevel::kVeryHard) {
+                            return world.GetPlayerItemCount(kLockpickFormID) > 0 ? InteractionType::kLockpick : InteractionType::kLockpickNone;
+                        }
+                    } else {
+                        return InteractionType::kOpen;
+                    }
+                }
+                return InteractionType::kOpen;
+            }
+            if (flags & 0x04) return InteractionType::kTake;
+            if (flags & 0x08) return InteractionType::kLockpick;
+            if (flags & 0x10) return InteractionType::kSit;
+            if ((flags & 0x20) && is(BaseType::kFlora)) return InteractionType::kHarvest;
+            return InteractionType::kActivate;
+        }
+
+        struct SingleCase {
+            const char* what;
+            BaseType type;
+            LockInfo lock;
+            bool sneaking;
+            int32_t lockpicks;
+            InteractionType expected;
+        };
+
+        constexpr LockInfo kUnlocked{};
+        constexpr LockInfo kHardLock{ true, LockLevel::kHard };
+        constexpr LockInfo kKeyLock{ true, LockLevel::kRequiresKey };
+
+        constexpr std::array<SingleCase, 13> kSingleCases = { {
+            { "NPC", BaseType::kNPC, kUnlocked, false, 0, InteractionType::kTalk },
+            { "NPC while sneaking", BaseType::kNPC, kUnlocked, true, 0, InteractionType::kPickpocket },
+            { "container", BaseType::kContainer, kUnlocked, false, 0, InteractionType::kOpen },
+            { "locked container", BaseType::kContainer, kHardLock, false, 0, InteractionType::kOpen },
+            { "door", BaseType::kDoor, kUnlocked, false, 0, InteractionType::kOpen },
+            { "locked door with lockpicks", BaseType::kDoor, kHardLock, false, 3, InteractionType::kLockpick },
+            { "locked door without lockpicks", BaseType::kDoor, kHardLock, false, 0, InteractionType::kLockpickNone },
+            { "door that needs a key", BaseType::kDoor, kKeyLock, false, 3, InteractionType::kOpen },
+            { "book", BaseType::kBook, kUnlocked, false, 0, InteractionType::kTake },
+            { "furniture", BaseType::kFurniture, kUnlocked, false, 0, InteractionType::kSit },
+            { "flora", BaseType::kFlora, kUnlocked, false, 0, InteractionType::kHarvest },
+            { "tree", BaseType::kTree, kUnlocked, false, 0, InteractionType::kActivate },
+            { "activator", BaseType::kActivator, kUnlocked, false, 0, InteractionType::kActivate },
+        } };
+    }
+
+    void RegisterClassifierTests(Suite& suite) {
+        suite.Add("classifier/single_targets", [] {
+            for (const auto& single : kSingleCases) {
+                SyntheticWorld world;
+                world.Add(single.type).lock = single.lock;
+                world.SetPlayerSneaking(single.sneaking);
+                world.SetPlayerItemCount(kLockpickFormID, single.lockpicks);
+
+                const auto target = world.GetObject(0);
+                Check(ClassifyInteraction(world, target) == single.expected, single.what);
+                Check(BaselineClassify(world, target) == single.expected, single.what);
+            }
+        });
+
+        suite.Add("classifier/no_target", [] {
+            SyntheticWorld world;
+            Check(ClassifyInteraction(world, nullptr) == InteractionType::kNone, "null target");
+            Check(GatherFacts(world, nullptr).hasRef == false, "null target has no ref");
+
+            world.Add(BaseType::kDoor).hasBase = false;
+            world.Add(static_cast<uint8_t>(32));    // Misc item: no activation flags
+            Check(ClassifyInteraction(world, world.GetObject(0)) == InteractionType::kNone, "unresolved base");
+            Check(ClassifyInteraction(world, world.GetObject(1)) == InteractionType::kNone, "misc item");
+        });
+
+        // Every player state the classifier reads, over a large mixed world
+        suite.Add("classifier/matches_baseline", [] {
+            SyntheticWorld world;
+            world.Populate(50000, 7);
+            uint64_t mismatches = 0;
+            for (const bool sneaking : { false, true }) {
+                for (const int32_t lockpicks : { 0, 5 }) {
+                    world.SetPlayerSneaking(sneaking);
+                    world.SetPlayerItemCount(kLockpickFormID, lockpicks);
+                    for (std::size_t i = 0; i < world.GetObjectCount(); i++) {
+                        const auto target = world.GetObject(i);
+                        mismatches += ClassifyInteraction(world, target) != BaselineClassify(world, target);
+                    }
+                }
+            }
+            Check(mismatches == 0, "classifier disagrees with the baseline");
+        });
+
+        // Lazy gathering must not change what the flags say
+        suite.Add("classifier/activation_flags", [] {
+            SyntheticWorld world;
+            world.Add(BaseType::kNPC);
+            world.Add(BaseType::kDoor).lock = kHardLock;
+            world.Add(BaseType::kBook);
+            world.Add(BaseType::kFurniture);
+            world.Add(BaseType::kTree);
+            constexpr std::array<uint32_t, 5> kExpected = { 0x01, 0x02 | 0x08, 0x04, 0x10, 0x20 };
+            for (std::size_t i = 0; i < kExpected.size(); i++) {
+                Check(GetActivationFlags(GatherFacts(world, world.GetObject(i))) == kExpected[i], "activation flags");
+            }
+        });
+    }
+}
@@ -0,0 +1,21 @@
+#include "Test.h"
+#include "CrosshairAnimator.h"
+
+namespace Test {
+    void RegisterCrosshairAnimatorTests(Suite& suite) {
+        // Additive pulses and wiggles fold their final value into the rest pose; that value has
+        // to be exactly zero, or every hover nudges the crosshair a little further
+        suite.Add("animator/additive_leaves_no_trace", [] {
+            CrosshairAnimator animator;
+            for (int i = 0; i < 1000; i++) {
+                animator.Pulse(CrosshairAnimator::Channel::kRotation, 0.25f, 0.1f);
+                animator.Wiggle(CrosshairAnimator::Channel::kScale, 0.1f, 0.1f);
+                while (animator.IsAnimating()) {
+                    animator.Advance(CrosshairAnimator::kStepSeconds);
+                }
+            }
+            Check(animator.GetPose().Get(CrosshairAnimator::Channel::kScale) == 1.0f, "scale is back at exactly 1");
+            Check(animator.GetPose().Get(CrosshairAnimator::Channel::kRotation) == 0.0f, "rotation is back at exactly 0");
+        });
+    }
+}
@@ -0,0 +1,68 @@
+#include "Test.h"
+#include "CrosshairTrace.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace Test {
+    namespace {
+        // A trace file as Recorder::Stop writes it, with whatever count the header claims
+        bool WriteTrace(const std::filesystem::path& path, uint32_t claimedCount, const std::vector<CrosshairTrace::FileRecord>& records) {
+            std::FILE* file = std::fopen(path.string().c_str(), "wb");
+            if (!file) return false;
+            CrosshairTrace::FileHeader header{};
+            std::memcpy(header.magic, CrosshairTrace::kMagic, sizeof(header.magic));
+            header.version = CrosshairTrace::kVersion;
+            header.recordCount = claimedCount;
+            bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+            if (ok && !records.empty()) {
+                ok = std::fwrite(records.data(), sizeof(records[0]), records.size(), file) == records.size();
+            }
+            return std::fclose(file) == 0 && ok;
+        }
+
+        std::vector<CrosshairTrace::FileRecord> SampleRecords() {
+            TargetFacts door;
+            door.formID = 0x0001A2B3;
+            door.hasRef = true;
+            door.hasBase = true;
+            door.baseType = static_cast<uint8_t>(BaseType::kDoor);
+            door.locked = true;
+            door.lockLevel = LockLevel::kAverage;
+            door.lockpickCount = 3;
+            return { CrosshairTrace::Pack(0, TargetFacts{}), CrosshairTrace::Pack(16'000'000, door) };
+        }
+    }
+
+    void RegisterCrosshairTraceTests(Suite& suite) {
+        suite.Add("trace/round_trip", [] {
+            const auto path = std::filesystem::temp_directory_path() / "dcf_round_trip.xrec";
+            const auto records = SampleRecords();
+            Check(WriteTrace(path, static_cast<uint32_t>(records.size()), records), "writing the trace");
+
+            std::vector<CrosshairTrace::Event> events;
+            Check(CrosshairTrace::Read(path, events) && events.size() == 2, "reading it back");
+            if (events.size() == 2) {
+                Check(!events[0].facts.hasRef, "first event has no target");
+                Check(events[1].timeNs == 16'000'000 && events[1].facts.formID == 0x0001A2B3, "second event's time and target");
+                Check(events[1].facts.locked && events[1].facts.lockLevel == LockLevel::kAverage && events[1].facts.lockpickCount == 3, "second event's lock facts");
+            }
+            std::filesystem::remove(path);
+        });
+
+        // A header claiming more records than the file holds is rejected before anything is
+        // reserved for them
+        suite.Add("trace/oversized_count", [] {
+            const auto path = std::filesystem::temp_directory_path() / "dcf_oversized_count.xrec";
+            Check(WriteTrace(path, 0xFFFFFFFFu, SampleRecords()), "writing the trace");
+
+            std::vector<CrosshairTrace::Event> events;
+            Check(!CrosshairTrace::Read(path, events), "a count past the end of the file fails the read");
+            Check(events.capacity() == 0, "nothing was reserved for the bogus count");
+
+            Check(WriteTrace(path, 3, SampleRecords()), "rewriting the trace");
+            Check(!CrosshairTrace::Read(path, events), "one record short fails the read");
+            std::filesystem::remove(path);
+        });
+    }
+}
@@ -0,0 +1,117 @@
+#include "Test.h"
+#include "FormTableCache.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace Test {
+    namespace {
+        constexpr uint64_t kKey = 0x0123456789ABCDEFull;
+
+        std::vector<InfoCards::StaticInfo> SampleEntries() {
+            std::vector<InfoCards::StaticInfo> entries(3);
+            entries[0] = { 0x00000F, 1, 0.0f, 0 };
+            entries[1] = { 0x012E49, 250, 12.5f, 1 };
+            entries[2] = { 0x0A1B2C, 40, 2.0f, 0 };
+            return entries;
+        }
+
+        // A cache file with whatever header it is given; dropBytes cuts the end off the body
+        bool WriteCache(const std::filesystem::path& path, const FormTableCache::Header& header,
+            const std::vector<InfoCards::StaticInfo>& entries, std::size_t dropBytes = 0) {
+            std::vector<uint8_t> bytes(sizeof(header) + entries.size() * sizeof(entries[0]));
+            std::memcpy(bytes.data(), &header, sizeof(header));
+            std::memcpy(bytes.data() + sizeof(header), entries.data(), entries.size() * sizeof(entries[0]));
+            bytes.resize(bytes.size() - dropBytes);
+
+            std::FILE* file = std::fopen(path.string().c_str(), "wb");
+            if (!file) return false;
+            const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+            return std::fclose(file) == 0 && ok;
+        }
+
+        FormTableCache::Header ValidHeader() {
+            FormTableCache::Header header;
+            header.key = kKey;
+            header.entryCount = static_cast<uint32_t>(SampleEntries().size());
+            return header;
+        }
+
+        // Loads into a fresh table; a failed load must leave it empty
+        FormTableCache::LoadResult LoadFresh(const std::filesystem::path& path, uint64_t key) {
+            InfoCards::StaticTable table;
+            const auto result = FormTableCache::Load(path, key, table);
+            if (result != FormTableCache::LoadResult::kLoaded) {
+                Check(table.GetSize() == 0 && !table.IsMapped(), "a failed load leaves the table alone");
+            }
+            return result;
+        }
+    }
+
+    void RegisterFormTableCacheTests(Suite& suite) {
+        suite.Add("formcache/round_trip", [] {
+            const auto path = std::filesystem::temp_directory_path() / "dcf_round_trip.dcft";
+            const auto entries = SampleEntries();
+            Check(FormTableCache::Save(path, kKey, entries), "saving the cache");
+            {
+                InfoCards::StaticTable table;
+                Check(FormTableCache::Load(path, kKey, table) == FormTableCache::LoadResult::kLoaded, "loading it back");
+                Check(table.IsMapped() && table.GetSize() == entries.size(), "the table reads the file in place");
+                const InfoCards::StaticInfo* found = table.Find(0x012E49);
+                Check(found && found->value == 250 && found->weight == 12.5f && found->flags == 1, "an entry is found with its data");
+                Check(table.Find(0x000010) == nullptr, "an absent form is not found");
+            }
+            std::filesystem::remove(path);
+        });
+
+        suite.Add("formcache/missing", [] {
+            const auto path = std::filesystem::temp_directory_path() / "dcf_no_such_cache.dcft";
+            std::filesystem::remove(path);
+            Check(LoadFresh(path, kKey) == FormTableCache::LoadResult::kMissing, "no file is a miss");
+        });
+
+        // Another load order or rule set: a well-formed file under a different key
+        suite.Add("formcache/stale", [] {
+            const auto path = std::filesystem::temp_directory_path() / "dcf_stale.dcft";
+            Check(FormTableCache::Save(path, kKey, SampleEntries()), "saving the cache");
+            Check(LoadFresh(path, kKey + 1) == FormTableCache::LoadResult::kStale, "a different key is stale");
+            std::filesystem::remove(path);
+        });
+
+        suite.Add("formcache/invalid", [] {
+            const auto path = std::filesystem::temp_directory_path() / "dcf_invalid.dcft";
+            const auto entries = SampleEntries();
+            const auto invalid = [&](const FormTableCache::Header& header, std::size_t dropBytes, const char* what) {
+                if (Check(WriteCache(path, header, entries, dropBytes), "writing the cache")) {
+                    Check(LoadFresh(path, kKey) == FormTableCache::LoadResult::kInvalid, what);
+                }
+            };
+
+            Check(WriteCache(path, ValidHeader(), entries), "writing the cache");
+            Check(LoadFresh(path, kKey) == FormTableCache::LoadResult::kLoaded, "the unmodified file loads");
+
+            FormTableCache::Header header = ValidHeader();
+            header.magic = 0x4B4E554A;
+            invalid(header, 0, "wrong magic");
+
+            header = ValidHeader();
+            header.formatVersion = FormTableCache::kFormatVersion + 1;
+            invalid(header, 0, "wrong format version");
+
+            header = ValidHeader();
+            header.entrySize = sizeof(InfoCards::StaticInfo) + 4;
+            invalid(header, 0, "wrong entry size");
+
+            invalid(ValidHeader(), 4, "truncated body");
+            invalid(ValidHeader(), entries.size() * sizeof(entries[0]) + 8, "truncated header");
+
+            header = ValidHeader();
+            header.entryCount++;
+            invalid(header, 0, "entry count past the end of the file");
+            header.entryCount -= 2;
+            invalid(header, 0, "entry count short of the file");
+            std::filesystem::remove(path);
+        });
+    }
+}
@@ -0,0 +1,61 @@
+#include "Test.h"
+#include "RasterScene.h"
+#include "SoftwareRenderBackend.h"
+#include "imgui.h"
+
+namespace Test {
+    namespace {
+        using namespace CrosshairScene;
+
+        // SoftwareRenderBackend::CreateTexture takes premultiplied BGRA bytes, as WIC decodes them
+        std::vector<uint8_t> ToBgra(const Raster::Texture& texture) {
+            std::vector<uint8_t> bgra(texture.pixels.size() * 4);
+            for (std::size_t i = 0; i < texture.pixels.size(); i++) {
+                const uint32_t pixel = texture.pixels[i];
+                bgra[i * 4 + 0] = static_cast<uint8_t>(pixel >> 16);
+                bgra[i * 4 + 1] = static_cast<uint8_t>(pixel >> 8);
+                bgra[i * 4 + 2] = static_cast<uint8_t>(pixel);
+                bgra[i * 4 + 3] = static_cast<uint8_t>(pixel >> 24);
+            }
+            return bgra;
+        }
+
+        void AddQuad(ImDrawList* drawList, ImTextureID texture, const std::array<Raster::Vertex, 4>& quad) {
+            const auto position = [&](int i) { return ImVec2(quad[i].x, quad[i].y); };
+            const auto uv = [&](int i) { return ImVec2(quad[i].u, quad[i].v); };
+            drawList->AddImageQuad(texture, position(0), position(1), position(2), position(3), uv(0), uv(1), uv(2), uv(3), quad[0].color);
+        }
+    }
+
+    void RegisterImGuiRasterTests(Suite& suite) {
+        // The golden frame again, this time drawn the way CrosshairUI draws it
+        suite.Add("imgui/golden_crosshair", [] {
+            ImGui::CreateContext();
+            ImGui::GetIO().IniFilename = nullptr;
+
+            SoftwareRenderBackend backend(kFrameSize, kFrameSize);
+            Check(backend.Init(), "backend init");
+            const auto ringPixels = ToBgra(MakeRing());
+            const auto crossPixels = ToBgra(MakeCross());
+            const ImTextureID ring = backend.CreateTexture(kTextureSize, kTextureSize, ringPixels.data());
+            const ImTextureID cross = backend.CreateTexture(kTextureSize, kTextureSize, crossPixels.data());
+
+            backend.NewFrame();
+            ImGui::NewFrame();
+            AddQuad(ImGui::GetBackgroundDrawList(), ring, OutgoingQuad());
+            AddQuad(ImGui::GetBackgroundDrawList(), cross, IncomingQuad());
+            ImGui::Render();
+
+            backend.Clear(kBackground);
+            backend.RenderDrawData(ImGui::GetDrawData());
+            if (!MatchesGolden(backend.GetPixels(), backend.GetStride())) {
+                backend.WriteTGA("crosshair_frame.imgui.actual.tga");
+            }
+
+            backend.ReleaseTexture(cross);
+            backend.ReleaseTexture(ring);
+            backend.Shutdown();
+            ImGui::DestroyContext();
+        });
+    }
+}
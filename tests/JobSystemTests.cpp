@@ -0,0 +1,160 @@
+#include "Test.h"
+#include "JobSystem.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Test {
+    namespace {
+        // Matches kMaxJobs in JobSystem.cpp
+        constexpr uint32_t kJobSlots = 2048;
+
+        // Holds a job on its worker until opened; yields, as the suite may run on one core
+        class Gate {
+            public:
+                void Open() { open.store(true, std::memory_order_release); }
+                void Pass() const {
+                    while (!open.load(std::memory_order_acquire)) {
+                        std::this_thread::yield();
+                    }
+                }
+
+            private:
+                std::atomic<bool> open{ false };
+        };
+
+        // Jobs note the order they ran in
+        class Trail {
+            public:
+                void Add(char step) { steps[count.fetch_add(1)] = step; }
+                std::string Get() const { return std::string(steps.data(), count.load()); }
+
+            private:
+                std::array<char, 16> steps{};
+                std::atomic<uint32_t> count{ 0 };
+        };
+    }
+
+    void RegisterJobSystemTests(Suite& suite) {
+        // A diamond: b and c wait for a, d waits for both; a finished dependency is no dependency
+        suite.Add("jobs/dependency_order", [] {
+            if (!Check(Jobs::Init(2), "pool starts")) return;
+            Trail trail;
+            Gate gate;
+            const Jobs::JobHandle a = Jobs::Schedule([&] { gate.Pass(); trail.Add('a'); });
+            const Jobs::JobHandle b = Jobs::Then(a, [&] { trail.Add('b'); });
+            const Jobs::JobHandle c = Jobs::Then(a, [&] { trail.Add('c'); });
+            const std::array<Jobs::JobHandle, 2> both = { b, c };
+            const Jobs::JobHandle d = Jobs::Schedule([&] { trail.Add('d'); }, both);
+            Check(!Jobs::IsFinished(d), "d waits while a is held");
+            gate.Open();
+            Jobs::Wait(d);
+
+            const std::string order = trail.Get();
+            Check(order == "abcd" || order == "acbd", "a first, d last");
+            Check(Jobs::IsFinished(a) && Jobs::IsFinished(b) && Jobs::IsFinished(c), "every dependency finished before d");
+
+            bool ran = false;
+            Jobs::Wait(Jobs::Then(a, [&] { ran = true; }));
+            Check(ran, "a job after a finished dependency still runs");
+            Jobs::Shutdown();
+        });
+
+        // The cancelled job's body is skipped, but what depends on it is not stranded
+        suite.Add("jobs/cancel_releases_dependents", [] {
+            if (!Check(Jobs::Init(2), "pool starts")) return;
+            const uint64_t cancelledBefore = Jobs::GetStats().cancelled;
+            Gate gate;
+            Jobs::CancellationSource source;
+            std::atomic<bool> cancelledRan{ false };
+            std::atomic<bool> dependentRan{ false };
+
+            const Jobs::JobHandle held = Jobs::Schedule([&] { gate.Pass(); });
+            const Jobs::JobHandle cancelled = Jobs::Then(held, [&] { cancelledRan = true; }, source.GetToken());
+            const Jobs::JobHandle dependent = Jobs::Then(cancelled, [&] { dependentRan = true; });
+            source.Cancel();
+            gate.Open();
+            Jobs::Wait(dependent);
+
+            Check(!cancelledRan.load(), "the cancelled job did not run");
+            Check(dependentRan.load(), "its dependent ran");
+            Check(Jobs::IsFinished(cancelled), "the cancelled job counts as finished");
+            Check(Jobs::GetStats().cancelled == cancelledBefore + 1, "counted as cancelled");
+            Jobs::Shutdown();
+        });
+
+        // With every slot taken, Schedule runs the job on the calling thread before returning
+        suite.Add("jobs/inline_when_full", [] {
+            if (!Check(Jobs::Init(2), "pool starts")) return;
+            const uint64_t inlineBefore = Jobs::GetStats().ranInline;
+            Gate gate;
+            std::atomic<uint32_t> released{ 0 };
+            const Jobs::JobHandle held = Jobs::Schedule([&] { gate.Pass(); });
+            std::vector<Jobs::JobHandle> waiting;
+            for (uint32_t i = 1; i < kJobSlots; i++) {
+                waiting.push_back(Jobs::Then(held, [&] { released++; }));
+            }
+            Check(Jobs::GetStats().inFlight == kJobSlots, "every slot is in use");
+
+            int32_t ranOn = 0;
+            const Jobs::JobHandle overflow = Jobs::Schedule([&] { ranOn = Jobs::GetCurrentWorkerIndex(); });
+            Check(ranOn == -1, "the extra job ran on the scheduling thread");
+            Check(Jobs::IsFinished(overflow), "its handle is already finished");
+            Check(Jobs::GetStats().ranInline == inlineBefore + 1, "counted as inline");
+
+            gate.Open();
+            for (const auto& handle : waiting) {
+                Jobs::Wait(handle);
+            }
+            Check(released.load() == kJobSlots - 1, "the held jobs all ran once the slots freed");
+            Jobs::Shutdown();
+        });
+
+        // One worker waiting on a job it scheduled itself: only helping can run it
+        suite.Add("jobs/wait_on_worker", [] {
+            if (!Check(Jobs::Init(1), "pool starts")) return;
+            std::atomic<bool> innerRan{ false };
+            std::atomic<bool> innerDoneAtReturn{ false };
+            std::atomic<int32_t> innerWorker{ -2 };
+            const Jobs::JobHandle outer = Jobs::Schedule([&] {
+                const Jobs::JobHandle inner = Jobs::Schedule([&] {
+                    innerWorker = Jobs::GetCurrentWorkerIndex();
+                    innerRan = true;
+                });
+                Jobs::Wait(inner);
+                innerDoneAtReturn = innerRan.load();
+            });
+            Jobs::Wait(outer);
+
+            Check(innerDoneAtReturn.load(), "Wait on a worker returned after the inner job ran");
+            Check(innerWorker.load() == 0, "the waiting worker ran the inner job itself");
+            Jobs::Shutdown();
+        });
+
+        // Shutdown drains everything scheduled, including dependents still held back
+        suite.Add("jobs/shutdown_drains", [] {
+            if (!Check(Jobs::Init(2), "pool starts")) return;
+            constexpr uint32_t kChains = 16;
+            std::atomic<uint32_t> ran{ 0 };
+            for (uint32_t i = 0; i < kChains; i++) {
+                const Jobs::JobHandle first = Jobs::Schedule([&] {
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                    ran++;
+                });
+                Jobs::Then(first, [&] { ran++; });
+            }
+            Jobs::Shutdown();
+
+            Check(ran.load() == kChains * 2, "every job ran before Shutdown returned");
+            Check(!Jobs::IsRunning(), "the pool is stopped");
+            Check(Jobs::GetStats().inFlight == 0, "nothing left in flight");
+
+            bool ranAfter = false;
+            Jobs::Schedule([&] { ranAfter = true; });
+            Check(ranAfter, "after Shutdown, Schedule runs inline");
+        });
+    }
+}
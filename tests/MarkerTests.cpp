@@ -0,0 +1,120 @@
+#include "Test.h"
+#include "MarkerProjection.h"
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+namespace Test {
+    namespace {
+        TargetFacts Facts(BaseType type) {
+            TargetFacts facts;
+            facts.formID = 0xFF000800;
+            facts.hasRef = true;
+            facts.hasBase = true;
+            facts.baseType = static_cast<uint8_t>(type);
+            return facts;
+        }
+
+        // Camera at (x, y, z) looking along +Y with Z up, as the game's world axes run
+        Markers::Camera MakeCamera(float x, float y, float z, float width, float height) {
+            constexpr float kNear = 15.0f;
+            constexpr float kFar = 100000.0f;
+            const float focal = 1.0f / std::tan(0.6f);
+            const float aspect = width / height;
+            Markers::Camera camera;
+            camera.worldToClip = {
+                focal / aspect, 0.0f, 0.0f, -focal / aspect * x,
+                0.0f, 0.0f, focal, -focal * z,
+                0.0f, kFar / (kFar - kNear), 0.0f, -kFar / (kFar - kNear) * y - kNear * kFar / (kFar - kNear),
+                0.0f, 1.0f, 0.0f, -y
+            };
+            camera.positionX = x;
+            camera.positionY = y;
+            camera.positionZ = z;
+            camera.screenWidth = width;
+            camera.screenHeight = height;
+            return camera;
+        }
+
+        template <class T, std::size_t N>
+        bool SameBits(const std::array<T, N>& a, const std::array<T, N>& b, uint32_t count) {
+            return std::memcmp(a.data(), b.data(), count * sizeof(T)) == 0;
+        }
+    }
+
+    void RegisterMarkerTests(Suite& suite) {
+        suite.Add("markers/classify", [] {
+            // An actor reference's base is its TESNPC; the dead state comes from the reference
+            TargetFacts corpse = Facts(BaseType::kNPC);
+            corpse.dead = true;
+            Check(Markers::Classify(corpse) == Markers::Kind::kCorpse, "dead NPC is a corpse");
+            Check(!Markers::Classify(Facts(BaseType::kNPC)), "living NPC gets no marker");
+
+            Check(Markers::Classify(Facts(BaseType::kFlora)) == Markers::Kind::kHarvest, "flora is harvestable");
+            Check(Markers::Classify(Facts(BaseType::kTree)) == Markers::Kind::kHarvest, "tree is harvestable");
+
+            TargetFacts chest = Facts(BaseType::kContainer);
+            Check(!Markers::Classify(chest), "unlocked container gets no marker");
+            chest.locked = true;
+            chest.lockLevel = LockLevel::kHard;
+            Check(Markers::Classify(chest) == Markers::Kind::kLocked, "locked container");
+            TargetFacts door = Facts(BaseType::kDoor);
+            door.locked = true;
+            door.lockLevel = LockLevel::kRequiresKey;
+            Check(Markers::Classify(door) == Markers::Kind::kLocked, "locked door");
+
+            TargetFacts noBase = corpse;
+            noBase.hasBase = false;
+            Check(!Markers::Classify(noBase), "reference without a base gets no marker");
+        });
+
+        // The SSE2 path must place every marker exactly where the scalar reference does, down to
+        // the last bit, for any count (not only multiples of four) and any camera
+        suite.Add("markers/project_matches_scalar", [] {
+            auto markers = std::make_unique<Markers::MarkerSet>();
+            uint32_t state = 0x9E3779B9u;
+            const auto next = [&state] {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                return static_cast<float>(state) / 4294967296.0f * 2.0f - 1.0f;
+            };
+            // Points right on the camera plane, the frustum edges and the radius, then a scatter
+            markers->Add(1, Markers::Kind::kCorpse, 0.0f, 0.0f, 0.0f);
+            markers->Add(2, Markers::Kind::kCorpse, 0.0f, 1000.0f, 0.0f);
+            markers->Add(3, Markers::Kind::kCorpse, 0.0f, 3000.0f, 0.0f);
+            markers->Add(4, Markers::Kind::kCorpse, 1000.0f / std::tan(0.6f) * (16.0f / 9.0f), 1000.0f, 0.0f);
+            markers->Add(5, Markers::Kind::kCorpse, 0.0f, -500.0f, 0.0f);
+            while (markers->count < Markers::kMaxMarkers - 3) {
+                markers->Add(0xFF000800u + markers->count, Markers::Kind::kHarvest, next() * 4096.0f, next() * 4096.0f, next() * 1024.0f);
+            }
+
+            auto simd = std::make_unique<Markers::ScreenMarkers>();
+            auto scalar = std::make_unique<Markers::ScreenMarkers>();
+            const Markers::Camera cameras[] = {
+                MakeCamera(0.0f, 0.0f, 0.0f, 2560.0f, 1440.0f),
+                MakeCamera(131.5f, -977.25f, 64.0f, 1920.0f, 1080.0f),
+                MakeCamera(-2048.0f, 1024.0f, -300.0f, 1280.0f, 720.0f),
+            };
+            uint32_t compared = 0;
+            uint32_t mismatched = 0;
+            for (const auto& camera : cameras) {
+                // Every count from 0 to 8 exercises the partial last group of four
+                for (const uint32_t count : { 0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, Markers::kMaxMarkers - 3 }) {
+                    const uint32_t total = markers->count;
+                    markers->count = count;
+                    const uint32_t visible = Markers::Project(*markers, camera, 3000.0f, *simd);
+                    const uint32_t expected = Markers::ProjectScalar(*markers, camera, 3000.0f, *scalar);
+                    markers->count = total;
+
+                    compared += expected;
+                    mismatched += visible != expected || simd->count != scalar->count ||
+                                  !SameBits(simd->x, scalar->x, expected) || !SameBits(simd->y, scalar->y, expected) ||
+                                  !SameBits(simd->distance, scalar->distance, expected) || !SameBits(simd->source, scalar->source, expected);
+                }
+            }
+            Check(compared > 100, "enough markers on screen to compare");
+            Check(mismatched == 0, "Project and ProjectScalar differ");
+        });
+    }
+}
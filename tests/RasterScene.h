@@ -0,0 +1,92 @@
+#pragma once
+#include "Test.h"
+#include "SoftwareRaster.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+// The fixed crosshair frame behind tests/golden/crosshair_frame.tga, shared by the rasterizer
+// case and the ImGui case that draws the same frame through SoftwareRenderBackend
+namespace Test::CrosshairScene {
+    inline constexpr uint32_t kFrameSize = 96;
+    inline constexpr uint32_t kTextureSize = 32;
+    inline constexpr uint32_t kBackground = 0xFF302820;    // Opaque, so blending over it shows
+
+    // ImDrawList::PrimQuadUV's split, which AddImageQuad uses
+    inline constexpr std::array<uint16_t, 6> kQuadIndices = { 0, 1, 2, 0, 2, 3 };
+
+    // White with a soft-edged alpha shape; stands in for the crosshair textures
+    template <class Coverage>
+    Raster::Texture MakeTexture(Coverage&& coverage) {
+        Raster::Texture texture;
+        texture.width = kTextureSize;
+        texture.height = kTextureSize;
+        texture.pixels.resize(static_cast<size_t>(kTextureSize) * kTextureSize);
+        for (uint32_t y = 0; y < kTextureSize; y++) {
+            for (uint32_t x = 0; x < kTextureSize; x++) {
+                const float dx = static_cast<float>(x) + 0.5f - kTextureSize * 0.5f;
+                const float dy = static_cast<float>(y) + 0.5f - kTextureSize * 0.5f;
+                const auto alpha = static_cast<uint32_t>(std::clamp(coverage(dx, dy), 0.0f, 1.0f) * 255.0f + 0.5f);
+                texture.pixels[y * kTextureSize + x] = Raster::Premultiply(255, 255, 255, alpha);
+            }
+        }
+        return texture;
+    }
+
+    inline Raster::Texture MakeRing() {
+        return MakeTexture([](float dx, float dy) { return 1.0f - std::fabs(std::sqrt(dx * dx + dy * dy) - 11.0f) / 3.0f; });
+    }
+
+    inline Raster::Texture MakeCross() {
+        return MakeTexture([](float dx, float dy) {
+            const float bar = 3.0f - (std::min)(std::fabs(dx), std::fabs(dy));
+            const float reach = 14.0f - (std::max)(std::fabs(dx), std::fabs(dy));
+            return (std::min)(bar, reach);
+        });
+    }
+
+    // Corners as CrosshairUI::DrawCrosshair places them: centred, scaled, rotated, tinted
+    inline std::array<Raster::Vertex, 4> CrosshairQuad(float halfSize, float rotation, uint32_t color) {
+        const float center = kFrameSize * 0.5f;
+        const float cosine = std::cos(rotation);
+        const float sine = std::sin(rotation);
+        const auto corner = [&](float x, float y, float u, float v) {
+            return Raster::Vertex{ center + (x * cosine - y * sine) * halfSize, center + (x * sine + y * cosine) * halfSize, u, v, color };
+        };
+        return { corner(-1.0f, -1.0f, 0.0f, 0.0f), corner(1.0f, -1.0f, 1.0f, 0.0f), corner(1.0f, 1.0f, 1.0f, 1.0f), corner(-1.0f, 1.0f, 0.0f, 1.0f) };
+    }
+
+    // Mid-transition: the ring fading out under the cross, which is tinted and 15 degrees into its turn
+    inline std::array<Raster::Vertex, 4> OutgoingQuad() { return CrosshairQuad(30.0f, 0.3f, 0x5AFFFFFFu); }
+    inline std::array<Raster::Vertex, 4> IncomingQuad() { return CrosshairQuad(36.0f, 0.2618f, 0xDC50C8FFu); }
+
+    inline std::string GoldenPath() { return std::string(DCF_TEST_DATA_DIR) + "/golden/crosshair_frame.tga"; }
+
+    // Pixels rows stride apart. The SSE2 and scalar paths associate the interpolation differently,
+    // so either may land one step away from the reference; anything more is a real change.
+    inline bool MatchesGolden(const uint32_t* pixels, uint32_t stride) {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint32_t> golden;
+        if (!Check(Raster::ReadTGA(GoldenPath().c_str(), width, height, golden), "reading the reference image")) return false;
+        if (!Check(width == kFrameSize && height == kFrameSize, "reference image size")) return false;
+
+        uint32_t worst = 0;
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                const uint32_t actual = pixels[y * stride + x];
+                const uint32_t expected = golden[y * width + x];
+                for (int shift = 0; shift < 32; shift += 8) {
+                    const int delta = static_cast<int>((actual >> shift) & 0xFF) - static_cast<int>((expected >> shift) & 0xFF);
+                    worst = (std::max)(worst, static_cast<uint32_t>(std::abs(delta)));
+                }
+            }
+        }
+        if (worst > 1) {
+            std::fprintf(stderr, "  largest channel difference from the reference: %u\n", worst);
+        }
+        return Check(worst <= 1, "frame differs from tests/golden/crosshair_frame.tga");
+    }
+}
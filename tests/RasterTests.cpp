@@ -0,0 +1,93 @@
+#include "Test.h"
+#include "RasterScene.h"
+#include <array>
+#include <cmath>
+
+namespace Test {
+    namespace {
+        using namespace CrosshairScene;
+
+        Raster::Texture MakeWhite() {
+            Raster::Texture white;
+            white.width = 1;
+            white.height = 1;
+            white.pixels = { 0xFFFFFFFFu };
+            return white;
+        }
+    }
+
+    void RegisterRasterTests(Suite& suite) {
+        suite.Add("raster/golden_crosshair", [] {
+            const Raster::Texture ring = MakeRing();
+            const Raster::Texture cross = MakeCross();
+            const auto outgoing = OutgoingQuad();
+            const auto incoming = IncomingQuad();
+
+            Raster::Framebuffer framebuffer(kFrameSize, kFrameSize);
+            framebuffer.Clear(kBackground);
+            framebuffer.FillTriangles(outgoing.data(), kQuadIndices.data(), kQuadIndices.size(), ring, framebuffer.GetBounds());
+            framebuffer.FillTriangles(incoming.data(), kQuadIndices.data(), kQuadIndices.size(), cross, framebuffer.GetBounds());
+
+            if (updateGolden) {
+                Check(framebuffer.WriteTGA(GoldenPath().c_str()), "writing the reference image");
+            } else if (!MatchesGolden(framebuffer.GetPixels(), framebuffer.GetStride())) {
+                framebuffer.WriteTGA("crosshair_frame.actual.tga");
+            }
+        });
+
+        // A fan and a quad at 50% alpha: any pixel filled by two triangles comes out darker
+        suite.Add("raster/shared_edges", [] {
+            const Raster::Texture white = MakeWhite();
+            Raster::Framebuffer framebuffer(61, 29);
+            constexpr uint32_t kHalf = 0x80FFFFFFu;
+            constexpr int kSegments = 13;
+
+            std::array<Raster::Vertex, kSegments + 2> fan;
+            fan[0] = { 17.5f, 13.0f, 0.5f, 0.5f, kHalf };
+            for (int i = 0; i <= kSegments; i++) {
+                const float angle = static_cast<float>(i) * 6.2831853f / kSegments;
+                fan[i + 1] = { 17.5f + 15.0f * std::cos(angle), 13.0f + 12.0f * std::sin(angle), 0.5f, 0.5f, kHalf };
+            }
+            for (int i = 0; i < kSegments; i++) {
+                framebuffer.FillTriangle(fan[0], fan[i + 1], fan[i + 2], white, framebuffer.GetBounds());
+            }
+            // Corners exactly on pixel centres
+            const std::array<Raster::Vertex, 4> quad = { {
+                { 40.5f, 0.5f, 0.0f, 0.0f, kHalf }, { 48.5f, 0.5f, 0.0f, 0.0f, kHalf },
+                { 48.5f, 8.5f, 0.0f, 0.0f, kHalf }, { 40.5f, 8.5f, 0.0f, 0.0f, kHalf } } };
+            framebuffer.FillTriangles(quad.data(), kQuadIndices.data(), kQuadIndices.size(), white, framebuffer.GetBounds());
+
+            uint32_t covered = 0;
+            uint32_t overdrawn = 0;
+            for (uint32_t y = 0; y < framebuffer.GetHeight(); y++) {
+                for (uint32_t x = 0; x < framebuffer.GetWidth(); x++) {
+                    const uint32_t alpha = framebuffer.GetPixels()[y * framebuffer.GetStride() + x] >> 24;
+                    covered += alpha != 0;
+                    overdrawn += alpha != 0 && alpha != 0x80;
+                }
+            }
+            Check(covered > 0, "nothing was filled");
+            Check(overdrawn == 0, "pixels on shared edges were filled twice");
+            Check((framebuffer.GetPixels()[40] >> 24) == 0x80 && (framebuffer.GetPixels()[48] >> 24) == 0, "quad owns its top-left edges only");
+        });
+
+        suite.Add("raster/clip_rect", [] {
+            const Raster::Texture white = MakeWhite();
+            Raster::Framebuffer framebuffer(32, 32);
+            const std::array<Raster::Vertex, 4> quad = { {
+                { -8.0f, -8.0f, 0.0f, 0.0f, 0xFFFFFFFFu }, { 40.0f, -8.0f, 1.0f, 0.0f, 0xFFFFFFFFu },
+                { 40.0f, 40.0f, 1.0f, 1.0f, 0xFFFFFFFFu }, { -8.0f, 40.0f, 0.0f, 1.0f, 0xFFFFFFFFu } } };
+            const Raster::ClipRect clip{ 5, 7, 21, 19 };
+            framebuffer.FillTriangles(quad.data(), kQuadIndices.data(), kQuadIndices.size(), white, clip);
+
+            uint32_t wrong = 0;
+            for (int y = 0; y < 32; y++) {
+                for (int x = 0; x < 32; x++) {
+                    const bool inside = x >= clip.x0 && x < clip.x1 && y >= clip.y0 && y < clip.y1;
+                    wrong += framebuffer.GetPixels()[y * framebuffer.GetStride() + x] != (inside ? 0xFFFFFFFFu : 0u);
+                }
+            }
+            Check(wrong == 0, "fill leaked past or fell short of the clip rect");
+        });
+    }
+}
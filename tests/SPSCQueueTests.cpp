@@ -0,0 +1,110 @@
+#include "Test.h"
+#include "SPSCQueue.h"
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace Test {
+    namespace {
+        constexpr uint64_t kItems = 1'000'000;
+
+        // Two words written together, so a torn or stale slot shows up as a mismatch
+        struct Item {
+            uint64_t sequence = 0;
+            uint64_t check = 0;
+        };
+
+        uint64_t CheckWord(uint64_t sequence) { return sequence * 0x9E3779B97F4A7C15ull ^ 0xA5A5A5A5A5A5A5A5ull; }
+
+        using Queue = SPSCQueue<Item, 256>;
+
+        struct Totals {
+            uint64_t attempts = 0;
+            uint64_t pushed = 0;
+            uint64_t pushedSum = 0;
+            uint64_t popped = 0;
+            uint64_t poppedSum = 0;
+            uint64_t outOfOrder = 0;
+            uint64_t torn = 0;
+        };
+
+        // The producer keeps pushing until kItems got through, numbering every attempt, so the
+        // queue fills and overflows whenever the consumer (TryPop or Drain) falls behind or yields
+        void RunStress(bool drain) {
+            auto queue = std::make_unique<Queue>();
+            std::atomic<bool> producerDone = false;
+            Totals totals;
+
+            std::thread producer([&] {
+                while (totals.pushed < kItems) {
+                    const uint64_t sequence = totals.attempts++;
+                    if (queue->TryPush({ sequence, CheckWord(sequence) })) {
+                        totals.pushed++;
+                        totals.pushedSum += sequence;
+                    } else {
+                        std::this_thread::yield();  // Lets the consumer run even on one core
+                    }
+                }
+                producerDone.store(true, std::memory_order_release);
+            });
+
+            uint64_t next = 0;  // Lowest sequence the next pop may carry
+            const auto consume = [&](const Item& item) {
+                totals.outOfOrder += item.sequence < next;
+                totals.torn += item.check != CheckWord(item.sequence);
+                next = item.sequence + 1;
+                totals.popped++;
+                totals.poppedSum += item.sequence;
+            };
+
+            for (uint64_t round = 0;; round++) {
+                // Read before popping, so nothing pushed before the flag was set can be missed
+                const bool done = producerDone.load(std::memory_order_acquire);
+                std::size_t taken = 0;
+                if (drain) {
+                    taken = queue->Drain(consume);
+                } else {
+                    Item item;
+                    while (queue->TryPop(item)) {
+                        consume(item);
+                        taken++;
+                    }
+                }
+                if (done && taken == 0) break;
+                if (round % 4096 == 0) std::this_thread::yield();
+            }
+            producer.join();
+
+            const uint64_t overflows = queue->GetOverflowCount();
+            std::printf("     %llu pushed, %llu overflowed\n", static_cast<unsigned long long>(totals.pushed), static_cast<unsigned long long>(overflows));
+            Check(totals.pushed + overflows == totals.attempts, "pushed + overflowed == attempted");
+            Check(totals.popped == totals.pushed, "every pushed item was popped");
+            Check(totals.poppedSum == totals.pushedSum, "popped the items that were pushed");
+            Check(totals.outOfOrder == 0, "items came out in push order");
+            Check(totals.torn == 0, "no torn items");
+            Check(queue->Size() == 0, "queue empty at the end");
+        }
+    }
+
+    void RegisterSPSCQueueTests(Suite& suite) {
+        suite.Add("spsc/single_thread", [] {
+            Queue queue;
+            for (uint64_t i = 0; i < Queue::kCapacity; i++) {
+                Check(queue.TryPush({ i, CheckWord(i) }), "push into a queue with room");
+            }
+            Check(!queue.TryPush({}), "push into a full queue fails");
+            Check(queue.GetOverflowCount() == 1, "the failed push is counted");
+
+            Item item;
+            Check(queue.TryPop(item) && item.sequence == 0, "first in, first out");
+            Check(queue.TryPush({ 999, CheckWord(999) }), "a pop frees a slot");
+            std::size_t drained = queue.Drain([](const Item&) {});
+            Check(drained == Queue::kCapacity, "drain takes everything queued");
+            Check(!queue.TryPop(item), "empty after draining");
+        });
+
+        suite.Add("spsc/stress_try_pop", [] { RunStress(false); });
+        suite.Add("spsc/stress_drain", [] { RunStress(true); });
+    }
+}
@@ -0,0 +1,100 @@
+#include "Test.h"
+#include "Allocator.h"
+#include "Settings.h"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Test {
+    namespace {
+        bool SameFields(const Settings::Snapshot& a, const Settings::Snapshot& b) {
+            return a.toggleKey == b.toggleKey && a.crosshairSize == b.crosshairSize && a.crosshairSource == b.crosshairSource &&
+                   a.transitionMs == b.transitionMs && a.infoCardsEnabled == b.infoCardsEnabled &&
+                   a.markersEnabled == b.markersEnabled && a.markerRadius == b.markerRadius &&
+                   a.frameBudgetUs == b.frameBudgetUs && a.overlayEnabled == b.overlayEnabled &&
+                   a.menuEnabled == b.menuEnabled && a.tracingEnabled == b.tracingEnabled;
+        }
+    }
+
+    void RegisterSettingsTests(Suite& suite) {
+        // Every field away from its default survives Serialize then Parse unchanged
+        suite.Add("settings/round_trip", [] {
+            Settings::Snapshot edited;
+            edited.toggleKey = 0x7A;
+            edited.crosshairSize = 48.5f;
+            edited.crosshairSource = Settings::CrosshairSource::WebIconPack;
+            edited.transitionMs = 0;
+            edited.infoCardsEnabled = false;
+            edited.markersEnabled = true;
+            edited.markerRadius = 1234.25f;
+            edited.frameBudgetUs = 2500;
+            edited.overlayEnabled = false;
+            edited.menuEnabled = false;
+            edited.tracingEnabled = false;
+
+            std::vector<std::string> warnings;
+            const Settings::Snapshot parsed = Settings::Parse(Settings::Serialize(edited), warnings);
+            Check(warnings.empty(), "a serialized file parses without warnings");
+            Check(SameFields(parsed, edited), "every field round-trips");
+
+            warnings.clear();
+            Check(SameFields(Settings::Parse(Settings::Serialize({}), warnings), {}), "defaults round-trip");
+            Check(warnings.empty(), "the default file parses without warnings");
+        });
+
+        // Each bad line is reported and keeps the default; good lines around it still apply
+        suite.Add("settings/bad_values", [] {
+            const char* text =
+                "[General]\n"
+                "ToggleKey = 0x100\n"
+                "[Crosshair]\n"
+                "Size = 1000\n"
+                "Source = Sprites\n"
+                "TransitionMs = -5\n"
+                "InfoCards = maybe\n"
+                "Colour = red\n"
+                "no equals sign\n"
+                "[Markers\n"
+                "[Markers]\n"
+                "Radius = 12.5.3\n"
+                "Enabled = TRUE ; trailing comment\n"
+                "[Performance]\n"
+                "FrameBudgetUs = 0x1F4\n";
+            std::vector<std::string> warnings;
+            const Settings::Snapshot parsed = Settings::Parse(text, warnings);
+            const Settings::Snapshot defaults;
+
+            Check(warnings.size() == 9, "one warning per bad line");
+            Check(parsed.toggleKey == defaults.toggleKey, "an out-of-range key code keeps the default");
+            Check(parsed.crosshairSize == defaults.crosshairSize, "an out-of-range size keeps the default");
+            Check(parsed.crosshairSource == defaults.crosshairSource, "an unknown source keeps the default");
+            Check(parsed.transitionMs == defaults.transitionMs, "a negative duration keeps the default");
+            Check(parsed.infoCardsEnabled == defaults.infoCardsEnabled, "a non-boolean keeps the default");
+            Check(parsed.markerRadius == defaults.markerRadius, "a malformed float keeps the default");
+            Check(parsed.markersEnabled, "good values after bad ones still apply");
+            Check(parsed.frameBudgetUs == 500, "hexadecimal values are accepted");
+            if (warnings.size() == 9) {
+                Check(warnings[0].rfind("line 2:", 0) == 0, "warnings name the line");
+            }
+        });
+
+        // Snapshots replaced by a burst of edits are freed by the periodic Reclaim once their
+        // grace period is over, without waiting for another Publish
+        suite.Add("settings/reclaim", [] {
+            const auto& stats = Memory::GetStats(Memory::Tag::kSettings);
+            for (uint32_t i = 0; i < 4; i++) {
+                Settings::Update([i](Settings::Snapshot& snapshot) { snapshot.transitionMs = 100 + i; });
+            }
+            Check(Settings::Get().transitionMs == 103, "readers see the last edit");
+            const std::size_t waiting = Settings::Reclaim();
+            Check(waiting >= 3, "replaced snapshots wait out the grace period");
+
+            const uint64_t freesBefore = stats.frees.load();
+            std::this_thread::sleep_for(std::chrono::milliseconds(Settings::kGracePeriodMs + 50));
+            Check(Settings::Reclaim() == 0, "reclaimed once the grace period passed");
+            Check(stats.frees.load() - freesBefore == waiting, "each waiting snapshot was freed");
+            Check(Settings::Get().transitionMs == 103, "the current snapshot is untouched");
+        });
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <source_location>
+#include <string>
+#include <vector>
+
+// Minimal check harness for DynamicCrosshairFramework_tests. Cases are named "group/case"; CTest
+// runs each group as its own test through --filter. A failed Check reports and lets the case
+// carry on, so one run shows every broken expectation.
+namespace Test {
+    struct Case {
+        std::string name;
+        std::function<void()> body;
+    };
+
+    class Suite {
+        public:
+            void Add(std::string name, std::function<void()> body) { cases.push_back({ std::move(name), std::move(body) }); }
+            const std::vector<Case>& GetCases() const { return cases; }
+
+        private:
+            std::vector<Case> cases;
+    };
+
+    // Failures in the running case; bumped from any thread
+    inline std::atomic<uint64_t> failures{ 0 };
+    // --update-golden: cases with a reference image rewrite it instead of comparing
+    inline bool updateGolden = false;
+
+    inline bool Check(bool condition, const char* what, const std::source_location where = std::source_location::current()) {
+        if (!condition) {
+            failures.fetch_add(1, std::memory_order_relaxed);
+            std::fprintf(stderr, "  %s:%u: check failed: %s\n", where.file_name(), static_cast<unsigned>(where.line()), what);
+        }
+        return condition;
+    }
+
+    void RegisterAllocatorTests(Suite& suite);
+    void RegisterBinaryLogTests(Suite& suite);
+    void RegisterClassifierTests(Suite& suite);
+    void RegisterCrosshairAnimatorTests(Suite& suite);
+    void RegisterCrosshairTraceTests(Suite& suite);
+    void RegisterFormTableCacheTests(Suite& suite);
+    void RegisterJobSystemTests(Suite& suite);
+    void RegisterRasterTests(Suite& suite);
+    void RegisterSettingsTests(Suite& suite);
+    void RegisterSPSCQueueTests(Suite& suite);
+    void RegisterMarkerTests(Suite& suite);
+    void RegisterImGuiRasterTests(Suite& suite);   // Only with DCF_TESTS_IMGUI
+}
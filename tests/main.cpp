@@ -0,0 +1,61 @@
+// DynamicCrosshairFramework_tests: correctness checks for the platform-neutral core. Exits
+// non-zero if any selected case fails.
+//
+// Usage: DynamicCrosshairFramework_tests [--filter PREFIX] [--list] [--update-golden]
+#include "Test.h"
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv) {
+    const char* filter = nullptr;
+    bool list = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else if (std::strcmp(argv[i], "--update-golden") == 0) {
+            Test::updateGolden = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter PREFIX] [--list] [--update-golden]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Test::Suite suite;
+    Test::RegisterAllocatorTests(suite);
+    Test::RegisterBinaryLogTests(suite);
+    Test::RegisterClassifierTests(suite);
+    Test::RegisterCrosshairAnimatorTests(suite);
+    Test::RegisterCrosshairTraceTests(suite);
+    Test::RegisterFormTableCacheTests(suite);
+    Test::RegisterJobSystemTests(suite);
+    Test::RegisterRasterTests(suite);
+    Test::RegisterSettingsTests(suite);
+    Test::RegisterSPSCQueueTests(suite);
+    Test::RegisterMarkerTests(suite);
+#if defined(DCF_TESTS_IMGUI)
+    Test::RegisterImGuiRasterTests(suite);
+#endif
+
+    int ran = 0;
+    int failed = 0;
+    for (const auto& testCase : suite.GetCases()) {
+        if (filter && testCase.name.rfind(filter, 0) != 0) continue;
+        if (list) {
+            std::printf("%s\n", testCase.name.c_str());
+            continue;
+        }
+
+        Test::failures.store(0);
+        testCase.body();
+        const bool ok = Test::failures.load() == 0;
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", testCase.name.c_str());
+        ran++;
+        failed += ok ? 0 : 1;
+    }
+    if (list) return 0;
+
+    std::printf("%d of %d cases passed\n", ran - failed, ran);
+    return failed == 0 && ran > 0 ? 0 : 1;
+}
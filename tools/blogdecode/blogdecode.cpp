@@ -0,0 +1,192 @@
+// Turns a DynamicCrosshairFramework .blog file back into text, one line per record:
+//   [+12.345678] [debug] [T1] Loaded crosshair.png (64x64)  (CrosshairUI.cpp:80)
+// The plugin drains its per-thread rings one after another, so lines are re-sorted by timestamp.
+//
+// Usage: blogdecode <file.blog>
+#include "BinaryLogFormat.h"
+#include <cstdio>
+#include <cstring>
+#include <fmt/args.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    using namespace BinaryLogFormat;
+
+    struct Format {
+        Level level;
+        uint32_t line;
+        std::string text;
+        std::string signature;
+        std::string file;
+    };
+
+    class Reader {
+        public:
+            Reader(const uint8_t* data, std::size_t size) : data(data), size(size) {}
+
+            bool AtEnd() const { return offset >= size; }
+
+            template <class T>
+            bool Read(T& value) {
+                if (size - offset < sizeof(T)) return false;
+                std::memcpy(&value, data + offset, sizeof(T));
+                offset += sizeof(T);
+                return true;
+            }
+
+            template <class LengthType>
+            bool ReadString(std::string& value) {
+                LengthType length;
+                if (!Read(length) || size - offset < length) return false;
+                value.assign(reinterpret_cast<const char*>(data + offset), length);
+                offset += length;
+                return true;
+            }
+
+            bool ReadBytes(std::size_t count, const uint8_t*& bytes) {
+                if (size - offset < count) return false;
+                bytes = data + offset;
+                offset += count;
+                return true;
+            }
+
+        private:
+            const uint8_t* data;
+            std::size_t size;
+            std::size_t offset = 0;
+    };
+
+    std::string_view BaseName(std::string_view path) {
+        const auto slash = path.find_last_of("/\\");
+        return slash == std::string_view::npos ? path : path.substr(slash + 1);
+    }
+
+    std::string Decode(const Format& format, const uint8_t* payload, uint16_t payloadSize) {
+        Reader reader(payload, payloadSize);
+        fmt::dynamic_format_arg_store<fmt::format_context> args;
+        for (const char type : format.signature) {
+            bool ok = false;
+            if (type == 'i') {
+                int64_t value = 0;
+                ok = reader.Read(value);
+                args.push_back(value);
+            } else if (type == 'u') {
+                uint64_t value = 0;
+                ok = reader.Read(value);
+                args.push_back(value);
+            } else if (type == 'd') {
+                double value = 0;
+                ok = reader.Read(value);
+                args.push_back(value);
+            } else if (type == 'p') {
+                uint64_t value = 0;
+                ok = reader.Read(value);
+                args.push_back(fmt::format("0x{:X}", value));
+            } else if (type == 's') {
+                std::string value;
+                ok = reader.ReadString<uint8_t>(value);
+                args.push_back(std::move(value));
+            }
+            if (!ok) return "<truncated record: " + format.text + ">";
+        }
+
+        try {
+            return fmt::vformat(format.text, args);
+        } catch (const fmt::format_error& e) {
+            return fmt::format("<bad format '{}': {}>", format.text, e.what());
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <file.blog>\n", argv[0]);
+        return 2;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    Reader reader(bytes.data(), bytes.size());
+    FileHeader header;
+    if (!reader.Read(header) || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        std::fprintf(stderr, "%s is not a binary log\n", argv[1]);
+        return 1;
+    }
+    if (header.version != kVersion) {
+        std::fprintf(stderr, "unsupported log version %u (expected %u)\n", header.version, kVersion);
+        return 1;
+    }
+
+    const double ticksPerSecond = header.ticksPerSecond ? static_cast<double>(header.ticksPerSecond) : 1e9;
+    auto seconds = [&](uint64_t ticks) {
+        return static_cast<double>(static_cast<int64_t>(ticks - header.startTicks)) / ticksPerSecond;
+    };
+    fmt::print("# started at unix time {}.{:09}, {} ticks/s\n", header.startUnixNs / 1'000'000'000, header.startUnixNs % 1'000'000'000, header.ticksPerSecond);
+
+    std::unordered_map<uint16_t, Format> formats;
+    std::vector<std::pair<uint64_t, std::string>> lines;
+    while (!reader.AtEnd()) {
+        ChunkKind kind;
+        if (!reader.Read(kind)) break;
+
+        if (kind == ChunkKind::kFormat) {
+            uint16_t id;
+            Format format;
+            if (!reader.Read(id) || !reader.Read(format.level) || !reader.Read(format.line) ||
+                !reader.ReadString<uint16_t>(format.text) || !reader.ReadString<uint8_t>(format.signature) ||
+                !reader.ReadString<uint16_t>(format.file)) {
+                break;
+            }
+            formats[id] = std::move(format);
+        } else if (kind == ChunkKind::kRecord) {
+            uint64_t ticks;
+            uint16_t thread, id, payloadSize;
+            const uint8_t* payload;
+            if (!reader.Read(ticks) || !reader.Read(thread) || !reader.Read(id) || !reader.Read(payloadSize) ||
+                !reader.ReadBytes(payloadSize, payload)) {
+                break;
+            }
+            const auto it = formats.find(id);
+            if (it == formats.end()) {
+                lines.emplace_back(ticks, fmt::format("[{:+.6f}] [?] [T{}] <unknown format {}>", seconds(ticks), thread, id));
+                continue;
+            }
+            const Format& format = it->second;
+            lines.emplace_back(ticks, fmt::format("[{:+.6f}] [{}] [T{}] {}  ({}:{})", seconds(ticks), LevelName(format.level), thread,
+                Decode(format, payload, payloadSize), BaseName(format.file), format.line));
+        } else if (kind == ChunkKind::kSuppressed) {
+            uint64_t ticks;
+            uint16_t id;
+            uint32_t count;
+            if (!reader.Read(ticks) || !reader.Read(id) || !reader.Read(count)) break;
+            const auto it = formats.find(id);
+            lines.emplace_back(ticks, fmt::format("[{:+.6f}] [warning] rate limit suppressed {} record(s) of \"{}\"", seconds(ticks), count,
+                it != formats.end() ? it->second.text : std::string("?")));
+        } else {
+            std::fprintf(stderr, "corrupt chunk kind %u, stopping\n", static_cast<unsigned>(kind));
+            return 1;
+        }
+    }
+
+    std::stable_sort(lines.begin(), lines.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& [ticks, line] : lines) {
+        fmt::print("{}\n", line);
+    }
+
+    if (!reader.AtEnd()) {
+        std::fprintf(stderr, "log ends with a partial chunk (plugin still running or crashed mid-write)\n");
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+// Stand-in for another plugin consuming CrosshairAPI.h, run off-game. A writer thread plays the
+// game thread, publishing classified SyntheticWorld targets into the state block as fast as it
+// can; pollers read the block through DCF_ReadCrosshairState and a subscriber waits on its
+// change handle. Every copy a reader gets is checked against the world it came from, so a torn
+// read or a lost wakeup shows up as a failure (exit code 1).
+//
+// Usage: crosshairapi [--changes N] [--pollers N] [--objects N] [--seed N]
+#include "CrosshairAPI.h"
+#include "CrosshairStateBlock.h"
+#include "SyntheticWorld.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <Windows.h>
+#else
+#	include <poll.h>
+#	include <unistd.h>
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        uint64_t changes = 2'000'000;
+        int pollers = 2;
+        std::size_t objects = 4096;
+        uint64_t seed = 1;
+    };
+
+    constexpr const char* kUsage = "usage: %s [--changes N] [--pollers N] [--objects N] [--seed N]\n";
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--changes") == 0 && i + 1 < argc) {
+                options.changes = std::strtoull(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--pollers") == 0 && i + 1 < argc) {
+                options.pollers = std::atoi(argv[++i]);
+            } else if (std::strcmp(argv[i], "--objects") == 0 && i + 1 < argc) {
+                options.objects = std::strtoull(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                options.seed = std::strtoull(argv[++i], nullptr, 10);
+            } else {
+                return false;
+            }
+        }
+        return options.changes > 0 && options.pollers >= 0 && options.objects > 0;
+    }
+
+    // What the block must hold for each published target, keyed by form ID
+    struct Expected {
+        uint32_t interactionType;
+        uint32_t activationFlags;
+    };
+
+    struct ReaderStats {
+        uint64_t reads = 0;
+        uint64_t inconsistent = 0;
+        uint64_t backwards = 0;  // changeCount went down between two reads
+    };
+
+    // Returns false on a copy that mixes two publishes
+    bool Check(const DCF_CrosshairState& copy, const std::unordered_map<uint32_t, Expected>& expected) {
+        if (copy.changeCount == 0) return copy.formID == 0;
+        const auto it = expected.find(copy.formID);
+        // The writer stores the change number as the time, so the pair pins down one publish
+        return it != expected.end() && it->second.interactionType == copy.interactionType &&
+               it->second.activationFlags == copy.activationFlags &&
+               static_cast<uint64_t>(copy.changeTimeNs) == copy.changeCount;
+    }
+
+    bool WaitForChange(DCF_ChangeHandle handle, int timeoutMs) {
+#if defined(_WIN32)
+        return WaitForSingleObject(reinterpret_cast<HANDLE>(handle), static_cast<DWORD>(timeoutMs)) == WAIT_OBJECT_0;
+#else
+        pollfd descriptor{ static_cast<int>(handle), POLLIN, 0 };
+        if (poll(&descriptor, 1, timeoutMs) <= 0) return false;
+        uint64_t count;
+        return read(static_cast<int>(handle), &count, sizeof(count)) == sizeof(count);
+#endif
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr, kUsage, argv[0]);
+        return 2;
+    }
+
+    // What another plugin does at kPostLoad, minus SKSE's messaging
+    DCF_APIRequest request{ DCF_API_VERSION, nullptr };
+    if (!CrosshairStateBlock::HandleRequest(request) || !request.api || request.api->version < DCF_API_VERSION) {
+        std::fprintf(stderr, "API v%u not available\n", DCF_API_VERSION);
+        return 1;
+    }
+    const DCF_CrosshairAPI& api = *request.api;
+    std::printf("API v%u, %u-byte table, state block at %p (%s-byte aligned)\n", api.version, api.size,
+        static_cast<const void*>(api.state), reinterpret_cast<uintptr_t>(api.state) % 64 == 0 ? "64" : "NOT 64");
+
+    SyntheticWorld world;
+    world.Populate(options.objects, options.seed);
+    world.SetPlayerItemCount(kLockpickFormID, 3);
+    std::vector<TargetFacts> facts(world.GetObjectCount());
+    std::unordered_map<uint32_t, Expected> expected;
+    for (std::size_t i = 0; i < facts.size(); i++) {
+        facts[i] = GatherFacts(world, world.GetObject(i));
+        expected[facts[i].formID] = { static_cast<uint32_t>(ClassifyInteraction(facts[i])), GetActivationFlags(facts[i]) };
+    }
+
+    const DCF_ChangeHandle handle = api.SubscribeChanges();
+    if (handle == -1) {
+        std::fprintf(stderr, "SubscribeChanges failed\n");
+        return 1;
+    }
+
+    std::atomic<bool> done = false;
+    std::vector<ReaderStats> pollerStats(options.pollers);
+    std::vector<std::thread> pollers;
+    for (int p = 0; p < options.pollers; p++) {
+        pollers.emplace_back([&, p] {
+            ReaderStats& stats = pollerStats[p];
+            uint64_t lastCount = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                const DCF_CrosshairState copy = DCF_ReadCrosshairState(api.state);
+                stats.reads++;
+                stats.inconsistent += !Check(copy, expected);
+                stats.backwards += copy.changeCount < lastCount;
+                lastCount = copy.changeCount;
+            }
+        });
+    }
+
+    // Wakes on the handle and reads the latest state; coalesced signals are fine, silence is not
+    ReaderStats subscriberStats;
+    uint64_t wakeups = 0;
+    uint64_t lastSeen = 0;
+    std::thread subscriber([&] {
+        while (!done.load(std::memory_order_relaxed) || lastSeen < options.changes) {
+            if (!WaitForChange(handle, 1000)) {
+                if (done.load(std::memory_order_relaxed)) break;  // Writer finished; nothing pending
+                continue;
+            }
+            wakeups++;
+            const DCF_CrosshairState copy = DCF_ReadCrosshairState(api.state);
+            subscriberStats.reads++;
+            subscriberStats.inconsistent += !Check(copy, expected);
+            subscriberStats.backwards += copy.changeCount < lastSeen;
+            lastSeen = copy.changeCount;
+        }
+    });
+
+    const auto start = Clock::now();
+    for (uint64_t change = 1; change <= options.changes; change++) {
+        CrosshairStateBlock::Publish(facts[change % facts.size()],
+            static_cast<InteractionType>(expected[facts[change % facts.size()].formID].interactionType),
+            static_cast<int64_t>(change));
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    done.store(true);
+
+    for (auto& poller : pollers) {
+        poller.join();
+    }
+    subscriber.join();
+    api.UnsubscribeChanges(handle);
+
+    ReaderStats total;
+    for (const auto& stats : pollerStats) {
+        total.reads += stats.reads;
+        total.inconsistent += stats.inconsistent;
+        total.backwards += stats.backwards;
+    }
+
+    const DCF_CrosshairState final = DCF_ReadCrosshairState(api.state);
+    std::printf("writer: %llu changes in %.3f s (%.1f ns/publish)\n", static_cast<unsigned long long>(options.changes),
+        seconds, seconds * 1e9 / static_cast<double>(options.changes));
+    std::printf("pollers: %llu reads, %llu inconsistent, %llu out of order\n", static_cast<unsigned long long>(total.reads),
+        static_cast<unsigned long long>(total.inconsistent), static_cast<unsigned long long>(total.backwards));
+    std::printf("subscriber: %llu wakeups, last saw change %llu of %llu, %llu inconsistent\n",
+        static_cast<unsigned long long>(wakeups), static_cast<unsigned long long>(lastSeen),
+        static_cast<unsigned long long>(options.changes), static_cast<unsigned long long>(subscriberStats.inconsistent));
+    std::printf("final: %08X %s\n", final.formID, api.GetInteractionTypeName(final.interactionType));
+
+    const bool ok = total.inconsistent == 0 && total.backwards == 0 && subscriberStats.inconsistent == 0 &&
+                    subscriberStats.backwards == 0 && lastSeen == options.changes && final.changeCount == options.changes;
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}